@@ -0,0 +1,626 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <omp.h>
+
+#include "meta.h"
+#include "l2p_map.h"
+#include "workload.h"
+
+#define NIL UINT32_MAX
+#define GC_RESERVE 2            // free blocks kept back so GC always has a destination
+#define MAX_LIST 16
+
+typedef enum {
+    GC_GREEDY = 0,
+    GC_COST_BENEFIT,
+} gc_policy;
+
+typedef enum {
+    BLOCK_FREE = 0,
+    BLOCK_ACTIVE,
+    BLOCK_FULL,
+} block_state;
+
+typedef struct {
+    const char* meta_file;
+    uint64_t rates[MAX_LIST];
+    int num_rates;
+    const char* workloads[MAX_LIST];
+    int num_workloads;
+    gc_policy policies[2];
+    int num_policies;
+    double warmup;              // drive writes before measuring
+    double measure;             // drive writes measured
+    uint64_t read_us;
+    uint64_t program_us;
+    uint64_t erase_us;
+    uint64_t max_pages;         // simulated physical pages, 0 = whole geometry
+    uint64_t seed;
+    const char* csv_file;
+} GcConfig;
+
+// One simulated drive. Only FULL blocks sit in the victim buckets, one doubly linked
+// list per valid page count, oldest change at the head.
+typedef struct {
+    uint64_t blocks;
+    uint64_t ppb;
+    uint64_t physical_pages;
+    uint64_t logical_pages;
+    gc_policy policy;
+
+    uint32_t* l2p;
+    uint32_t* p2l;
+    uint16_t* valid;
+    uint8_t* state;
+    uint32_t* prev;
+    uint32_t* next;
+    uint64_t* stamp;            // host write count when the block entered its bucket
+    uint32_t* bucket_head;
+    uint32_t* bucket_tail;
+    uint32_t* free_stack;
+    uint64_t free_count;
+
+    uint32_t host_block;
+    uint64_t host_page;
+    uint32_t gc_block;
+    uint64_t gc_page;
+
+    uint64_t now;
+    uint64_t host_writes;
+    uint64_t gc_copies;
+    uint64_t erases;
+    uint64_t gc_runs;
+} GcSim;
+
+typedef struct {
+    const char* workload;
+    gc_policy policy;
+    uint64_t rate;
+    double op_percent;
+    uint64_t simulated_blocks;
+    double waf;
+    double copy_mbps;
+    double host_mbps;
+    uint64_t host_writes;
+    uint64_t gc_copies;
+    uint64_t erases;
+    double seconds;
+    int failed;
+} GcResult;
+
+void print_usage(const char* prog);
+int parse_list(const char* str, uint64_t* out, int* count);
+void run_point(const GcConfig* cfg, const MetaData* meta, GcResult* result);
+
+static const char* POLICY_NAMES[] = { "greedy", "cost-benefit" };
+
+int main(int argc, char* argv[]) {
+    GcConfig cfg = {
+        .meta_file = META_FILE,
+        .warmup = 2.0,
+        .measure = 1.0,
+        .read_us = 50,
+        .program_us = 500,
+        .erase_us = 3000,
+        .max_pages = 4 * 1024 * 1024,
+        .seed = 1,
+    };
+    const char* rate_list = NULL;
+    const char* workload_list = "uniform,zipf,seq";
+    const char* policy_list = "greedy,cost-benefit";
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : NULL;
+        if (strcmp(arg, "--meta") == 0 && value != NULL) {
+            cfg.meta_file = value;
+        } else if (strcmp(arg, "--rates") == 0 && value != NULL) {
+            rate_list = value;
+        } else if (strcmp(arg, "--workloads") == 0 && value != NULL) {
+            workload_list = value;
+        } else if (strcmp(arg, "--gc") == 0 && value != NULL) {
+            policy_list = value;
+        } else if (strcmp(arg, "--warmup") == 0 && value != NULL) {
+            char* end = NULL;
+            cfg.warmup = strtod(value, &end);
+            if (end == value || *end != '\0' || cfg.warmup < 0.0) {
+                printf("Invalid warmup '%s'\n", value);
+                return 1;
+            }
+        } else if (strcmp(arg, "--measure") == 0 && value != NULL) {
+            char* end = NULL;
+            cfg.measure = strtod(value, &end);
+            if (end == value || *end != '\0' || cfg.measure <= 0.0) {
+                printf("Invalid measure length '%s'\n", value);
+                return 1;
+            }
+        } else if (strcmp(arg, "--latency") == 0 && value != NULL) {
+            unsigned long long r, p, e;
+            char extra;
+            if (sscanf(value, "%llu:%llu:%llu%c", &r, &p, &e, &extra) != 3 || p == 0) {
+                printf("Invalid latency '%s' (expected R:P:E in us, program > 0)\n", value);
+                return 1;
+            }
+            cfg.read_us = r;
+            cfg.program_us = p;
+            cfg.erase_us = e;
+        } else if (strcmp(arg, "--max-pages") == 0 && value != NULL) {
+            char* end = NULL;
+            cfg.max_pages = strtoull(value, &end, 10);
+            if (end == value || *end != '\0') {
+                printf("Invalid page limit '%s'\n", value);
+                return 1;
+            }
+        } else if (strcmp(arg, "--seed") == 0 && value != NULL) {
+            cfg.seed = strtoull(value, NULL, 10);
+        } else if (strcmp(arg, "--csv") == 0 && value != NULL) {
+            cfg.csv_file = value;
+        } else if (strcmp(arg, "--threads") == 0 && value != NULL) {
+            int threads = atoi(value);
+            if (threads <= 0) {
+                printf("Invalid thread count '%s'\n", value);
+                return 1;
+            }
+            omp_set_num_threads(threads);
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+        i++;
+    }
+
+    MetaData meta;
+    if (parsing_meta(cfg.meta_file, &meta) != 0) {
+        printf("Failed to read %s\n", cfg.meta_file);
+        return 1;
+    }
+    if (l2p_physical_pages(&meta) == 0 || meta.page_size == 0) {
+        printf("Invalid geometry in %s (zero field or overflow)\n", cfg.meta_file);
+        return 1;
+    }
+    if (meta.page > UINT16_MAX) {
+        printf("Pages per block above %d are not supported\n", UINT16_MAX);
+        return 1;
+    }
+
+    if (rate_list != NULL) {
+        if (parse_list(rate_list, cfg.rates, &cfg.num_rates) != 0) {
+            printf("Invalid rate list '%s'\n", rate_list);
+            return 1;
+        }
+    } else {
+        // Default sweep around the configured rate
+        static const uint64_t DEFAULT_RATES[] = { 50, 60, 70, 80, 90, 95 };
+        for (int r = 0; r < 6; r++) {
+            cfg.rates[cfg.num_rates++] = DEFAULT_RATES[r];
+        }
+        int present = 0;
+        for (int r = 0; r < cfg.num_rates; r++) {
+            present |= cfg.rates[r] == meta.provision_rate;
+        }
+        if (!present) {
+            cfg.rates[cfg.num_rates++] = meta.provision_rate;
+        }
+    }
+    for (int r = 0; r < cfg.num_rates; r++) {
+        if (cfg.rates[r] == 0 || cfg.rates[r] > 100) {
+            printf("Provision rate %lu outside 1-100\n", cfg.rates[r]);
+            return 1;
+        }
+    }
+
+    static char workload_buf[256];
+    snprintf(workload_buf, sizeof(workload_buf), "%s", workload_list);
+    for (char* tok = strtok(workload_buf, ","); tok != NULL; tok = strtok(NULL, ",")) {
+        if (cfg.num_workloads == MAX_LIST) {
+            printf("Too many workloads\n");
+            return 1;
+        }
+        cfg.workloads[cfg.num_workloads++] = tok;
+    }
+    char policy_buf[64];
+    snprintf(policy_buf, sizeof(policy_buf), "%s", policy_list);
+    for (char* tok = strtok(policy_buf, ","); tok != NULL; tok = strtok(NULL, ",")) {
+        if (strcmp(tok, "greedy") == 0 && cfg.num_policies < 2) {
+            cfg.policies[cfg.num_policies++] = GC_GREEDY;
+        } else if (strcmp(tok, "cost-benefit") == 0 && cfg.num_policies < 2) {
+            cfg.policies[cfg.num_policies++] = GC_COST_BENEFIT;
+        } else {
+            printf("Unknown GC policy '%s' (greedy or cost-benefit)\n", tok);
+            return 1;
+        }
+    }
+    if (cfg.num_workloads == 0 || cfg.num_policies == 0) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    uint64_t total_blocks = meta.bank * meta.block;
+    printf("\n=== GC / WAF Simulation ===\n");
+    printf("Geometry: %lu banks x %lu blocks x %lu pages x %lu bytes (%lu blocks)\n",
+           meta.bank, meta.block, meta.page, meta.page_size, total_blocks);
+    printf("Latency: read %lu us, program %lu us, erase %lu us, %lu banks in parallel\n",
+           cfg.read_us, cfg.program_us, cfg.erase_us, meta.bank);
+    printf("Steady state: %.1f drive writes of warmup, %.1f measured, after a sequential fill\n",
+           cfg.warmup, cfg.measure);
+
+    int points = cfg.num_workloads * cfg.num_policies * cfg.num_rates;
+    GcResult* results = calloc(points, sizeof(GcResult));
+    if (results == NULL) {
+        printf("Failed to allocate results\n");
+        return 1;
+    }
+    for (int p = 0; p < points; p++) {
+        results[p].workload = cfg.workloads[p / (cfg.num_policies * cfg.num_rates)];
+        results[p].policy = cfg.policies[p / cfg.num_rates % cfg.num_policies];
+        results[p].rate = cfg.rates[p % cfg.num_rates];
+    }
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    // Sweep points are independent drives
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int p = 0; p < points; p++) {
+        run_point(&cfg, &meta, &results[p]);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    if (results[0].simulated_blocks < total_blocks) {
+        printf("Scaled: %lu of %lu blocks simulated (--max-pages %lu), WAF depends on OP and pages per block\n",
+               results[0].simulated_blocks, total_blocks, cfg.max_pages);
+    }
+    printf("\n%-10s %-13s %5s %7s %8s %12s %12s %10s %8s\n",
+           "Workload", "GC", "Rate", "OP %", "WAF", "Copy MB/s", "Host MB/s", "Erases", "Sim s");
+    FILE* csv = NULL;
+    if (cfg.csv_file != NULL) {
+        csv = fopen(cfg.csv_file, "w");
+        if (csv == NULL) {
+            printf("Failed to open %s\n", cfg.csv_file);
+        } else {
+            fprintf(csv, "workload,gc,provision_rate,op_percent,waf,copy_mbps,host_mbps,host_writes,gc_copies,erases\n");
+        }
+    }
+    int failed = 0;
+    for (int p = 0; p < points; p++) {
+        GcResult* r = &results[p];
+        if (r->failed) {
+            printf("%-10s %-13s %5lu  %s\n", r->workload, POLICY_NAMES[r->policy], r->rate,
+                   "failed (allocation, unknown workload or no OP left after the GC reserve)");
+            failed = 1;
+            continue;
+        }
+        printf("%-10s %-13s %5lu %7.2f %8.3f %12.2f %12.2f %10lu %8.2f\n",
+               r->workload, POLICY_NAMES[r->policy], r->rate, r->op_percent, r->waf,
+               r->copy_mbps, r->host_mbps, r->erases, r->seconds);
+        if (csv != NULL) {
+            fprintf(csv, "%s,%s,%lu,%.4f,%.6f,%.4f,%.4f,%lu,%lu,%lu\n",
+                    r->workload, POLICY_NAMES[r->policy], r->rate, r->op_percent, r->waf,
+                    r->copy_mbps, r->host_mbps, r->host_writes, r->gc_copies, r->erases);
+        }
+    }
+    if (csv != NULL) {
+        fclose(csv);
+        printf("\nCSV written to %s\n", cfg.csv_file);
+    }
+    printf("\nNo-GC host bandwidth: %.2f MB/s\n",
+           (double)meta.bank * meta.page_size / (cfg.program_us * 1e-6) / (1024.0 * 1024.0));
+    printf("Total time: %.2f s\n", (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9);
+
+    free(results);
+    return failed;
+}
+
+void print_usage(const char* prog) {
+    printf("Usage: %s [options]\n", prog);
+    printf("  --meta FILE          Geometry file (default %s)\n", META_FILE);
+    printf("  --rates LIST         Provision rates to sweep, e.g. 70,80,90 (default 50-95 and the file's rate)\n");
+    printf("  --workloads LIST     Overwrite patterns: uniform, zipf[:THETA], seq (default all three)\n");
+    printf("  --gc LIST            greedy, cost-benefit (default both)\n");
+    printf("  --warmup DW          Drive writes before measuring (default 2)\n");
+    printf("  --measure DW         Drive writes measured (default 1)\n");
+    printf("  --latency R:P:E      Page read, page program, block erase in us (default 50:500:3000)\n");
+    printf("  --max-pages N        Simulate at most N physical pages by scaling the block count,\n");
+    printf("                       0 simulates the whole geometry (default 4194304)\n");
+    printf("  --threads N          Sweep points simulated in parallel (default: all CPUs)\n");
+    printf("  --seed N             Workload seed (default 1)\n");
+    printf("  --csv FILE           Also write the results as CSV\n");
+}
+
+int parse_list(const char* str, uint64_t* out, int* count) {
+    *count = 0;
+    const char* p = str;
+    while (*p != '\0') {
+        char* end = NULL;
+        unsigned long long value = strtoull(p, &end, 10);
+        if (end == p || *count == MAX_LIST || (*end != ',' && *end != '\0')) {
+            return -1;
+        }
+        out[(*count)++] = value;
+        p = *end == ',' ? end + 1 : end;
+    }
+    return *count > 0 ? 0 : -1;
+}
+
+/* ---------- block lists ---------- */
+
+static void bucket_remove(GcSim* s, uint32_t blk) {
+    uint16_t v = s->valid[blk];
+    if (s->prev[blk] != NIL) {
+        s->next[s->prev[blk]] = s->next[blk];
+    } else {
+        s->bucket_head[v] = s->next[blk];
+    }
+    if (s->next[blk] != NIL) {
+        s->prev[s->next[blk]] = s->prev[blk];
+    } else {
+        s->bucket_tail[v] = s->prev[blk];
+    }
+}
+
+static void bucket_append(GcSim* s, uint32_t blk) {
+    uint16_t v = s->valid[blk];
+    s->prev[blk] = s->bucket_tail[v];
+    s->next[blk] = NIL;
+    if (s->bucket_tail[v] != NIL) {
+        s->next[s->bucket_tail[v]] = blk;
+    } else {
+        s->bucket_head[v] = blk;
+    }
+    s->bucket_tail[v] = blk;
+    s->stamp[blk] = s->now;
+}
+
+static void close_block(GcSim* s, uint32_t blk) {
+    s->state[blk] = BLOCK_FULL;
+    bucket_append(s, blk);
+}
+
+static void invalidate(GcSim* s, uint32_t ppn) {
+    uint32_t blk = ppn / s->ppb;
+    s->p2l[ppn] = NIL;
+    if (s->state[blk] == BLOCK_FULL) {
+        bucket_remove(s, blk);
+        s->valid[blk]--;
+        bucket_append(s, blk);
+    } else {
+        s->valid[blk]--;
+    }
+}
+
+/* ---------- GC ---------- */
+
+static uint32_t select_victim(GcSim* s) {
+    if (s->policy == GC_GREEDY) {
+        for (uint64_t v = 0; v < s->ppb; v++) {
+            if (s->bucket_head[v] != NIL) {
+                return s->bucket_head[v];
+            }
+        }
+        return NIL;
+    }
+    // cost-benefit: (1 - u) * age / 2u, the head of each bucket is its oldest block
+    if (s->bucket_head[0] != NIL) {
+        return s->bucket_head[0];
+    }
+    uint32_t best = NIL;
+    double best_score = -1.0;
+    for (uint64_t v = 1; v < s->ppb; v++) {
+        uint32_t blk = s->bucket_head[v];
+        if (blk == NIL) {
+            continue;
+        }
+        double u = (double)v / s->ppb;
+        double age = (double)(s->now - s->stamp[blk] + 1);
+        double score = (1.0 - u) * age / (2.0 * u);
+        if (score > best_score) {
+            best_score = score;
+            best = blk;
+        }
+    }
+    return best;
+}
+
+static uint32_t take_free(GcSim* s) {
+    uint32_t blk = s->free_stack[--s->free_count];
+    s->state[blk] = BLOCK_ACTIVE;
+    return blk;
+}
+
+static int gc_once(GcSim* s) {
+    uint32_t victim = select_victim(s);
+    if (victim == NIL) {
+        return -1;
+    }
+    bucket_remove(s, victim);
+    s->gc_runs++;
+
+    uint64_t first = (uint64_t)victim * s->ppb;
+    for (uint64_t ppn = first; ppn < first + s->ppb && s->valid[victim] > 0; ppn++) {
+        uint32_t lpn = s->p2l[ppn];
+        if (lpn == NIL) {
+            continue;
+        }
+        if (s->gc_block == NIL || s->gc_page == s->ppb) {
+            if (s->gc_block != NIL) {
+                close_block(s, s->gc_block);
+            }
+            if (s->free_count == 0) {
+                return -1;
+            }
+            s->gc_block = take_free(s);
+            s->gc_page = 0;
+        }
+        uint32_t dest = (uint32_t)(s->gc_block * s->ppb + s->gc_page++);
+        s->p2l[dest] = lpn;
+        s->l2p[lpn] = dest;
+        s->valid[s->gc_block]++;
+        s->p2l[ppn] = NIL;
+        s->valid[victim]--;
+        s->gc_copies++;
+    }
+
+    s->state[victim] = BLOCK_FREE;
+    s->free_stack[s->free_count++] = victim;
+    s->erases++;
+    return 0;
+}
+
+static int host_write(GcSim* s, uint64_t lpn) {
+    uint32_t old = s->l2p[lpn];
+    if (old != NIL) {
+        invalidate(s, old);
+    }
+    if (s->host_block == NIL || s->host_page == s->ppb) {
+        if (s->host_block != NIL) {
+            close_block(s, s->host_block);
+        }
+        while (s->free_count <= GC_RESERVE) {
+            if (gc_once(s) != 0) {
+                return -1;
+            }
+        }
+        s->host_block = take_free(s);
+        s->host_page = 0;
+    }
+    uint32_t ppn = (uint32_t)(s->host_block * s->ppb + s->host_page++);
+    s->p2l[ppn] = (uint32_t)lpn;
+    s->l2p[lpn] = ppn;
+    s->valid[s->host_block]++;
+    s->host_writes++;
+    s->now++;
+    return 0;
+}
+
+static void gc_sim_free(GcSim* s) {
+    free(s->l2p);
+    free(s->p2l);
+    free(s->valid);
+    free(s->state);
+    free(s->prev);
+    free(s->next);
+    free(s->stamp);
+    free(s->bucket_head);
+    free(s->bucket_tail);
+    free(s->free_stack);
+}
+
+static int gc_sim_init(GcSim* s, uint64_t blocks, uint64_t ppb, uint64_t logical_pages, gc_policy policy) {
+    memset(s, 0, sizeof(*s));
+    s->blocks = blocks;
+    s->ppb = ppb;
+    s->physical_pages = blocks * ppb;
+    s->logical_pages = logical_pages;
+    s->policy = policy;
+    s->host_block = NIL;
+    s->gc_block = NIL;
+
+    s->l2p = malloc(logical_pages * sizeof(uint32_t));
+    s->p2l = malloc(s->physical_pages * sizeof(uint32_t));
+    s->valid = calloc(blocks, sizeof(uint16_t));
+    s->state = calloc(blocks, sizeof(uint8_t));
+    s->prev = malloc(blocks * sizeof(uint32_t));
+    s->next = malloc(blocks * sizeof(uint32_t));
+    s->stamp = calloc(blocks, sizeof(uint64_t));
+    s->bucket_head = malloc((ppb + 1) * sizeof(uint32_t));
+    s->bucket_tail = malloc((ppb + 1) * sizeof(uint32_t));
+    s->free_stack = malloc(blocks * sizeof(uint32_t));
+    if (s->l2p == NULL || s->p2l == NULL || s->valid == NULL || s->state == NULL || s->prev == NULL ||
+        s->next == NULL || s->stamp == NULL || s->bucket_head == NULL || s->bucket_tail == NULL ||
+        s->free_stack == NULL) {
+        gc_sim_free(s);
+        return -1;
+    }
+    memset(s->l2p, 0xFF, logical_pages * sizeof(uint32_t));
+    memset(s->p2l, 0xFF, s->physical_pages * sizeof(uint32_t));
+    memset(s->bucket_head, 0xFF, (ppb + 1) * sizeof(uint32_t));
+    memset(s->bucket_tail, 0xFF, (ppb + 1) * sizeof(uint32_t));
+    for (uint64_t b = 0; b < blocks; b++) {
+        s->free_stack[s->free_count++] = (uint32_t)(blocks - 1 - b);
+    }
+    return 0;
+}
+
+void run_point(const GcConfig* cfg, const MetaData* meta, GcResult* result) {
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    // Scale the block count down for huge geometries, keeping pages per block and the OP ratio
+    uint64_t blocks = meta->bank * meta->block;
+    if (cfg->max_pages != 0 && blocks * meta->page > cfg->max_pages) {
+        blocks = cfg->max_pages / meta->page;
+    }
+    MetaData sim = *meta;
+    sim.bank = 1;
+    sim.block = blocks;
+    sim.provision_rate = result->rate;
+    uint64_t logical = l2p_logical_pages(&sim);
+    uint64_t reserve = (GC_RESERVE + 2) * meta->page;
+    uint64_t physical = blocks * meta->page;
+    result->simulated_blocks = blocks;
+    if (physical >= NIL || physical <= reserve || logical == 0) {
+        result->failed = 1;
+        return;
+    }
+    if (logical > physical - reserve) {
+        logical = physical - reserve;
+    }
+    result->op_percent = 100.0 * (physical - logical) / physical;
+
+    GcSim s;
+    workload wl;
+    if (gc_sim_init(&s, blocks, meta->page, logical, result->policy) != 0) {
+        result->failed = 1;
+        return;
+    }
+    if (workload_open(&wl, result->workload, logical, meta->page_size, 0, cfg->seed) != 0 ||
+        wl.kind == WORKLOAD_TRACE) {
+        workload_close(&wl);
+        gc_sim_free(&s);
+        result->failed = 1;
+        return;
+    }
+
+    int ok = 1;
+    for (uint64_t lpn = 0; lpn < logical && ok; lpn++) {
+        ok = host_write(&s, lpn) == 0;
+    }
+    uint64_t warm = (uint64_t)(cfg->warmup * logical);
+    uint64_t measured = (uint64_t)(cfg->measure * logical);
+    uint64_t lpn;
+    int is_write;
+    for (uint64_t i = 0; i < warm && ok; i++) {
+        workload_next(&wl, &lpn, &is_write);
+        ok = host_write(&s, lpn) == 0;
+    }
+    uint64_t host0 = s.host_writes, copies0 = s.gc_copies, erases0 = s.erases;
+    for (uint64_t i = 0; i < measured && ok; i++) {
+        workload_next(&wl, &lpn, &is_write);
+        ok = host_write(&s, lpn) == 0;
+    }
+    workload_close(&wl);
+
+    if (ok && s.host_writes > host0) {
+        result->host_writes = s.host_writes - host0;
+        result->gc_copies = s.gc_copies - copies0;
+        result->erases = s.erases - erases0;
+        result->waf = (double)(result->host_writes + result->gc_copies) / result->host_writes;
+        // Banks work in parallel: every program, copy (read + program) and erase occupies one bank
+        double busy_us = result->host_writes * (double)cfg->program_us +
+                         result->gc_copies * (double)(cfg->read_us + cfg->program_us) +
+                         result->erases * (double)cfg->erase_us;
+        double seconds = busy_us / meta->bank / 1e6;
+        double mb = meta->page_size / (1024.0 * 1024.0);
+        result->host_mbps = result->host_writes * mb / seconds;
+        result->copy_mbps = result->gc_copies * mb / seconds;
+    }
+    result->failed = !ok || s.host_writes == host0;
+    gc_sim_free(&s);
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    result->seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+}
@@ -0,0 +1,611 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "l2p_map.h"
+
+#define NIL UINT32_MAX
+
+typedef struct {
+    uint32_t start;             // offset inside the translation page
+    uint32_t len;
+    uint64_t ppn;
+} l2p_run;
+
+// One translation page worth of entries in extent mode
+typedef struct {
+    l2p_run* runs;
+    uint32_t count;
+    uint32_t capacity;
+    uint64_t* packed;           // non-NULL when the runs were too fragmented
+    uint64_t updates;           // updates since falling back, to retry run compression
+} l2p_chunk;
+
+// DFTL cached mapping table entry
+typedef struct {
+    uint64_t lpn;
+    uint64_t ppn;
+    uint32_t prev;              // LRU list, head is most recently used
+    uint32_t next;
+    uint32_t hnext;             // hash chain
+    uint32_t dprev;             // dirty entries of the same translation page
+    uint32_t dnext;
+    uint8_t dirty;
+} cmt_entry;
+
+struct l2p_map {
+    l2p_mode mode;
+    unsigned bits;
+    uint64_t unmapped;          // all-ones value of the entry width
+    uint64_t logical_pages;
+    uint64_t physical_pages;
+    uint64_t page_size;
+    uint64_t tpage_entries;
+    uint64_t tpages;
+    l2p_stats counters;
+
+    uint64_t* packed;           // flat table, or the flash image of the cached table
+    uint64_t packed_words;
+    l2p_chunk* chunks;
+
+    cmt_entry* cache;
+    uint32_t* buckets;
+    uint64_t bucket_mask;
+    uint32_t capacity;
+    uint32_t used;
+    uint32_t lru_head;
+    uint32_t lru_tail;
+    uint32_t* dirty_head;       // per translation page
+};
+
+unsigned l2p_ppn_bits(uint64_t physical_pages) {
+    // Smallest width whose all-ones value is not a valid page number
+    unsigned bits = 1;
+    while (bits < 64 && ((1ULL << bits) - 1) < physical_pages) {
+        bits++;
+    }
+    return bits;
+}
+
+uint64_t l2p_physical_pages(const MetaData* meta) {
+    uint64_t blocks, pages;
+    if (__builtin_mul_overflow(meta->bank, meta->block, &blocks) ||
+        __builtin_mul_overflow(blocks, meta->page, &pages)) {
+        return 0;
+    }
+    return pages;
+}
+
+uint64_t l2p_logical_pages(const MetaData* meta) {
+    uint64_t pages = l2p_physical_pages(meta);
+    if (meta->provision_rate > 100) {
+        return 0;
+    }
+    // Same split rounding as calc_practical_usage_sector
+    uint64_t op = pages / 100 * (100 - meta->provision_rate) + pages % 100 * (100 - meta->provision_rate) / 100;
+    return pages - op;
+}
+
+static inline uint64_t width_mask(unsigned bits) {
+    return bits == 64 ? ~0ULL : (1ULL << bits) - 1;
+}
+
+static inline uint64_t packed_get(const uint64_t* words, unsigned bits, uint64_t idx) {
+    uint64_t bit = idx * bits;
+    uint64_t w = bit >> 6;
+    unsigned off = bit & 63;
+    uint64_t value = words[w] >> off;
+    if (off + bits > 64) {
+        value |= words[w + 1] << (64 - off);
+    }
+    return value & width_mask(bits);
+}
+
+static inline void packed_set(uint64_t* words, unsigned bits, uint64_t idx, uint64_t value) {
+    uint64_t mask = width_mask(bits);
+    uint64_t bit = idx * bits;
+    uint64_t w = bit >> 6;
+    unsigned off = bit & 63;
+    value &= mask;
+    words[w] = (words[w] & ~(mask << off)) | (value << off);
+    if (off + bits > 64) {
+        uint64_t high = (1ULL << (off + bits - 64)) - 1;
+        words[w + 1] = (words[w + 1] & ~high) | (value >> (64 - off));
+    }
+}
+
+static inline uint64_t packed_words(uint64_t entries, unsigned bits) {
+    return (entries * bits + 63) / 64;
+}
+
+static uint64_t* packed_alloc(uint64_t entries, unsigned bits) {
+    uint64_t words = packed_words(entries, bits);
+    uint64_t* table = malloc(words * sizeof(uint64_t));
+    if (table != NULL) {
+        memset(table, 0xFF, words * sizeof(uint64_t));
+    }
+    return table;
+}
+
+/* ---------- extent mode ---------- */
+
+static uint64_t chunk_entries(const l2p_map* map, uint64_t index) {
+    uint64_t first = index * map->tpage_entries;
+    uint64_t left = map->logical_pages - first;
+    return left < map->tpage_entries ? left : map->tpage_entries;
+}
+
+static inline int runs_mergeable(const l2p_run* a, const l2p_run* b) {
+    return a->start + a->len == b->start && a->ppn + a->len == b->ppn;
+}
+
+// Index of the first run starting after offset
+static uint32_t runs_upper_bound(const l2p_chunk* c, uint32_t offset) {
+    uint32_t lo = 0, hi = c->count;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (c->runs[mid].start <= offset) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+static int runs_reserve(l2p_chunk* c, uint32_t extra) {
+    if (c->count + extra <= c->capacity) {
+        return 0;
+    }
+    uint32_t capacity = c->capacity ? c->capacity : 4;
+    while (capacity < c->count + extra) {
+        capacity *= 2;
+    }
+    l2p_run* grown = realloc(c->runs, capacity * sizeof(l2p_run));
+    if (grown == NULL) {
+        return -1;
+    }
+    c->runs = grown;
+    c->capacity = capacity;
+    return 0;
+}
+
+static void runs_remove(l2p_chunk* c, uint32_t at) {
+    memmove(&c->runs[at], &c->runs[at + 1], (c->count - at - 1) * sizeof(l2p_run));
+    c->count--;
+}
+
+static uint64_t runs_lookup(const l2p_chunk* c, uint32_t offset) {
+    uint32_t i = runs_upper_bound(c, offset);
+    if (i > 0 && offset < c->runs[i - 1].start + c->runs[i - 1].len) {
+        return c->runs[i - 1].ppn + (offset - c->runs[i - 1].start);
+    }
+    return L2P_UNMAPPED;
+}
+
+static int runs_update(l2p_chunk* c, uint32_t offset, uint64_t ppn) {
+    if (runs_reserve(c, 2) != 0) {
+        return -1;
+    }
+    uint32_t at = runs_upper_bound(c, offset);
+    l2p_run pieces[3];
+    int n = 0;
+
+    if (at > 0 && offset < c->runs[at - 1].start + c->runs[at - 1].len) {
+        // Split the run that covers offset around it
+        l2p_run old = c->runs[at - 1];
+        if (old.ppn + (offset - old.start) == ppn) {
+            return 0;
+        }
+        uint32_t left = offset - old.start;
+        if (left > 0) {
+            pieces[n++] = (l2p_run){ old.start, left, old.ppn };
+        }
+        pieces[n++] = (l2p_run){ offset, 1, ppn };
+        if (old.len - left - 1 > 0) {
+            pieces[n++] = (l2p_run){ offset + 1, old.len - left - 1, old.ppn + left + 1 };
+        }
+        at--;
+        runs_remove(c, at);
+    } else {
+        pieces[n++] = (l2p_run){ offset, 1, ppn };
+    }
+
+    memmove(&c->runs[at + n], &c->runs[at], (c->count - at) * sizeof(l2p_run));
+    memcpy(&c->runs[at], pieces, n * sizeof(l2p_run));
+    c->count += n;
+
+    // Merge the new entry with its neighbours
+    uint32_t q = at + (pieces[0].start == offset ? 0 : 1);
+    if (q > 0 && runs_mergeable(&c->runs[q - 1], &c->runs[q])) {
+        c->runs[q - 1].len++;
+        runs_remove(c, q);
+        q--;
+    }
+    if (q + 1 < c->count && runs_mergeable(&c->runs[q], &c->runs[q + 1])) {
+        c->runs[q].len += c->runs[q + 1].len;
+        runs_remove(c, q + 1);
+    }
+    return 0;
+}
+
+static int chunk_to_packed(l2p_map* map, l2p_chunk* c, uint64_t entries) {
+    c->packed = packed_alloc(entries, map->bits);
+    if (c->packed == NULL) {
+        return -1;
+    }
+    for (uint32_t i = 0; i < c->count; i++) {
+        for (uint32_t k = 0; k < c->runs[i].len; k++) {
+            packed_set(c->packed, map->bits, c->runs[i].start + k, c->runs[i].ppn + k);
+        }
+    }
+    free(c->runs);
+    c->runs = NULL;
+    c->count = 0;
+    c->capacity = 0;
+    c->updates = 0;
+    return 0;
+}
+
+// Go back to runs when the packed chunk has become sequential again
+static void chunk_try_runs(l2p_map* map, l2p_chunk* c, uint64_t entries) {
+    uint64_t runs = 0;
+    uint64_t prev = L2P_UNMAPPED;
+    for (uint64_t i = 0; i < entries; i++) {
+        uint64_t ppn = packed_get(c->packed, map->bits, i);
+        if (ppn != map->unmapped && (prev == L2P_UNMAPPED || ppn != prev + 1)) {
+            runs++;
+        }
+        prev = ppn == map->unmapped ? L2P_UNMAPPED : ppn;
+    }
+    if (runs * sizeof(l2p_run) * 2 > packed_words(entries, map->bits) * sizeof(uint64_t)) {
+        return;
+    }
+
+    l2p_chunk fresh = {0};
+    if (runs_reserve(&fresh, (uint32_t)(runs ? runs : 1)) != 0) {
+        return;
+    }
+    prev = L2P_UNMAPPED;
+    for (uint64_t i = 0; i < entries; i++) {
+        uint64_t ppn = packed_get(c->packed, map->bits, i);
+        if (ppn == map->unmapped) {
+            prev = L2P_UNMAPPED;
+            continue;
+        }
+        if (prev != L2P_UNMAPPED && ppn == prev + 1) {
+            fresh.runs[fresh.count - 1].len++;
+        } else {
+            fresh.runs[fresh.count++] = (l2p_run){ (uint32_t)i, 1, ppn };
+        }
+        prev = ppn;
+    }
+    free(c->packed);
+    *c = fresh;
+}
+
+static uint64_t extent_lookup(const l2p_map* map, uint64_t lpn) {
+    const l2p_chunk* c = &map->chunks[lpn / map->tpage_entries];
+    uint32_t offset = (uint32_t)(lpn % map->tpage_entries);
+    if (c->packed != NULL) {
+        uint64_t ppn = packed_get(c->packed, map->bits, offset);
+        return ppn == map->unmapped ? L2P_UNMAPPED : ppn;
+    }
+    return runs_lookup(c, offset);
+}
+
+static int extent_update(l2p_map* map, uint64_t lpn, uint64_t ppn) {
+    uint64_t index = lpn / map->tpage_entries;
+    l2p_chunk* c = &map->chunks[index];
+    uint32_t offset = (uint32_t)(lpn % map->tpage_entries);
+    uint64_t entries = chunk_entries(map, index);
+
+    if (c->packed != NULL) {
+        packed_set(c->packed, map->bits, offset, ppn);
+        if (++c->updates >= entries) {
+            c->updates = 0;
+            chunk_try_runs(map, c, entries);
+        }
+        return 0;
+    }
+    if (runs_update(c, offset, ppn) != 0) {
+        return -1;
+    }
+    if ((uint64_t)c->count * sizeof(l2p_run) > packed_words(entries, map->bits) * sizeof(uint64_t)) {
+        return chunk_to_packed(map, c, entries);
+    }
+    return 0;
+}
+
+/* ---------- cached (DFTL) mode ---------- */
+
+static inline uint64_t hash_lpn(uint64_t lpn) {
+    lpn ^= lpn >> 33;
+    lpn *= 0xff51afd7ed558ccdULL;
+    lpn ^= lpn >> 33;
+    return lpn;
+}
+
+static uint32_t cache_find(const l2p_map* map, uint64_t lpn) {
+    uint32_t i = map->buckets[hash_lpn(lpn) & map->bucket_mask];
+    while (i != NIL && map->cache[i].lpn != lpn) {
+        i = map->cache[i].hnext;
+    }
+    return i;
+}
+
+static void lru_unlink(l2p_map* map, uint32_t i) {
+    cmt_entry* e = &map->cache[i];
+    if (e->prev != NIL) {
+        map->cache[e->prev].next = e->next;
+    } else {
+        map->lru_head = e->next;
+    }
+    if (e->next != NIL) {
+        map->cache[e->next].prev = e->prev;
+    } else {
+        map->lru_tail = e->prev;
+    }
+}
+
+static void lru_push_front(l2p_map* map, uint32_t i) {
+    cmt_entry* e = &map->cache[i];
+    e->prev = NIL;
+    e->next = map->lru_head;
+    if (map->lru_head != NIL) {
+        map->cache[map->lru_head].prev = i;
+    }
+    map->lru_head = i;
+    if (map->lru_tail == NIL) {
+        map->lru_tail = i;
+    }
+}
+
+static void mark_dirty(l2p_map* map, uint32_t i) {
+    cmt_entry* e = &map->cache[i];
+    if (e->dirty) {
+        return;
+    }
+    uint64_t tpage = e->lpn / map->tpage_entries;
+    e->dirty = 1;
+    e->dprev = NIL;
+    e->dnext = map->dirty_head[tpage];
+    if (e->dnext != NIL) {
+        map->cache[e->dnext].dprev = i;
+    }
+    map->dirty_head[tpage] = i;
+}
+
+// Read-modify-write of one translation page with every dirty cached entry that belongs to it
+static void writeback(l2p_map* map, uint64_t tpage) {
+    map->counters.tpage_reads++;
+    map->counters.tpage_writes++;
+    uint32_t i = map->dirty_head[tpage];
+    while (i != NIL) {
+        cmt_entry* e = &map->cache[i];
+        packed_set(map->packed, map->bits, e->lpn, e->ppn == L2P_UNMAPPED ? map->unmapped : e->ppn);
+        e->dirty = 0;
+        i = e->dnext;
+    }
+    map->dirty_head[tpage] = NIL;
+}
+
+static uint32_t cache_evict(l2p_map* map) {
+    uint32_t victim = map->lru_tail;
+    cmt_entry* e = &map->cache[victim];
+    if (e->dirty) {
+        writeback(map, e->lpn / map->tpage_entries);
+    }
+    lru_unlink(map, victim);
+    uint32_t* link = &map->buckets[hash_lpn(e->lpn) & map->bucket_mask];
+    while (*link != victim) {
+        link = &map->cache[*link].hnext;
+    }
+    *link = e->hnext;
+    map->counters.evictions++;
+    return victim;
+}
+
+static uint32_t cache_insert(l2p_map* map, uint64_t lpn, uint64_t ppn) {
+    uint32_t i = map->used < map->capacity ? map->used++ : cache_evict(map);
+    cmt_entry* e = &map->cache[i];
+    e->lpn = lpn;
+    e->ppn = ppn;
+    e->dirty = 0;
+    uint64_t bucket = hash_lpn(lpn) & map->bucket_mask;
+    e->hnext = map->buckets[bucket];
+    map->buckets[bucket] = i;
+    lru_push_front(map, i);
+    return i;
+}
+
+static uint64_t cached_lookup(l2p_map* map, uint64_t lpn) {
+    uint32_t i = cache_find(map, lpn);
+    if (i != NIL) {
+        map->counters.hits++;
+        lru_unlink(map, i);
+        lru_push_front(map, i);
+        return map->cache[i].ppn;
+    }
+    map->counters.misses++;
+    map->counters.tpage_reads++;
+    uint64_t ppn = packed_get(map->packed, map->bits, lpn);
+    ppn = ppn == map->unmapped ? L2P_UNMAPPED : ppn;
+    cache_insert(map, lpn, ppn);
+    return ppn;
+}
+
+static void cached_update(l2p_map* map, uint64_t lpn, uint64_t ppn) {
+    uint32_t i = cache_find(map, lpn);
+    if (i != NIL) {
+        map->counters.hits++;
+        lru_unlink(map, i);
+        lru_push_front(map, i);
+    } else {
+        // The whole entry is overwritten, the translation page is only read at writeback
+        map->counters.misses++;
+        i = cache_insert(map, lpn, ppn);
+    }
+    map->cache[i].ppn = ppn;
+    mark_dirty(map, i);
+}
+
+/* ---------- common ---------- */
+
+l2p_map* l2p_create(const MetaData* meta, l2p_mode mode, uint64_t cache_bytes) {
+    uint64_t physical = l2p_physical_pages(meta);
+    uint64_t logical = l2p_logical_pages(meta);
+    if (physical == 0 || logical == 0 || meta->page_size == 0) {
+        return NULL;
+    }
+
+    l2p_map* map = calloc(1, sizeof(l2p_map));
+    if (map == NULL) {
+        return NULL;
+    }
+    map->mode = mode;
+    map->bits = l2p_ppn_bits(physical);
+    map->unmapped = width_mask(map->bits);
+    map->logical_pages = logical;
+    map->physical_pages = physical;
+    map->page_size = meta->page_size;
+    map->tpage_entries = meta->page_size * 8 / map->bits;
+    if (map->tpage_entries == 0) {
+        map->tpage_entries = 1;
+    }
+    if (map->tpage_entries > UINT32_MAX) {
+        map->tpage_entries = UINT32_MAX;
+    }
+    map->tpages = (logical + map->tpage_entries - 1) / map->tpage_entries;
+    map->lru_head = NIL;
+    map->lru_tail = NIL;
+
+    int ok = 1;
+    if (mode == L2P_FLAT || mode == L2P_CACHED) {
+        map->packed_words = packed_words(logical, map->bits);
+        map->packed = packed_alloc(logical, map->bits);
+        ok = map->packed != NULL;
+    } else {
+        map->chunks = calloc(map->tpages, sizeof(l2p_chunk));
+        ok = map->chunks != NULL;
+    }
+
+    if (ok && mode == L2P_CACHED) {
+        uint64_t entries = cache_bytes / (sizeof(cmt_entry) + sizeof(uint32_t));
+        if (entries == 0) {
+            entries = 1;
+        }
+        if (entries > logical) {
+            entries = logical;
+        }
+        if (entries >= NIL) {
+            entries = NIL - 1;
+        }
+        uint64_t buckets = 1;
+        while (buckets < entries) {
+            buckets *= 2;
+        }
+        map->capacity = (uint32_t)entries;
+        map->bucket_mask = buckets - 1;
+        map->cache = malloc(entries * sizeof(cmt_entry));
+        map->buckets = malloc(buckets * sizeof(uint32_t));
+        map->dirty_head = malloc(map->tpages * sizeof(uint32_t));
+        ok = map->cache != NULL && map->buckets != NULL && map->dirty_head != NULL;
+        if (ok) {
+            memset(map->buckets, 0xFF, buckets * sizeof(uint32_t));
+            memset(map->dirty_head, 0xFF, map->tpages * sizeof(uint32_t));
+        }
+    }
+
+    if (!ok) {
+        l2p_destroy(map);
+        return NULL;
+    }
+    return map;
+}
+
+void l2p_destroy(l2p_map* map) {
+    if (map == NULL) {
+        return;
+    }
+    if (map->chunks != NULL) {
+        for (uint64_t i = 0; i < map->tpages; i++) {
+            free(map->chunks[i].runs);
+            free(map->chunks[i].packed);
+        }
+        free(map->chunks);
+    }
+    free(map->packed);
+    free(map->cache);
+    free(map->buckets);
+    free(map->dirty_head);
+    free(map);
+}
+
+uint64_t l2p_lookup(l2p_map* map, uint64_t lpn) {
+    map->counters.lookups++;
+    switch (map->mode) {
+        case L2P_FLAT: {
+            uint64_t ppn = packed_get(map->packed, map->bits, lpn);
+            return ppn == map->unmapped ? L2P_UNMAPPED : ppn;
+        }
+        case L2P_EXTENT:
+            return extent_lookup(map, lpn);
+        default:
+            return cached_lookup(map, lpn);
+    }
+}
+
+int l2p_update(l2p_map* map, uint64_t lpn, uint64_t ppn) {
+    map->counters.updates++;
+    switch (map->mode) {
+        case L2P_FLAT:
+            packed_set(map->packed, map->bits, lpn, ppn);
+            return 0;
+        case L2P_EXTENT:
+            return extent_update(map, lpn, ppn);
+        default:
+            cached_update(map, lpn, ppn);
+            return 0;
+    }
+}
+
+void l2p_get_stats(const l2p_map* map, l2p_stats* stats) {
+    *stats = map->counters;
+    stats->chunks = map->tpages;
+    switch (map->mode) {
+        case L2P_FLAT:
+            stats->ram_bytes = map->packed_words * sizeof(uint64_t);
+            break;
+        case L2P_EXTENT:
+            stats->ram_bytes = map->tpages * sizeof(l2p_chunk);
+            for (uint64_t i = 0; i < map->tpages; i++) {
+                const l2p_chunk* c = &map->chunks[i];
+                if (c->packed != NULL) {
+                    stats->packed_chunks++;
+                    stats->ram_bytes += packed_words(chunk_entries(map, i), map->bits) * sizeof(uint64_t);
+                } else {
+                    stats->runs += c->count;
+                    stats->ram_bytes += c->capacity * sizeof(l2p_run);
+                }
+            }
+            break;
+        default:
+            // Entry cache + hash buckets + translation page directory + per-page dirty lists
+            stats->cache_entries = map->capacity;
+            stats->ram_bytes = map->capacity * sizeof(cmt_entry) + (map->bucket_mask + 1) * sizeof(uint32_t) +
+                               (map->tpages * map->bits + 7) / 8 + map->tpages * sizeof(uint32_t);
+            stats->flash_bytes = map->tpages * map->page_size;
+            break;
+    }
+}
+
+void l2p_reset_counters(l2p_map* map) {
+    memset(&map->counters, 0, sizeof(map->counters));
+}
+
+const char* l2p_mode_name(l2p_mode mode) {
+    static const char* NAMES[] = { "flat", "extent", "cached" };
+    return mode <= L2P_CACHED ? NAMES[mode] : "unknown";
+}
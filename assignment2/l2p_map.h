@@ -0,0 +1,67 @@
+#ifndef L2P_MAP_H
+#define L2P_MAP_H
+
+#include <stdint.h>
+
+#include "meta.h"
+
+// Page-level logical-to-physical mapping table sized from MetaData.
+// Physical page numbers are bit-packed with the smallest width that covers
+// bank * block * page, the all-ones value of that width means "unmapped".
+//
+//   flat    one packed array of logical pages entries
+//   extent  per translation page, a sorted run list (lpn, ppn, length) for
+//           sequential regions, falling back to a packed array when the runs
+//           would take more memory than the array
+//   cached  DFTL: the packed table lives in flash translation pages, RAM holds
+//           the directory of translation pages and a bounded LRU entry cache.
+//           Dirty entries of the same translation page are written back together.
+
+#define L2P_UNMAPPED UINT64_MAX
+
+typedef enum {
+    L2P_FLAT = 0,
+    L2P_EXTENT,
+    L2P_CACHED,
+} l2p_mode;
+
+typedef struct {
+    uint64_t lookups;
+    uint64_t updates;
+    uint64_t hits;              // cached mode, lookups and updates served from RAM
+    uint64_t misses;
+    uint64_t tpage_reads;       // translation page reads on misses and writebacks
+    uint64_t tpage_writes;
+    uint64_t evictions;
+    uint64_t cache_entries;     // capacity of the entry cache
+    uint64_t runs;              // extent mode
+    uint64_t packed_chunks;
+    uint64_t chunks;
+    uint64_t ram_bytes;         // in-memory mapping state
+    uint64_t flash_bytes;       // translation pages kept on flash (cached mode)
+} l2p_stats;
+
+typedef struct l2p_map l2p_map;
+
+// Bits per packed entry for a physical page count (value range plus the unmapped marker)
+unsigned l2p_ppn_bits(uint64_t physical_pages);
+
+// Logical pages exposed by PROVISION_RATE, 0 when the geometry overflows
+uint64_t l2p_logical_pages(const MetaData* meta);
+uint64_t l2p_physical_pages(const MetaData* meta);
+
+// cache_bytes bounds the entry cache of L2P_CACHED and is ignored otherwise
+l2p_map* l2p_create(const MetaData* meta, l2p_mode mode, uint64_t cache_bytes);
+void l2p_destroy(l2p_map* map);
+
+uint64_t l2p_lookup(l2p_map* map, uint64_t lpn);
+int l2p_update(l2p_map* map, uint64_t lpn, uint64_t ppn);
+
+void l2p_get_stats(const l2p_map* map, l2p_stats* stats);
+
+// Clear access counters, e.g. after a prefill
+void l2p_reset_counters(l2p_map* map);
+
+const char* l2p_mode_name(l2p_mode mode);
+
+#endif
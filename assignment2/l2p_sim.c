@@ -0,0 +1,274 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "meta.h"
+#include "l2p_map.h"
+#include "workload.h"
+
+#define OP_WRITE (1ULL << 63)
+
+typedef struct {
+    const char* meta_file;
+    const char* workload;
+    uint64_t ops;
+    uint64_t read_pct;
+    uint64_t cache_bytes;
+    uint64_t seed;
+    int prefill;
+} SimConfig;
+
+void print_usage(const char* prog);
+int parse_size(const char* str, uint64_t* out);
+uint64_t* build_ops(const SimConfig* cfg, const MetaData* meta, uint64_t logical_pages, uint64_t* count);
+int run_workload(l2p_map* map, const uint64_t* ops, uint64_t count, uint64_t physical_pages,
+                 uint64_t logical_pages, int prefill);
+void print_row(const l2p_map* map, l2p_mode mode, uint64_t count, double mapped_gb);
+
+int main(int argc, char* argv[]) {
+    SimConfig cfg = {
+        .meta_file = META_FILE,
+        .workload = "zipf",
+        .ops = 1000000,
+        .read_pct = 70,
+        .cache_bytes = 1024 * 1024,
+        .seed = 1,
+        .prefill = 1,
+    };
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : NULL;
+        if (strcmp(arg, "--meta") == 0 && value != NULL) {
+            cfg.meta_file = value;
+            i++;
+        } else if (strcmp(arg, "--workload") == 0 && value != NULL) {
+            cfg.workload = value;
+            i++;
+        } else if (strcmp(arg, "--ops") == 0 && value != NULL) {
+            if (parse_size(value, &cfg.ops) != 0 || cfg.ops == 0) {
+                printf("Invalid op count '%s'\n", value);
+                return 1;
+            }
+            i++;
+        } else if (strcmp(arg, "--read-pct") == 0 && value != NULL) {
+            if (parse_size(value, &cfg.read_pct) != 0 || cfg.read_pct > 100) {
+                printf("Invalid read percentage '%s'\n", value);
+                return 1;
+            }
+            i++;
+        } else if (strcmp(arg, "--cache") == 0 && value != NULL) {
+            if (parse_size(value, &cfg.cache_bytes) != 0 || cfg.cache_bytes == 0) {
+                printf("Invalid cache size '%s'\n", value);
+                return 1;
+            }
+            i++;
+        } else if (strcmp(arg, "--seed") == 0 && value != NULL) {
+            if (parse_size(value, &cfg.seed) != 0) {
+                printf("Invalid seed '%s'\n", value);
+                return 1;
+            }
+            i++;
+        } else if (strcmp(arg, "--no-prefill") == 0) {
+            cfg.prefill = 0;
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    MetaData meta;
+    if (parsing_meta(cfg.meta_file, &meta) != 0) {
+        printf("Failed to read %s\n", cfg.meta_file);
+        return 1;
+    }
+    uint64_t physical_pages = l2p_physical_pages(&meta);
+    uint64_t logical_pages = l2p_logical_pages(&meta);
+    if (physical_pages == 0 || logical_pages == 0 || meta.page_size == 0) {
+        printf("Invalid geometry in %s (zero field, overflow or PROVISION_RATE above 100)\n", cfg.meta_file);
+        return 1;
+    }
+
+    unsigned bits = l2p_ppn_bits(physical_pages);
+    double mapped_gb = (double)logical_pages * meta.page_size / (1024.0 * 1024.0 * 1024.0);
+    printf("\n=== L2P Mapping Table ===\n");
+    printf("Geometry: %lu banks x %lu blocks x %lu pages x %lu bytes, %lu%% provisioned\n",
+           meta.bank, meta.block, meta.page, meta.page_size, meta.provision_rate);
+    printf("Logical Pages: %lu (%.2f GB mapped)\n", logical_pages, mapped_gb);
+    printf("Physical Pages: %lu, PPN width: %u bits\n", physical_pages, bits);
+    printf("Translation Page: %lu entries\n", meta.page_size * 8 / bits);
+    printf("Unpacked 32-bit table: %.2f MB\n", logical_pages * 4.0 / (1024.0 * 1024.0));
+
+    uint64_t count = 0;
+    uint64_t* ops = build_ops(&cfg, &meta, logical_pages, &count);
+    if (ops == NULL) {
+        return 1;
+    }
+    printf("Workload: %s, %lu page accesses%s\n", cfg.workload, count,
+           cfg.prefill ? " after a sequential prefill" : "");
+
+    // flat is the reference every other mode is checked against
+    l2p_map* reference = NULL;
+    uint64_t mismatches = 0;
+    printf("\n%-8s %14s %12s %9s %9s  %s\n", "Mode", "RAM bytes", "Bytes/GB", "ns/op", "Hit rate", "Detail");
+    for (l2p_mode mode = L2P_FLAT; mode <= L2P_CACHED; mode++) {
+        l2p_map* map = l2p_create(&meta, mode, cfg.cache_bytes);
+        if (map == NULL || run_workload(map, ops, count, physical_pages, logical_pages, cfg.prefill) != 0) {
+            printf("%-8s failed to allocate the mapping table\n", l2p_mode_name(mode));
+            l2p_destroy(map);
+            l2p_destroy(reference);
+            free(ops);
+            return 1;
+        }
+        print_row(map, mode, count, mapped_gb);
+        if (mode == L2P_FLAT) {
+            reference = map;
+        } else {
+            for (uint64_t lpn = 0; lpn < logical_pages; lpn++) {
+                mismatches += l2p_lookup(map, lpn) != l2p_lookup(reference, lpn);
+            }
+            l2p_destroy(map);
+        }
+    }
+    if (mismatches == 0) {
+        printf("\nVerification: extent and cached tables match flat for all %lu entries\n", logical_pages);
+    } else {
+        printf("\nVerification FAILED: %lu entries differ from the flat table\n", mismatches);
+    }
+
+    l2p_destroy(reference);
+    free(ops);
+    return mismatches != 0;
+}
+
+void print_usage(const char* prog) {
+    printf("Usage: %s [options]\n", prog);
+    printf("  --meta FILE        Geometry file (default %s)\n", META_FILE);
+    printf("  --workload W       seq, uniform, zipf[:THETA] or a trace of \"R|W OFFSET LENGTH\" lines (default zipf)\n");
+    printf("  --ops N            Page accesses, traces stop earlier at their end, K/M/G suffix (default 1M)\n");
+    printf("  --read-pct P       Reads among synthetic accesses (default 70)\n");
+    printf("  --cache SIZE       DFTL entry cache budget in bytes, K/M/G suffix (default 1M)\n");
+    printf("  --seed N           Workload seed (default 1)\n");
+    printf("  --no-prefill       Start from an empty table instead of a sequentially written one\n");
+}
+
+int parse_size(const char* str, uint64_t* out) {
+    char* end = NULL;
+    unsigned long long value = strtoull(str, &end, 10);
+    if (end == str) {
+        return -1;
+    }
+    uint64_t scale = 1;
+    if (*end == 'K' || *end == 'k') {
+        scale = 1024ULL;
+        end++;
+    } else if (*end == 'M' || *end == 'm') {
+        scale = 1024ULL * 1024;
+        end++;
+    } else if (*end == 'G' || *end == 'g') {
+        scale = 1024ULL * 1024 * 1024;
+        end++;
+    }
+    if (*end != '\0' || __builtin_mul_overflow((uint64_t)value, scale, out)) {
+        return -1;
+    }
+    return 0;
+}
+
+// The access stream is generated once so that every mode sees exactly the same accesses
+uint64_t* build_ops(const SimConfig* cfg, const MetaData* meta, uint64_t logical_pages, uint64_t* count) {
+    workload wl;
+    if (workload_open(&wl, cfg->workload, logical_pages, meta->page_size, cfg->read_pct, cfg->seed) != 0) {
+        return NULL;
+    }
+    uint64_t capacity = wl.kind == WORKLOAD_TRACE ? 4096 : cfg->ops;
+    uint64_t* ops = malloc(capacity * sizeof(uint64_t));
+    uint64_t n = 0;
+    uint64_t lpn;
+    int is_write;
+    while (ops != NULL && n < cfg->ops && workload_next(&wl, &lpn, &is_write)) {
+        if (n == capacity) {
+            capacity *= 2;
+            uint64_t* grown = realloc(ops, capacity * sizeof(uint64_t));
+            if (grown == NULL) {
+                free(ops);
+                ops = NULL;
+                break;
+            }
+            ops = grown;
+        }
+        ops[n++] = lpn | (is_write ? OP_WRITE : 0);
+    }
+    workload_close(&wl);
+    if (ops == NULL) {
+        printf("Failed to allocate the workload\n");
+        return NULL;
+    }
+    if (n == 0) {
+        printf("Workload '%s' has no accesses\n", cfg->workload);
+        free(ops);
+        return NULL;
+    }
+    *count = n;
+    return ops;
+}
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static uint64_t elapsed_ns;
+
+// Writes take the next physical page in log order, wrapping at the end of the device
+int run_workload(l2p_map* map, const uint64_t* ops, uint64_t count, uint64_t physical_pages,
+                 uint64_t logical_pages, int prefill) {
+    uint64_t next_ppn = 0;
+    if (prefill) {
+        for (uint64_t lpn = 0; lpn < logical_pages; lpn++) {
+            if (l2p_update(map, lpn, next_ppn) != 0) {
+                return -1;
+            }
+            next_ppn = next_ppn + 1 == physical_pages ? 0 : next_ppn + 1;
+        }
+        l2p_reset_counters(map);
+    }
+
+    uint64_t start = now_ns();
+    for (uint64_t i = 0; i < count; i++) {
+        uint64_t lpn = ops[i] & ~OP_WRITE;
+        if (ops[i] & OP_WRITE) {
+            if (l2p_update(map, lpn, next_ppn) != 0) {
+                return -1;
+            }
+            next_ppn = next_ppn + 1 == physical_pages ? 0 : next_ppn + 1;
+        } else {
+            l2p_lookup(map, lpn);
+        }
+    }
+    elapsed_ns = now_ns() - start;
+    return 0;
+}
+
+void print_row(const l2p_map* map, l2p_mode mode, uint64_t count, double mapped_gb) {
+    l2p_stats stats;
+    l2p_get_stats(map, &stats);
+    char hit_rate[16] = "-";
+    char detail[128] = "";
+    if (mode == L2P_EXTENT) {
+        snprintf(detail, sizeof(detail), "%lu runs, %lu of %lu translation pages packed",
+                 stats.runs, stats.packed_chunks, stats.chunks);
+    } else if (mode == L2P_CACHED) {
+        uint64_t accesses = stats.hits + stats.misses;
+        snprintf(hit_rate, sizeof(hit_rate), "%.2f%%", accesses ? 100.0 * stats.hits / accesses : 0.0);
+        snprintf(detail, sizeof(detail), "%lu entries, %lu tpage reads, %lu tpage writes, %.2f MB on flash",
+                 stats.cache_entries, stats.tpage_reads, stats.tpage_writes, stats.flash_bytes / (1024.0 * 1024.0));
+    }
+    printf("%-8s %14lu %12.0f %9.1f %9s  %s\n", l2p_mode_name(mode), stats.ram_bytes,
+           stats.ram_bytes / mapped_gb, (double)elapsed_ns / count, hit_rate, detail);
+}
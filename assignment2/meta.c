@@ -0,0 +1,119 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+
+#include "meta.h"
+
+static int keys_equal(const char* a, const char* b) {
+    while (*a != '\0' && tolower((unsigned char)*a) == tolower((unsigned char)*b)) {
+        a++;
+        b++;
+    }
+    return *a == '\0' && *b == '\0';
+}
+
+int parse_meta_field(const char* key, const char* value, MetaData* meta) {
+    static const char* KEYS[] = { "bank", "block", "page", "page_size", "PROVISION_RATE" };
+    uint64_t* fields[] = { &meta->bank, &meta->block, &meta->page, &meta->page_size, &meta->provision_rate };
+
+    for (int i = 0; i < 5; i++) {
+        if (!keys_equal(key, KEYS[i])) {
+            continue;
+        }
+        while (isspace((unsigned char)*value)) {
+            value++;
+        }
+        char* end = NULL;
+        errno = 0;
+        unsigned long long parsed = strtoull(value, &end, 10);
+        if (end == value || errno != 0 || value[0] == '-') {
+            return -1;
+        }
+        while (isspace((unsigned char)*end)) {
+            end++;
+        }
+        if (*end != '\0') {
+            return -1;
+        }
+        *fields[i] = parsed;
+        return 1 << i;
+    }
+    return 0;
+}
+
+int parse_meta_line(char* line, MetaData* meta) {
+    while (isspace((unsigned char)*line)) {
+        line++;
+    }
+    char* eq = strchr(line, '=');
+    if (line[0] == '#' || eq == NULL) {
+        return 0;
+    }
+    char* key_end = eq;
+    while (key_end > line && isspace((unsigned char)key_end[-1])) {
+        key_end--;
+    }
+    *key_end = '\0';
+    return parse_meta_field(line, eq + 1, meta);
+}
+
+int parsing_meta(const char* filename, MetaData* meta) {
+    FILE* fp = fopen(filename, "r");
+    if (fp == NULL) {
+        return -1;
+    }
+
+    char line[256];
+    int fields_found = 0;
+
+    meta->bank = 0;
+    meta->block = 0;
+    meta->page = 0;
+    meta->page_size = 0;
+    meta->provision_rate = 0;
+
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        int field = parse_meta_line(line, meta);
+        if (field > 0) {
+            fields_found |= field;
+        }
+    }
+
+    fclose(fp);
+
+    if (fields_found != META_ALL_FIELDS) {
+        return -1;
+    }
+
+    return 0;
+}
+
+uint64_t calc_disk_capa(const MetaData* meta) {
+    // Total capacity = page_size * page * block * bank
+    return meta->page_size * meta->page * meta->block * meta->bank;
+}
+
+int calc_disk_capa_checked(const MetaData* meta, uint64_t* capacity) {
+    uint64_t blocks, pages;
+    if (__builtin_mul_overflow(meta->bank, meta->block, &blocks) ||
+        __builtin_mul_overflow(blocks, meta->page, &pages) ||
+        __builtin_mul_overflow(pages, meta->page_size, capacity)) {
+        return -1;
+    }
+    return 0;
+}
+
+uint64_t calc_sector(uint64_t disk_capacity) {
+    // Total sectors = disk_capacity / SECTOR_SIZE
+    return disk_capacity / SECTOR_SIZE;
+}
+
+uint64_t calc_practical_usage_sector(uint64_t total_sectors, uint64_t provision_rate) {
+    // (100 - rate) * total / 100, split so the product cannot overflow
+    uint64_t op_rate = provision_rate < 100 ? 100 - provision_rate : 0;
+    uint64_t op_sectors = total_sectors / 100 * op_rate + total_sectors % 100 * op_rate / 100;
+    return total_sectors - op_sectors;
+}
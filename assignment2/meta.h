@@ -0,0 +1,32 @@
+#ifndef META_H
+#define META_H
+
+#include <stdint.h>
+
+#define SECTOR_SIZE 512
+#define META_FILE "meta.ini"
+
+typedef struct {
+    uint64_t bank;
+    uint64_t block;
+    uint64_t page;
+    uint64_t page_size;
+    uint64_t provision_rate;
+} MetaData;
+
+#define META_ALL_FIELDS 0x1F
+
+// Parses one "key=value" pair, keys are case-insensitive. Returns the field's bit (1 << index in MetaData),
+// 0 for an unknown key and -1 for a malformed number.
+int parse_meta_field(const char* key, const char* value, MetaData* meta);
+// Same for a whole ini line, which is modified in place. Comments and lines without '=' return 0.
+int parse_meta_line(char* line, MetaData* meta);
+
+int parsing_meta(const char* filename, MetaData* meta);
+uint64_t calc_disk_capa(const MetaData* meta);
+// -1 when page_size * page * block * bank does not fit in 64 bits
+int calc_disk_capa_checked(const MetaData* meta, uint64_t* capacity);
+uint64_t calc_sector(uint64_t disk_capacity);
+uint64_t calc_practical_usage_sector(uint64_t total_sectors, uint64_t provision_rate);
+
+#endif
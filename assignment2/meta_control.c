@@ -2,31 +2,92 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <string.h>
+#include <ctype.h>
+#include <omp.h>
 
-#define SECTOR_SIZE 512
-#define META_FILE "meta.ini"
+#include "meta.h"
+#include "l2p_map.h"
+
+#define NAME_LEN 64
+#define LINE_LEN 1024
+#define CSV_MAX_COLUMNS 16
 
 typedef struct {
-    uint64_t bank;
-    uint64_t block;
-    uint64_t page;
-    uint64_t page_size;
-    uint64_t provision_rate;
-} MetaData;
-
-
-int parsing_meta(const char* filename, MetaData* meta);
-uint64_t calc_disk_capa(const MetaData* meta);
-uint64_t calc_sector(uint64_t disk_capacity);
-uint64_t calc_practical_usage_sector(uint64_t total_sectors, uint64_t provision_rate);
+    char name[NAME_LEN];
+    MetaData meta;
+    int fields;                 // bits from parse_meta_field, -1 after a malformed value
+} GeometryRecord;
+
+typedef struct {
+    const char* status;         // "ok", "invalid" (missing, zero or malformed field) or "overflow"
+    uint64_t capacity;
+    uint64_t total_sectors;
+    uint64_t op_sectors;
+    uint64_t practical_sectors;
+    uint64_t logical_pages;
+    unsigned ppn_bits;
+    uint64_t map_bytes;         // flat table packed to ppn_bits per entry
+} GeometryResult;
+
+typedef struct {
+    const char* input;
+    const char* output;
+    int json;
+} BatchConfig;
+
 void print_data(const MetaData* meta);
 void create_meta_file(const char* filename);
 void modify_meta_file(const char* filename);
 void show_menu();
-
-int main() {
+void print_usage(const char* prog);
+int run_batch(const BatchConfig* cfg);
+GeometryRecord* load_records(const char* filename, uint64_t* count);
+void evaluate_geometry(const GeometryRecord* record, GeometryResult* result);
+void write_csv(FILE* fp, const GeometryRecord* records, const GeometryResult* results, uint64_t count);
+void write_json(FILE* fp, const GeometryRecord* records, const GeometryResult* results, uint64_t count);
+
+int main(int argc, char* argv[]) {
     int choice;
 
+    // Any argument selects the scriptable batch mode, no argument keeps the menu
+    if (argc > 1) {
+        BatchConfig cfg = { .input = NULL, .output = NULL, .json = 0 };
+        for (int i = 1; i < argc; i++) {
+            const char* arg = argv[i];
+            const char* value = i + 1 < argc ? argv[i + 1] : NULL;
+            if (strcmp(arg, "--batch") == 0 && value != NULL) {
+                cfg.input = value;
+                i++;
+            } else if (strcmp(arg, "--output") == 0 && value != NULL) {
+                cfg.output = value;
+                i++;
+            } else if (strcmp(arg, "--format") == 0 && value != NULL) {
+                if (strcmp(value, "csv") != 0 && strcmp(value, "json") != 0) {
+                    printf("Invalid format '%s' (csv or json)\n", value);
+                    return 1;
+                }
+                cfg.json = strcmp(value, "json") == 0;
+                i++;
+            } else if (strcmp(arg, "--threads") == 0 && value != NULL) {
+                int threads = atoi(value);
+                if (threads <= 0) {
+                    printf("Invalid thread count '%s'\n", value);
+                    return 1;
+                }
+                omp_set_num_threads(threads);
+                i++;
+            } else {
+                print_usage(argv[0]);
+                return 1;
+            }
+        }
+        if (cfg.input == NULL) {
+            print_usage(argv[0]);
+            return 1;
+        }
+        return run_batch(&cfg);
+    }
+
     while (1) {
         show_menu();
 
@@ -70,61 +131,14 @@ void show_menu() {
     printf("Enter a option: ");
 }
 
-int parsing_meta(const char* filename, MetaData* meta) {
-    FILE* fp = fopen(filename, "r");
-    if (fp == NULL) {
-        return -1;
-    }
-
-    char line[256];
-    int fields_found = 0;
-
-    meta->bank = 0;
-    meta->block = 0;
-    meta->page = 0;
-    meta->page_size = 0;
-    meta->provision_rate = 0;
-
-    while (fgets(line, sizeof(line), fp) != NULL) {
-        if (line[0] == '#' || line[0] == '\n') {
-            continue;
-        }
-
-        if (sscanf(line, "bank=%lu", &meta->bank) == 1) {
-            fields_found++;
-        } else if (sscanf(line, "block=%lu", &meta->block) == 1) {
-            fields_found++;
-        } else if (sscanf(line, "page=%lu", &meta->page) == 1) {
-            fields_found++;
-        } else if (sscanf(line, "page_size=%lu", &meta->page_size) == 1) {
-            fields_found++;
-        } else if (sscanf(line, "PROVISION_RATE=%lu", &meta->provision_rate) == 1) {
-            fields_found++;
-        }
-    }
-
-    fclose(fp);
-
-    if (fields_found != 5) {
-        return -1;
-    }
-
-    return 0;
-}
-
-uint64_t calc_disk_capa(const MetaData* meta) {
-    // Total capacity = page_size * page * block * bank
-    return meta->page_size * meta->page * meta->block * meta->bank;
-}
-
-uint64_t calc_sector(uint64_t disk_capacity) {
-    // Total sectors = disk_capacity / SECTOR_SIZE
-    return disk_capacity / SECTOR_SIZE;
-}
-
-uint64_t calc_practical_usage_sector(uint64_t total_sectors, uint64_t provision_rate) {
-    uint64_t op_sectors = ((100 - provision_rate) * total_sectors) / 100;
-    return total_sectors - op_sectors;
+void print_usage(const char* prog) {
+    printf("Usage: %s                      Interactive menu on %s\n", prog, META_FILE);
+    printf("       %s --batch FILE [options]\n", prog);
+    printf("  --batch FILE       Geometry records: ini sections ([name] then key=value lines), a single\n");
+    printf("                     %s, or CSV with a header naming name,bank,block,page,page_size,PROVISION_RATE\n", META_FILE);
+    printf("  --format csv|json  Result format (default csv)\n");
+    printf("  --output FILE      Write results to FILE instead of stdout\n");
+    printf("  --threads N        Records evaluated in parallel (default: all CPUs)\n");
 }
 
 void print_data(const MetaData* meta) {
@@ -135,7 +149,11 @@ void print_data(const MetaData* meta) {
     printf("Page Size: %lu bytes\n", meta->page_size);
     printf("Provision Rate: %lu%%\n", meta->provision_rate);
 
-    uint64_t disk_capacity = calc_disk_capa(meta);
+    uint64_t disk_capacity;
+    if (calc_disk_capa_checked(meta, &disk_capacity) != 0) {
+        printf("\nTotal disk capacity does not fit in 64 bits\n");
+        return;
+    }
     uint64_t total_sectors = calc_sector(disk_capacity);
     uint64_t practical_sectors = calc_practical_usage_sector(total_sectors, meta->provision_rate);
 
@@ -240,3 +258,316 @@ void modify_meta_file(const char* filename) {
 
     printf("Meta file modified successfully!\n");
 }
+
+int run_batch(const BatchConfig* cfg) {
+    uint64_t count = 0;
+    GeometryRecord* records = load_records(cfg->input, &count);
+    if (records == NULL) {
+        return 1;
+    }
+    GeometryResult* results = malloc(count * sizeof(GeometryResult));
+    if (results == NULL) {
+        printf("Failed to allocate results for %lu records\n", count);
+        free(records);
+        return 1;
+    }
+
+    double start = omp_get_wtime();
+    #pragma omp parallel for schedule(static)
+    for (uint64_t i = 0; i < count; i++) {
+        evaluate_geometry(&records[i], &results[i]);
+    }
+    double elapsed = omp_get_wtime() - start;
+
+    FILE* fp = stdout;
+    if (cfg->output != NULL) {
+        fp = fopen(cfg->output, "w");
+        if (fp == NULL) {
+            printf("Failed to open %s\n", cfg->output);
+            free(results);
+            free(records);
+            return 1;
+        }
+    }
+    if (cfg->json) {
+        write_json(fp, records, results, count);
+    } else {
+        write_csv(fp, records, results, count);
+    }
+
+    uint64_t ok = 0;
+    for (uint64_t i = 0; i < count; i++) {
+        ok += strcmp(results[i].status, "ok") == 0;
+    }
+    int failed = 0;
+    if (fp != stdout) {
+        failed = fclose(fp) != 0;
+        printf("%lu geometries evaluated (%lu ok, %lu invalid or overflowing) in %.3f ms, written to %s\n",
+               count, ok, count - ok, elapsed * 1000.0, cfg->output);
+    }
+    free(results);
+    free(records);
+    return failed;
+}
+
+static char* trim(char* str) {
+    while (isspace((unsigned char)*str)) {
+        str++;
+    }
+    char* end = str + strlen(str);
+    while (end > str && isspace((unsigned char)end[-1])) {
+        end--;
+    }
+    *end = '\0';
+    return str;
+}
+
+static GeometryRecord* add_record(GeometryRecord** records, uint64_t* count, uint64_t* capacity) {
+    if (*count == *capacity) {
+        uint64_t grown_capacity = *capacity ? *capacity * 2 : 256;
+        GeometryRecord* grown = realloc(*records, grown_capacity * sizeof(GeometryRecord));
+        if (grown == NULL) {
+            return NULL;
+        }
+        *records = grown;
+        *capacity = grown_capacity;
+    }
+    GeometryRecord* record = &(*records)[(*count)++];
+    memset(record, 0, sizeof(*record));
+    return record;
+}
+
+// Cells are split by hand so that empty cells keep their column, which strtok would collapse
+static int split_csv(char* text, char** cells, int max_cells) {
+    int n = 0;
+    while (text != NULL) {
+        char* comma = strchr(text, ',');
+        if (comma != NULL) {
+            *comma = '\0';
+        }
+        if (n == max_cells) {
+            return -1;
+        }
+        cells[n++] = trim(text);
+        text = comma != NULL ? comma + 1 : NULL;
+    }
+    return n;
+}
+
+static void merge_field(GeometryRecord* record, int field) {
+    if (field < 0 || record->fields < 0) {
+        record->fields = -1;
+    } else {
+        record->fields |= field;
+    }
+}
+
+// The file is read once, line by line. The first meaningful line picks the format:
+// '[' starts ini sections, a ',' means CSV, anything else is a single meta.ini record.
+GeometryRecord* load_records(const char* filename, uint64_t* count) {
+    FILE* fp = fopen(filename, "r");
+    if (fp == NULL) {
+        printf("Failed to open %s\n", filename);
+        return NULL;
+    }
+
+    GeometryRecord* records = NULL;
+    GeometryRecord* current = NULL;
+    uint64_t capacity = 0;
+    uint64_t line_no = 0;
+    int csv = -1;
+    int columns = 0;
+    int name_column = -1;
+    char headers[CSV_MAX_COLUMNS][NAME_LEN];
+    char line[LINE_LEN];
+    *count = 0;
+
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        line_no++;
+        char* text = trim(line);
+        if (text[0] == '\0' || text[0] == '#' || text[0] == ';') {
+            continue;
+        }
+
+        if (csv < 0) {
+            csv = text[0] != '[' && strchr(text, ',') != NULL;
+            if (csv) {
+                // Header row: columns are matched by name, unknown ones are ignored
+                char* cells[CSV_MAX_COLUMNS];
+                columns = split_csv(text, cells, CSV_MAX_COLUMNS);
+                int seen = 0;
+                for (int c = 0; c < columns; c++) {
+                    snprintf(headers[c], NAME_LEN, "%s", cells[c]);
+                    if (strcmp(cells[c], "name") == 0) {
+                        name_column = c;
+                    } else {
+                        MetaData probe;
+                        int field = parse_meta_field(cells[c], "0", &probe);
+                        seen |= field > 0 ? field : 0;
+                    }
+                }
+                if (columns < 0 || seen != META_ALL_FIELDS) {
+                    printf("%s:%lu: CSV header needs bank, block, page, page_size and PROVISION_RATE columns"
+                           " (at most %d columns)\n", filename, line_no, CSV_MAX_COLUMNS);
+                    fclose(fp);
+                    free(records);
+                    return NULL;
+                }
+                continue;
+            }
+        }
+
+        if (csv) {
+            current = add_record(&records, count, &capacity);
+            if (current == NULL) {
+                break;
+            }
+            snprintf(current->name, NAME_LEN, "row %lu", line_no);
+            char* cells[CSV_MAX_COLUMNS];
+            int n = split_csv(text, cells, columns);
+            if (n != columns) {
+                current->fields = -1;
+            }
+            for (int c = 0; c < n; c++) {
+                if (c == name_column && cells[c][0] != '\0') {
+                    snprintf(current->name, NAME_LEN, "%s", cells[c]);
+                } else {
+                    merge_field(current, parse_meta_field(headers[c], cells[c], &current->meta));
+                }
+            }
+            continue;
+        }
+
+        char* close = strrchr(text, ']');
+        if (text[0] == '[' && close != NULL) {
+            *close = '\0';
+            current = add_record(&records, count, &capacity);
+            if (current == NULL) {
+                break;
+            }
+            snprintf(current->name, NAME_LEN, "%s", trim(text + 1));
+            continue;
+        }
+        if (current == NULL) {
+            current = add_record(&records, count, &capacity);
+            if (current == NULL) {
+                break;
+            }
+            snprintf(current->name, NAME_LEN, "%s", filename);
+        }
+        merge_field(current, parse_meta_line(text, &current->meta));
+    }
+    int complete = feof(fp);
+    fclose(fp);
+
+    if (!complete) {
+        printf("Failed to read all geometry records from %s\n", filename);
+        free(records);
+        return NULL;
+    }
+    if (*count == 0) {
+        printf("%s has no geometry records\n", filename);
+        free(records);
+        return NULL;
+    }
+    return records;
+}
+
+void evaluate_geometry(const GeometryRecord* record, GeometryResult* result) {
+    const MetaData* meta = &record->meta;
+    memset(result, 0, sizeof(*result));
+    result->status = "invalid";
+    if (record->fields != META_ALL_FIELDS || meta->bank == 0 || meta->block == 0 || meta->page == 0 ||
+        meta->page_size == 0 || meta->provision_rate == 0 || meta->provision_rate > 100) {
+        return;
+    }
+
+    result->status = "overflow";
+    if (calc_disk_capa_checked(meta, &result->capacity) != 0) {
+        return;
+    }
+    result->total_sectors = calc_sector(result->capacity);
+    result->practical_sectors = calc_practical_usage_sector(result->total_sectors, meta->provision_rate);
+    result->op_sectors = result->total_sectors - result->practical_sectors;
+
+    // Flat table sized like l2p_sim: one packed entry per exposed page
+    result->logical_pages = l2p_logical_pages(meta);
+    result->ppn_bits = l2p_ppn_bits(l2p_physical_pages(meta));
+    uint64_t map_bits;
+    if (__builtin_mul_overflow(result->logical_pages, (uint64_t)result->ppn_bits, &map_bits)) {
+        return;
+    }
+    result->map_bytes = map_bits / 8 + (map_bits % 8 != 0);
+    result->status = "ok";
+}
+
+static void write_csv_name(FILE* fp, const char* name) {
+    if (strpbrk(name, ",\"\n") == NULL) {
+        fputs(name, fp);
+        return;
+    }
+    fputc('"', fp);
+    for (const char* c = name; *c != '\0'; c++) {
+        if (*c == '"') {
+            fputc('"', fp);
+        }
+        fputc(*c, fp);
+    }
+    fputc('"', fp);
+}
+
+void write_csv(FILE* fp, const GeometryRecord* records, const GeometryResult* results, uint64_t count) {
+    fprintf(fp, "name,bank,block,page,page_size,provision_rate,status,capacity_bytes,total_sectors,"
+                "op_sectors,op_bytes,practical_sectors,practical_bytes,logical_pages,ppn_bits,map_bytes\n");
+    for (uint64_t i = 0; i < count; i++) {
+        const MetaData* meta = &records[i].meta;
+        const GeometryResult* r = &results[i];
+        write_csv_name(fp, records[i].name);
+        fprintf(fp, ",%lu,%lu,%lu,%lu,%lu,%s", meta->bank, meta->block, meta->page, meta->page_size,
+                meta->provision_rate, r->status);
+        if (strcmp(r->status, "ok") == 0) {
+            fprintf(fp, ",%lu,%lu,%lu,%lu,%lu,%lu,%lu,%u,%lu\n", r->capacity, r->total_sectors,
+                    r->op_sectors, r->op_sectors * SECTOR_SIZE, r->practical_sectors,
+                    r->practical_sectors * SECTOR_SIZE, r->logical_pages, r->ppn_bits, r->map_bytes);
+        } else {
+            fprintf(fp, ",,,,,,,,,\n");
+        }
+    }
+}
+
+static void write_json_name(FILE* fp, const char* name) {
+    fputc('"', fp);
+    for (const char* c = name; *c != '\0'; c++) {
+        if (*c == '"' || *c == '\\') {
+            fprintf(fp, "\\%c", *c);
+        } else if ((unsigned char)*c < 0x20) {
+            fprintf(fp, "\\u%04x", (unsigned char)*c);
+        } else {
+            fputc(*c, fp);
+        }
+    }
+    fputc('"', fp);
+}
+
+void write_json(FILE* fp, const GeometryRecord* records, const GeometryResult* results, uint64_t count) {
+    fprintf(fp, "[\n");
+    for (uint64_t i = 0; i < count; i++) {
+        const MetaData* meta = &records[i].meta;
+        const GeometryResult* r = &results[i];
+        fprintf(fp, "  {\"name\": ");
+        write_json_name(fp, records[i].name);
+        fprintf(fp, ", \"bank\": %lu, \"block\": %lu, \"page\": %lu, \"page_size\": %lu, \"provision_rate\": %lu, "
+                    "\"status\": \"%s\"", meta->bank, meta->block, meta->page, meta->page_size,
+                meta->provision_rate, r->status);
+        if (strcmp(r->status, "ok") == 0) {
+            fprintf(fp, ", \"capacity_bytes\": %lu, \"total_sectors\": %lu, \"op_sectors\": %lu, "
+                        "\"op_bytes\": %lu, \"practical_sectors\": %lu, \"practical_bytes\": %lu, "
+                        "\"logical_pages\": %lu, \"ppn_bits\": %u, \"map_bytes\": %lu",
+                    r->capacity, r->total_sectors, r->op_sectors, r->op_sectors * SECTOR_SIZE,
+                    r->practical_sectors, r->practical_sectors * SECTOR_SIZE, r->logical_pages,
+                    r->ppn_bits, r->map_bytes);
+        }
+        fprintf(fp, "}%s\n", i + 1 < count ? "," : "");
+    }
+    fprintf(fp, "]\n");
+}
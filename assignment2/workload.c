@@ -0,0 +1,162 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#include "workload.h"
+
+#define ZETA_EXACT_TERMS 1000000
+
+static uint64_t next_random(uint64_t* state) {
+    // splitmix64
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static double next_unit(uint64_t* state) {
+    return (next_random(state) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static uint64_t gcd(uint64_t a, uint64_t b) {
+    while (b != 0) {
+        uint64_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+// Sum of i^-theta for i = 1..n. Exact for the first terms, integral estimate for the tail
+// so that billion-page geometries do not need a billion pow() calls.
+static double zeta(uint64_t n, double theta) {
+    uint64_t exact = n < ZETA_EXACT_TERMS ? n : ZETA_EXACT_TERMS;
+    double sum = 0.0;
+    for (uint64_t i = 1; i <= exact; i++) {
+        sum += pow((double)i, -theta);
+    }
+    if (n > exact) {
+        sum += (pow(n + 0.5, 1.0 - theta) - pow(exact + 0.5, 1.0 - theta)) / (1.0 - theta);
+    }
+    return sum;
+}
+
+int workload_open(workload* wl, const char* spec, uint64_t pages, uint64_t page_size,
+                  uint64_t read_pct, uint64_t seed) {
+    memset(wl, 0, sizeof(*wl));
+    wl->pages = pages;
+    wl->page_size = page_size;
+    wl->read_permille = read_pct * 10;
+    wl->rng = seed;
+
+    if (strcmp(spec, "seq") == 0) {
+        wl->kind = WORKLOAD_SEQ;
+    } else if (strcmp(spec, "uniform") == 0) {
+        wl->kind = WORKLOAD_UNIFORM;
+    } else if (strncmp(spec, "zipf", 4) == 0 && (spec[4] == '\0' || spec[4] == ':')) {
+        wl->kind = WORKLOAD_ZIPF;
+        wl->theta = 0.99;
+        if (spec[4] == ':') {
+            char* end = NULL;
+            wl->theta = strtod(spec + 5, &end);
+            if (end == spec + 5 || *end != '\0' || wl->theta <= 0.0 || wl->theta >= 1.0) {
+                printf("Invalid zipf theta '%s' (must be between 0 and 1)\n", spec + 5);
+                return -1;
+            }
+        }
+        // YCSB zipfian generator
+        wl->zetan = zeta(pages, wl->theta);
+        wl->alpha = 1.0 / (1.0 - wl->theta);
+        wl->eta = (1.0 - pow(2.0 / pages, 1.0 - wl->theta)) / (1.0 - zeta(2, wl->theta) / wl->zetan);
+        // Hot ranks are spread over the space with a multiplier coprime to the page count
+        wl->scatter = 0x9E3779B97F4A7C15ULL % pages;
+        while (pages > 1 && (wl->scatter == 0 || gcd(wl->scatter, pages) != 1)) {
+            wl->scatter++;
+        }
+    } else {
+        wl->kind = WORKLOAD_TRACE;
+        wl->fp = fopen(spec, "r");
+        if (wl->fp == NULL) {
+            printf("Failed to open workload trace '%s'\n", spec);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static uint64_t zipf_rank(workload* wl) {
+    double u = next_unit(&wl->rng);
+    double uz = u * wl->zetan;
+    if (uz < 1.0) {
+        return 0;
+    }
+    if (uz < 1.0 + pow(0.5, wl->theta)) {
+        return 1;
+    }
+    uint64_t rank = (uint64_t)(wl->pages * pow(wl->eta * u - wl->eta + 1.0, wl->alpha));
+    return rank < wl->pages ? rank : wl->pages - 1;
+}
+
+static int next_trace_run(workload* wl) {
+    char line[256];
+    while (fgets(line, sizeof(line), wl->fp) != NULL) {
+        char op;
+        unsigned long long offset, length;
+        if (line[0] == '#' || sscanf(line, " %c %llu %llu", &op, &offset, &length) != 3 || length == 0) {
+            continue;
+        }
+        if (op != 'R' && op != 'r' && op != 'W' && op != 'w') {
+            continue;
+        }
+        uint64_t first = offset / wl->page_size;
+        uint64_t last = (offset + length - 1) / wl->page_size;
+        wl->run_lpn = first;
+        wl->run_left = last - first + 1;
+        wl->run_write = (op == 'W' || op == 'w');
+        return 1;
+    }
+    return 0;
+}
+
+int workload_next(workload* wl, uint64_t* lpn, int* is_write) {
+    if (wl->kind == WORKLOAD_TRACE) {
+        if (wl->run_left == 0 && !next_trace_run(wl)) {
+            return 0;
+        }
+        *lpn = wl->run_lpn++ % wl->pages;
+        *is_write = wl->run_write;
+        wl->run_left--;
+        return 1;
+    }
+
+    *is_write = next_random(&wl->rng) % 1000 >= wl->read_permille;
+    switch (wl->kind) {
+        case WORKLOAD_SEQ: {
+            uint64_t* cursor = *is_write ? &wl->cursor : &wl->read_cursor;
+            *lpn = *cursor;
+            *cursor = *cursor + 1 == wl->pages ? 0 : *cursor + 1;
+            break;
+        }
+        case WORKLOAD_UNIFORM:
+            *lpn = next_random(&wl->rng) % wl->pages;
+            break;
+        default:
+            *lpn = (uint64_t)(((__uint128_t)zipf_rank(wl) * wl->scatter) % wl->pages);
+            break;
+    }
+    return 1;
+}
+
+void workload_close(workload* wl) {
+    if (wl->fp != NULL) {
+        fclose(wl->fp);
+        wl->fp = NULL;
+    }
+}
+
+const char* workload_name(const workload* wl) {
+    static const char* NAMES[] = { "seq", "uniform", "zipf", "trace" };
+    return NAMES[wl->kind];
+}
@@ -0,0 +1,54 @@
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+// Logical page access streams shared by the FTL simulators.
+//   seq           sequential writes and sequential reads, wrapping at the end of the space
+//   uniform       uniformly random pages
+//   zipf[:THETA]  zipfian ranks (default theta 0.99) scattered over the space
+//   FILE          trace lines "R|W OFFSET LENGTH" in bytes, expanded to pages
+
+typedef enum {
+    WORKLOAD_SEQ = 0,
+    WORKLOAD_UNIFORM,
+    WORKLOAD_ZIPF,
+    WORKLOAD_TRACE,
+} workload_kind;
+
+typedef struct {
+    workload_kind kind;
+    uint64_t pages;
+    uint64_t page_size;
+    uint64_t read_permille;
+    uint64_t cursor;            // seq: next write, reads follow their own cursor
+    uint64_t read_cursor;
+    uint64_t rng;
+
+    // zipf
+    double theta;
+    double alpha;
+    double zetan;
+    double eta;
+    uint64_t scatter;
+
+    // trace
+    FILE* fp;
+    uint64_t run_lpn;
+    uint64_t run_left;
+    int run_write;
+} workload;
+
+// read_pct applies to synthetic workloads, traces carry their own direction
+int workload_open(workload* wl, const char* spec, uint64_t pages, uint64_t page_size,
+                  uint64_t read_pct, uint64_t seed);
+
+// 1 with the next page access, 0 at the end of a trace
+int workload_next(workload* wl, uint64_t* lpn, int* is_write);
+
+void workload_close(workload* wl);
+
+const char* workload_name(const workload* wl);
+
+#endif
@@ -0,0 +1,109 @@
+#include "fault_manifest.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char *FAULT_NAMES[FAULT_TYPE_COUNT] = {
+    "bitflip", "torn", "stale", "misdirect", "zero"
+};
+
+const char *fault_type_name(fault_type type) {
+    return type < FAULT_TYPE_COUNT ? FAULT_NAMES[type] : "unknown";
+}
+
+uint32_t fault_parse_types(const char *list) {
+    uint32_t mask = 0;
+    char buf[128];
+    strncpy(buf, list, sizeof(buf) - 1);
+    buf[sizeof(buf) - 1] = '\0';
+
+    for (char *tok = strtok(buf, ","); tok != NULL; tok = strtok(NULL, ",")) {
+        if (strcmp(tok, "all") == 0) {
+            mask |= (1u << FAULT_TYPE_COUNT) - 1;
+            continue;
+        }
+        int t = 0;
+        while (t < FAULT_TYPE_COUNT && strcmp(tok, FAULT_NAMES[t]) != 0) {
+            t++;
+        }
+        if (t == FAULT_TYPE_COUNT) {
+            return 0;
+        }
+        mask |= 1u << t;
+    }
+    return mask;
+}
+
+static int compare_records(const void *a, const void *b) {
+    const fault_record *ra = a, *rb = b;
+    return (ra->lba > rb->lba) - (ra->lba < rb->lba);
+}
+
+bool fault_manifest_save(const char *path, fault_manifest_header *header, fault_record *records) {
+    qsort(records, header->count, sizeof(fault_record), compare_records);
+    memcpy(header->magic, FAULT_MANIFEST_MAGIC, sizeof(header->magic));
+    header->version = FAULT_MANIFEST_VERSION;
+
+    FILE *fp = fopen(path, "wb");
+    if (fp == NULL) {
+        perror("Failed to open manifest");
+        return false;
+    }
+    bool ok = fwrite(header, sizeof(*header), 1, fp) == 1 &&
+              fwrite(records, sizeof(fault_record), header->count, fp) == header->count;
+    if (fclose(fp) != 0) {
+        ok = false;
+    }
+    if (!ok) {
+        perror("Failed to write manifest");
+    }
+    return ok;
+}
+
+bool fault_manifest_load(const char *path, fault_manifest *manifest) {
+    memset(manifest, 0, sizeof(*manifest));
+    FILE *fp = fopen(path, "rb");
+    if (fp == NULL) {
+        perror("Failed to open manifest");
+        return false;
+    }
+
+    bool ok = fread(&manifest->header, sizeof(manifest->header), 1, fp) == 1 &&
+              memcmp(manifest->header.magic, FAULT_MANIFEST_MAGIC, sizeof(manifest->header.magic)) == 0 &&
+              manifest->header.version == FAULT_MANIFEST_VERSION;
+    if (ok) {
+        uint64_t count = manifest->header.count;
+        manifest->records = malloc((count ? count : 1) * sizeof(fault_record));
+        manifest->detect_ns = calloc(count ? count : 1, sizeof(uint64_t));
+        ok = manifest->records != NULL && manifest->detect_ns != NULL &&
+             fread(manifest->records, sizeof(fault_record), count, fp) == count;
+    }
+    fclose(fp);
+
+    if (!ok) {
+        printf("Error: Manifest '%s' is invalid\n", path);
+        fault_manifest_free(manifest);
+    }
+    return ok;
+}
+
+void fault_manifest_free(fault_manifest *manifest) {
+    free(manifest->records);
+    free((void *)manifest->detect_ns);
+    manifest->records = NULL;
+    manifest->detect_ns = NULL;
+}
+
+int64_t fault_manifest_find(const fault_manifest *manifest, uint64_t lba) {
+    uint64_t lo = 0, hi = manifest->header.count;
+    while (lo < hi) {
+        uint64_t mid = lo + (hi - lo) / 2;
+        if (manifest->records[mid].lba < lba) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return (lo < manifest->header.count && manifest->records[lo].lba == lba) ? (int64_t)lo : -1;
+}
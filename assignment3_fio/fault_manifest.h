@@ -0,0 +1,58 @@
+#ifndef FAULT_MANIFEST_H
+#define FAULT_MANIFEST_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+// 주입한 corruption의 ground truth (--manifest FILE)
+// 파일 형식: fault_manifest_header + LBA 순으로 정렬된 fault_record 배열
+
+#define FAULT_MANIFEST_MAGIC   "FIOFAULT"
+#define FAULT_MANIFEST_VERSION 1
+
+typedef enum {
+    FAULT_BITFLIP = 0,   // payload 1bit 반전
+    FAULT_TORN,          // 섹터 뒤쪽 절반이 다른 generation 데이터
+    FAULT_STALE,         // 이전 generation으로 온전히 다시 쓰여진 섹터
+    FAULT_MISDIRECT,     // 같은 블록 내 다른 섹터와 내용이 바뀜
+    FAULT_ZERO,          // 섹터 전체 0
+    FAULT_TYPE_COUNT
+} fault_type;
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t type_mask;
+    uint64_t seed;
+    uint64_t count;
+    double rate;
+} fault_manifest_header;
+
+typedef struct {
+    uint64_t lba;
+    uint32_t type;
+    uint32_t detail;     // bitflip: bit 위치, misdirect: 상대 섹터의 블록 내 번호
+} fault_record;
+
+// read 시 검출 결과 (record와 같은 index)
+typedef struct {
+    fault_manifest_header header;
+    fault_record *records;
+    _Atomic uint64_t *detect_ns;   // 0 = 미검출, 아니면 검출 시각 (read 시작 기준 +1)
+} fault_manifest;
+
+const char *fault_type_name(fault_type type);
+
+// "bitflip,torn,..." -> bit mask, 실패 시 0
+uint32_t fault_parse_types(const char *list);
+
+// records는 LBA 기준으로 정렬하여 저장
+bool fault_manifest_save(const char *path, fault_manifest_header *header, fault_record *records);
+bool fault_manifest_load(const char *path, fault_manifest *manifest);
+void fault_manifest_free(fault_manifest *manifest);
+
+// LBA의 record index, 없으면 -1
+int64_t fault_manifest_find(const fault_manifest *manifest, uint64_t lba);
+
+#endif
@@ -0,0 +1,291 @@
+#include "fingerprint.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define XXH_P1 11400714785074694791ULL
+#define XXH_P2 14029467366897019727ULL
+#define XXH_P3 1609587929392839161ULL
+#define XXH_P4 9650029242287828579ULL
+#define XXH_P5 2870177450012600261ULL
+
+static inline uint64_t rotl64(uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+static inline uint64_t read64(const unsigned char *p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline uint32_t read32(const unsigned char *p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline uint64_t xxh_round(uint64_t acc, uint64_t input) {
+    acc += input * XXH_P2;
+    acc = rotl64(acc, 31);
+    return acc * XXH_P1;
+}
+
+static inline uint64_t xxh_merge(uint64_t acc, uint64_t val) {
+    acc ^= xxh_round(0, val);
+    return acc * XXH_P1 + XXH_P4;
+}
+
+uint64_t fp_hash64(const void *data, size_t length, uint64_t seed) {
+    const unsigned char *p = data;
+    const unsigned char *end = p + length;
+    uint64_t h;
+
+    if (length >= 32) {
+        uint64_t v1 = seed + XXH_P1 + XXH_P2;
+        uint64_t v2 = seed + XXH_P2;
+        uint64_t v3 = seed;
+        uint64_t v4 = seed - XXH_P1;
+        // 32byte stripe 4개 lane
+        for (; p + 32 <= end; p += 32) {
+            v1 = xxh_round(v1, read64(p));
+            v2 = xxh_round(v2, read64(p + 8));
+            v3 = xxh_round(v3, read64(p + 16));
+            v4 = xxh_round(v4, read64(p + 24));
+        }
+        h = rotl64(v1, 1) + rotl64(v2, 7) + rotl64(v3, 12) + rotl64(v4, 18);
+        h = xxh_merge(h, v1);
+        h = xxh_merge(h, v2);
+        h = xxh_merge(h, v3);
+        h = xxh_merge(h, v4);
+    } else {
+        h = seed + XXH_P5;
+    }
+
+    h += (uint64_t)length;
+    for (; p + 8 <= end; p += 8) {
+        h ^= xxh_round(0, read64(p));
+        h = rotl64(h, 27) * XXH_P1 + XXH_P4;
+    }
+    if (p + 4 <= end) {
+        h ^= (uint64_t)read32(p) * XXH_P1;
+        h = rotl64(h, 23) * XXH_P2 + XXH_P3;
+        p += 4;
+    }
+    for (; p < end; p++) {
+        h ^= (*p) * XXH_P5;
+        h = rotl64(h, 11) * XXH_P1;
+    }
+
+    h ^= h >> 33;
+    h *= XXH_P2;
+    h ^= h >> 29;
+    h *= XXH_P3;
+    h ^= h >> 32;
+    return h;
+}
+
+// level별 node 수/위치 계산
+static bool fp_layout(fingerprint *fp) {
+    uint64_t count = fp->header.leaf_count;
+    uint64_t offset = 0;
+    uint32_t level = 0;
+    while (1) {
+        if (level == FP_MAX_LEVELS) {
+            return false;
+        }
+        fp->level_offset[level] = offset;
+        fp->level_count[level] = count;
+        offset += count;
+        level++;
+        if (count == 1) {
+            break;
+        }
+        count = (count + 1) / 2;
+    }
+    fp->header.levels = level;
+    fp->header.node_count = offset;
+    return true;
+}
+
+static uint64_t fp_failed_words(const fingerprint *fp) {
+    return (fp->header.leaf_count + 63) / 64;
+}
+
+bool fp_init(fingerprint *fp, uint64_t device_size, uint64_t leaf_size) {
+    memset(fp, 0, sizeof(*fp));
+    memcpy(fp->header.magic, FP_MAGIC, sizeof(fp->header.magic));
+    fp->header.version = FP_VERSION;
+    fp->header.device_size = device_size;
+    fp->header.leaf_size = leaf_size;
+    fp->header.leaf_count = (device_size + leaf_size - 1) / leaf_size;
+    if (fp->header.leaf_count == 0 || !fp_layout(fp)) {
+        return false;
+    }
+    fp->nodes = calloc(fp->header.node_count, sizeof(uint64_t));
+    fp->failed = calloc(fp_failed_words(fp), sizeof(uint64_t));
+    if (fp->nodes == NULL || fp->failed == NULL) {
+        fp_free(fp);
+        return false;
+    }
+    return true;
+}
+
+void fp_free(fingerprint *fp) {
+    free(fp->nodes);
+    free(fp->failed);
+    fp->nodes = NULL;
+    fp->failed = NULL;
+}
+
+uint64_t fp_failed_count(const fingerprint *fp) {
+    uint64_t count = 0;
+    for (uint64_t w = 0; w < fp_failed_words(fp); w++) {
+        count += (uint64_t)__builtin_popcountll(fp->failed[w]);
+    }
+    return count;
+}
+
+void fp_build(fingerprint *fp) {
+    for (uint32_t level = 1; level < fp->header.levels; level++) {
+        const uint64_t *child = fp->nodes + fp->level_offset[level - 1];
+        uint64_t child_count = fp->level_count[level - 1];
+        uint64_t *parent = fp->nodes + fp->level_offset[level];
+        uint64_t count = fp->level_count[level];
+
+        #pragma omp parallel for schedule(static) if (count > 4096)
+        for (uint64_t i = 0; i < count; i++) {
+            // 마지막 홀수 자식은 혼자 hash
+            size_t n = 2 * i + 1 < child_count ? 2 : 1;
+            parent[i] = fp_hash64(child + 2 * i, n * sizeof(uint64_t), level);
+        }
+    }
+    fp->header.root = fp->nodes[fp->header.node_count - 1];
+}
+
+bool fp_save(const char *path, const fingerprint *fp) {
+    FILE *out = fopen(path, "wb");
+    if (out == NULL) {
+        perror("Failed to open fingerprint file");
+        return false;
+    }
+    bool ok = fwrite(&fp->header, sizeof(fp->header), 1, out) == 1 &&
+              fwrite(fp->nodes, sizeof(uint64_t), fp->header.node_count, out) == fp->header.node_count &&
+              fwrite(fp->failed, sizeof(uint64_t), fp_failed_words(fp), out) == fp_failed_words(fp);
+    if (fclose(out) != 0) {
+        ok = false;
+    }
+    if (!ok) {
+        perror("Failed to write fingerprint file");
+    }
+    return ok;
+}
+
+bool fp_load(const char *path, fingerprint *fp) {
+    memset(fp, 0, sizeof(*fp));
+    FILE *in = fopen(path, "rb");
+    if (in == NULL) {
+        perror(path);
+        return false;
+    }
+
+    fp_header header;
+    bool ok = fread(&header, sizeof(header), 1, in) == 1 &&
+              memcmp(header.magic, FP_MAGIC, sizeof(header.magic)) == 0 &&
+              (header.version == 1 || header.version == FP_VERSION);
+    if (ok) {
+        fp->header = header;
+        // layout을 다시 계산하여 파일 header와 일치하는지 확인
+        ok = fp_layout(fp) && fp->header.levels == header.levels && fp->header.node_count == header.node_count;
+    }
+    if (ok) {
+        fp->nodes = malloc(header.node_count * sizeof(uint64_t));
+        ok = fp->nodes != NULL && fread(fp->nodes, sizeof(uint64_t), header.node_count, in) == header.node_count;
+    }
+    if (ok) {
+        // version 1 파일은 failure bitmap이 없음 (모든 leaf를 읽은 것으로 취급)
+        uint64_t words = fp_failed_words(fp);
+        fp->failed = calloc(words, sizeof(uint64_t));
+        ok = fp->failed != NULL &&
+             (header.version == 1 || fread(fp->failed, sizeof(uint64_t), words, in) == words);
+    }
+    fclose(in);
+
+    if (!ok) {
+        printf("Error: '%s' is not a valid fingerprint file\n", path);
+        fp_free(fp);
+    }
+    return ok;
+}
+
+typedef struct {
+    const fingerprint *a;
+    const fingerprint *b;
+    fp_diff_callback callback;
+    void *arg;
+    uint64_t run_first;      // 이어지는 차이 구간
+    uint64_t run_last;
+    bool in_run;
+    int64_t differing;
+} fp_diff_state;
+
+static void diff_emit(fp_diff_state *st, uint64_t leaf) {
+    st->differing++;
+    if (st->in_run && leaf == st->run_last + 1) {
+        st->run_last = leaf;
+        return;
+    }
+    if (st->in_run && st->callback != NULL) {
+        st->callback(st->run_first, st->run_last, st->arg);
+    }
+    st->run_first = st->run_last = leaf;
+    st->in_run = true;
+}
+
+// hash가 같은 subtree의 leaf [first, end) 중 어느 한쪽에서 읽지 못한 leaf를 차이로 기록
+static void diff_failed(fp_diff_state *st, uint64_t first, uint64_t end) {
+    if (end > st->a->header.leaf_count) {
+        end = st->a->header.leaf_count;
+    }
+    for (uint64_t leaf = first; leaf < end; leaf++) {
+        uint64_t word = (st->a->failed[leaf / 64] | st->b->failed[leaf / 64]) >> (leaf % 64);
+        if (word == 0) {
+            leaf = (leaf / 64 + 1) * 64 - 1;
+            continue;
+        }
+        leaf += (uint64_t)__builtin_ctzll(word);
+        if (leaf < end) {
+            diff_emit(st, leaf);
+        }
+    }
+}
+
+// 다른 node의 subtree만 왼쪽부터 내려가므로 leaf는 오름차순으로 방문됨
+static void diff_node(fp_diff_state *st, uint32_t level, uint64_t index) {
+    uint64_t ia = st->a->level_offset[level] + index;
+    if (st->a->nodes[ia] == st->b->nodes[ia]) {
+        diff_failed(st, index << level, (index + 1) << level);
+        return;
+    }
+    if (level == 0) {
+        diff_emit(st, index);
+        return;
+    }
+    diff_node(st, level - 1, 2 * index);
+    if (2 * index + 1 < st->a->level_count[level - 1]) {
+        diff_node(st, level - 1, 2 * index + 1);
+    }
+}
+
+int64_t fp_diff(const fingerprint *a, const fingerprint *b, fp_diff_callback callback, void *arg) {
+    if (a->header.device_size != b->header.device_size || a->header.leaf_size != b->header.leaf_size) {
+        return -1;
+    }
+    fp_diff_state st = { .a = a, .b = b, .callback = callback, .arg = arg };
+    diff_node(&st, a->header.levels - 1, 0);
+    if (st.in_run && callback != NULL) {
+        callback(st.run_first, st.run_last, arg);
+    }
+    return st.differing;
+}
@@ -0,0 +1,68 @@
+#ifndef FINGERPRINT_H
+#define FINGERPRINT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// device 전체 Merkle fingerprint (--fingerprint FILE)
+// leaf = leaf_size byte 영역의 64bit hash, 상위 node = 두 자식 hash의 hash
+// 파일에 전체 tree를 저장하므로 두 파일 비교 시 다른 subtree만 내려가면 됨 (O(차이 * 높이))
+// 파일 형식: fp_header + level 0(leaf)부터 root까지 node hash 배열
+//           + 읽지 못한 leaf bitmap (version 2, leaf당 1bit, uint64 단위)
+// 읽지 못한 leaf는 hash가 의미 없으므로 비교 시 양쪽 hash와 무관하게 차이로 봄
+
+#define FP_MAGIC      "FIOFPRNT"
+#define FP_VERSION    2
+#define FP_MAX_LEVELS 64
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t levels;
+    uint64_t device_size;
+    uint64_t leaf_size;
+    uint64_t leaf_count;
+    uint64_t node_count;
+    uint64_t root;
+} fp_header;
+
+typedef struct {
+    fp_header header;
+    uint64_t *nodes;
+    uint64_t *failed;              // 읽지 못한 leaf bitmap
+    uint64_t level_offset[FP_MAX_LEVELS];
+    uint64_t level_count[FP_MAX_LEVELS];
+} fingerprint;
+
+// 64bit 비암호 hash (XXH64)
+uint64_t fp_hash64(const void *data, size_t length, uint64_t seed);
+
+bool fp_init(fingerprint *fp, uint64_t device_size, uint64_t leaf_size);
+void fp_free(fingerprint *fp);
+
+static inline void fp_set_leaf(fingerprint *fp, uint64_t leaf, uint64_t hash) {
+    fp->nodes[leaf] = hash;
+}
+
+// 여러 thread에서 동시 호출 가능 (같은 word를 공유하므로 atomic OR)
+static inline void fp_set_failed(fingerprint *fp, uint64_t leaf) {
+    fp->nodes[leaf] = 0;
+    __atomic_fetch_or(&fp->failed[leaf / 64], 1ULL << (leaf % 64), __ATOMIC_RELAXED);
+}
+
+uint64_t fp_failed_count(const fingerprint *fp);
+
+// leaf가 모두 채워진 뒤 상위 level을 병렬로 계산하고 root 설정
+void fp_build(fingerprint *fp);
+
+bool fp_save(const char *path, const fingerprint *fp);
+bool fp_load(const char *path, fingerprint *fp);
+
+// 두 fingerprint를 비교하여 다른 leaf 구간 [first, last]마다 callback, 다른 leaf 수 반환
+// 어느 한쪽에서 읽지 못한 leaf도 다른 leaf로 셈
+// device 크기 또는 leaf 크기가 다르면 -1
+typedef void (*fp_diff_callback)(uint64_t first_leaf, uint64_t last_leaf, void *arg);
+int64_t fp_diff(const fingerprint *a, const fingerprint *b, fp_diff_callback callback, void *arg);
+
+#endif
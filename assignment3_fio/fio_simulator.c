@@ -14,63 +14,334 @@
 #include <unistd.h>
 #include <errno.h>
 #include <threads.h>
-#include <smmintrin.h>
 #include <stdatomic.h>
 #include <pthread.h>
+#include <sys/resource.h>
+#include <linux/falloc.h>
+#include <omp.h>
+
+#include "payload.h"
+#include "shm_stats.h"
+#include "io_trace.h"
+#include "tsc.h"
+#include "jobfile.h"
+#include "phase_stats.h"
+#include "perf_counters.h"
+#include "replay_trace.h"
+#include "trim_map.h"
+#include "fault_manifest.h"
+#include "io_backend.h"
+#include "fingerprint.h"
+#include "fioverify.h"
+#include "write_journal.h"
+#include "forensics.h"
+#include "ssd_backend.h"
 
 #define SECTOR_SIZE 512LLU
 #define MONITOR_INTERVAL 10.0  // 2초 interval
-#define IO_BLOCK_SIZE (131072LLU)  // 4KB, 12KB(12288), 32KB(32768), 128KB(131072), 256KB(262144) 중 선택 가능
+#define DEFAULT_IO_BLOCK_SIZE (131072LLU)  // 4KB, 12KB(12288), 32KB(32768), 128KB(131072), 256KB(262144) 중 선택 가능
 #define ALIGNMENT 4096
 #define SECTORS_PER_BLOCK (IO_BLOCK_SIZE / SECTOR_SIZE)
 #define CHUNK 1000
 
+// 기본 I/O 단위, --geometry가 있으면 page_size x bank의 배수로 결정
+uint64_t IO_BLOCK_SIZE = DEFAULT_IO_BLOCK_SIZE;
+
+// NAND geometry (--geometry META.INI), 로드된 경우에만 page_size != 0
+// LBA는 page 단위로 bank에 round-robin 배치된다고 가정 (bank = page 번호 % bank 수)
+nand_geometry GEOMETRY = {0};
+
 // device 정보를 읽고 업데이트
 uint64_t NUM_SECTOR = 0;
 uint64_t NUM_BLOCKS = 0; 
 uint64_t PROGRESS_PERCENT = 0;
 uint64_t TOTAL_SIZE = 0;
 
-// verify_header 구조체
-#define VERIFY_MAGIC 0xDEADBEEF
-typedef struct {
-    uint32_t magic;        // Magic number for validation
-    uint64_t lba;          // Logical Block Address
-    uint64_t timestamp;    // 시간
-    uint32_t checksum;     // CRC32 체크섬
-    uint64_t offset;       // 메모리 오프셋
-} verify_header;
-
 // 모니터링 스레드용 구조체
 typedef struct {
     atomic_uint_fast64_t *completed_bytes;  // 완료된 바이트 수
     atomic_bool *stop_flag;                 // 종료 플래그
     const char *operation_name;             // 작업 이름 (WRITE/READ)
+    uint64_t total_bytes;                   // 진행률 기준 (0이면 진행률 생략)
 } monitor_context;
 
-// 디바이스 파일 디스크립터
-int device_fd = -1;
+// 검증 대상 (libfioverify), device_size는 target에서 가져옴
+// 데이터 I/O는 모두 target의 backend(BACKEND)를 거치고, fd는 discard/cache drop에만 fv_fd()로 사용
+fv_target *TARGET = NULL;
+
 const char* device_path = "/dev/sdb";  // 블록 디바이스 경로
 uint64_t device_size = 0; 
+bool DEVICE_IS_FILE = false;           // 일반 파일 대상이면 discard 대신 fallocate 사용
+
+// payload 검증 모드 (--payload crc|seed)
+payload_mode PAYLOAD_MODE = PAYLOAD_CRC;
+uint64_t PAYLOAD_SEED_VALUE = 0;
+uint64_t PAYLOAD_GENERATION = 0;
+
+// 압축률/dedupe 목표 (--compress, --dedupe)
+double COMPRESS_RATIO = 1.0;
+double DEDUPE_RATIO = 0.0;
+size_t PAYLOAD_RANDOM_LEN = SECTOR_SIZE - sizeof(verify_header);  // header 있는 섹터의 random byte 수
+size_t DEDUPE_RANDOM_LEN = SECTOR_SIZE;                            // header 없는 dedupe 섹터의 random byte 수
+
+// /dev/shm 실시간 통계 (--shm NAME), NULL이면 비활성
+shm_stats_segment *SHM_STATS = NULL;
+const char *SHM_NAME = NULL;
+
+// outlier I/O trace (--trace FILE)
+const char *TRACE_PATH = NULL;
+uint64_t TRACE_THRESHOLD_US = 10000;
+uint32_t TRACE_WINDOW = 32;
+
+// phase별 CPU 시간 집계 (--cpu-stats)
+bool CPU_STATS = false;
+uint64_t BYTES_PROCESSED = 0;   // 실행 전체에서 처리한 byte 수
+
+// generate/verify 구간 perf_event 카운터 (--perf-counters)
+bool PERF_COUNTERS = false;
+
+// discard 영역 기록 (--trim-map FILE), 로드된 경우에만 bits != NULL
+const char *TRIM_MAP_PATH = NULL;
+trim_map TRIM_MAP = {0};
+
+// write extent 기록 (--journal FILE), write 하는 실행에서만 열림
+const char *JOURNAL_PATH = NULL;
+write_journal *JOURNAL = NULL;
+
+// 에러 섹터 원인 분석 (--forensics), scan 중에는 에러 섹터만 기록
+bool FORENSICS = false;
+forensic_log FORENSIC_LOG;
+
+// NAND SSD emulator (--ssd META.INI), fault backend가 있으면 그 안쪽 계층
+const char *SSD_GEOMETRY_PATH = NULL;
+const char *SSD_STATE_PATH = NULL;
+io_backend *SSD_BACKEND = NULL;
+
+// read 검증 시 magic 없는 섹터 분류
+atomic_uint_fast64_t UNWRITTEN_SECTORS = 0;   // write된 적 없음 (trim 기록 없음)
+atomic_uint_fast64_t TRIMMED_SECTORS = 0;     // trim 기록이 있고 0 또는 균일 패턴
+
+// durability (--dsync, --flush-every, --flush-interval-ms, --verify-after-flush)
+bool WRITE_DSYNC = false;              // pwritev2(RWF_DSYNC): 장치가 지원하면 FUA write
+uint64_t FLUSH_EVERY = 0;              // 전체 write N개마다 fdatasync
+uint64_t FLUSH_INTERVAL_MS = 0;        // timer thread가 주기적으로 fdatasync
+bool VERIFY_AFTER_FLUSH = false;
+
+// flush epoch: write 완료 시 현재 epoch를 블록에 기록, flush 시작 시 epoch 증가
+// flush e가 끝나면 epoch <= e 인 블록은 모두 flush 이전에 완료된 write
+atomic_uint_fast64_t FLUSH_EPOCH = 1;
+atomic_uint_fast64_t DURABLE_EPOCH = 0;
+atomic_uint_fast64_t TOTAL_WRITES = 0;
+atomic_uint_fast64_t UNTRACKED_WRITES = 0;   // IO_BLOCK_SIZE 블록과 맞지 않아 추적하지 않은 write
+_Atomic uint64_t *BLOCK_EPOCH = NULL;        // IO_BLOCK_SIZE 블록별 마지막 write epoch (0 = 없음)
+
+// flush latency 통계
+atomic_uint_fast64_t FLUSH_COUNT = 0;
+atomic_uint_fast64_t FLUSH_FAILURES = 0;
+atomic_uint_fast64_t FLUSH_LAT_BUCKETS[SHM_STATS_LAT_BUCKETS];
+atomic_uint_fast64_t FLUSH_LAT_MAX_NS = 0;
+
+// 병렬 corruption 주입 (--corrupt-rate, --corrupt-types) 및 검출 평가 (--manifest)
+double CORRUPT_RATE = 0.0;
+uint32_t CORRUPT_TYPES = (1u << FAULT_TYPE_COUNT) - 1;
+const char *MANIFEST_PATH = NULL;
+fault_manifest MANIFEST = {0};                // read 시 로드되면 records != NULL
+uint64_t DETECT_START_NS = 0;
+atomic_uint_fast64_t FALSE_POSITIVES = 0;
+
+// worker I/O 경로 (--engine, --fault-* 지정 시 fault 주입 wrapper)
+io_backend *BACKEND = NULL;
+const char *IO_ENGINE = "direct";
+
+// 실패한 I/O 재시도 (--retry, --retry-backoff-us)
+uint64_t IO_RETRIES = 0;
+uint64_t RETRY_BACKOFF_US = 100;
+atomic_uint_fast64_t RETRY_ATTEMPTS = 0;
+atomic_uint_fast64_t RETRY_RECOVERED = 0;
+atomic_uint_fast64_t RETRY_EXHAUSTED = 0;
+
+// sequential scan의 전송 크기와 검증 단위 (--xfer-size, --verify-unit)
+// 전송 한 번에 여러 블록을 읽고 검증은 verify unit 단위로 나누어 수행
+// 0이면 IO_BLOCK_SIZE (인자 파싱 후 결정)
+uint64_t XFER_SIZE = 0;
+uint64_t VERIFY_UNIT = 0;
+
+// pread/pwrite 시간 측정 여부 (shm 통계, trace, cpu 통계 활성 시)
+bool IO_TIMING = false;
+
+// 직전 pread/pwrite의 latency
+static thread_local uint64_t io_latency_ns = 0;
+
+// job thread의 worker 번호 (-1이면 OpenMP thread 번호 사용)
+static thread_local int WORKER_ID = -1;
+
+static inline int worker_index(void) {
+    return WORKER_ID >= 0 ? WORKER_ID : omp_get_thread_num();
+}
+
+// syscall 시작 시점의 thread CPU 시간 (--cpu-stats)
+static thread_local uint64_t io_cpu_start = 0;
+
+static inline uint64_t io_timing_begin(void) {
+    if (CPU_STATS) {
+        io_cpu_start = thread_cpu_ns();
+    }
+    return IO_TIMING ? tsc_now() : 0;
+}
+
+static inline void io_timing_end(io_trace_op op, uint64_t start_lba, size_t length, uint64_t submit_tsc, bool failed) {
+    if (!IO_TIMING) {
+        return;
+    }
+    uint64_t complete_tsc = tsc_now();
+    io_latency_ns = tsc_to_ns(complete_tsc - submit_tsc);
+    io_trace_record(worker_index(), op, start_lba, (uint32_t)length, submit_tsc, complete_tsc, failed);
+
+    // syscall wall 시간을 CPU 소비(submit)와 device 대기(wait)로 분리
+    if (CPU_STATS) {
+        uint64_t cpu_ns = thread_cpu_ns() - io_cpu_start;
+        if (cpu_ns > io_latency_ns) {
+            cpu_ns = io_latency_ns;
+        }
+        phase_stats_add(worker_index(), PHASE_SUBMIT, cpu_ns);
+        phase_stats_add(worker_index(), PHASE_WAIT, io_latency_ns - cpu_ns);
+    }
+}
+
+// generate/verify 구간 측정
+static inline uint64_t phase_begin(void) {
+    if (PERF_COUNTERS) {
+        perf_scope_begin(worker_index());
+    }
+    return CPU_STATS ? tsc_now() : 0;
+}
+
+static inline void phase_end(io_phase phase, uint64_t start_tsc, size_t bytes) {
+    if (CPU_STATS) {
+        phase_stats_add(worker_index(), phase, tsc_to_ns(tsc_now() - start_tsc));
+    }
+    if (PERF_COUNTERS) {
+        perf_scope_end(worker_index(), phase == PHASE_GENERATE ? PERF_SCOPE_GENERATE : PERF_SCOPE_VERIFY, bytes);
+    }
+}
+
+// 블록 하나의 결과를 자기 thread slot에 반영 (result: 에러 섹터 수, 음수면 I/O 실패)
+static inline void record_block_stats(size_t bytes, int result) {
+    if (SHM_STATS != NULL) {
+        shm_stats_record(SHM_STATS, worker_index(), bytes, io_latency_ns,
+                         result > 0 ? (uint64_t)result : 0, result < 0);
+    }
+}
+
+// 직전 호출 이후 phase 시간 변화량 출력 (last는 갱신됨)
+static void print_phase_interval(const char *label, uint64_t last[PHASE_COUNT], uint64_t bytes) {
+    uint64_t now[PHASE_COUNT], delta[PHASE_COUNT];
+    phase_stats_totals(now);
+    for (int p = 0; p < PHASE_COUNT; p++) {
+        delta[p] = now[p] - last[p];
+        last[p] = now[p];
+    }
+    phase_stats_print(label, delta, bytes);
+}
+
+static uint64_t monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// 여러 thread가 갱신하는 최대값
+static void atomic_update_max(atomic_uint_fast64_t *max, uint64_t value) {
+    uint64_t cur = atomic_load(max);
+    while (value > cur && !atomic_compare_exchange_weak(max, &cur, value)) {
+    }
+}
+
+// log2 us bucket 분포에서 백분위 latency (bucket 상한, us)
+static uint64_t latency_percentile_us(const uint64_t buckets[SHM_STATS_LAT_BUCKETS], uint64_t total, double pct) {
+    if (total == 0) {
+        return 0;
+    }
+    uint64_t target = (uint64_t)(total * pct / 100.0);
+    uint64_t acc = 0;
+    for (int b = 0; b < SHM_STATS_LAT_BUCKETS; b++) {
+        acc += buckets[b];
+        if (acc > target) {
+            return 1ULL << b;
+        }
+    }
+    return 1ULL << (SHM_STATS_LAT_BUCKETS - 1);
+}
+
+// 분포에 실제로 기록된 I/O 수 (실패/short I/O는 bucket에 들어가지 않음)
+static uint64_t latency_bucket_total(const uint64_t buckets[SHM_STATS_LAT_BUCKETS]) {
+    uint64_t total = 0;
+    for (int b = 0; b < SHM_STATS_LAT_BUCKETS; b++) {
+        total += buckets[b];
+    }
+    return total;
+}
+
+// latency histogram 출력 (비어 있지 않은 bucket만)
+static void print_latency_histogram(const char *label, const uint64_t buckets[SHM_STATS_LAT_BUCKETS], uint64_t max_ns) {
+    uint64_t total = latency_bucket_total(buckets);
+    printf("  %s latency: p50 <%luus, p99 <%luus, max %.1fus (%lu ops)\n", label,
+           latency_percentile_us(buckets, total, 50.0), latency_percentile_us(buckets, total, 99.0),
+           max_ns / 1e3, total);
+    for (int b = 0; b < SHM_STATS_LAT_BUCKETS; b++) {
+        if (buckets[b]) {
+            printf("    < %10luus: %10lu (%5.1f%%)\n", (uint64_t)1 << b, buckets[b], 100.0 * buckets[b] / total);
+        }
+    }
+}
 
-// CRC32 checksum 계산 함수
-uint32_t crc32_checksum(const void *data, size_t length) {
-    uint32_t crc = 0xFFFFFFFF;
-    const uint64_t *buf = (const uint64_t*)data;
+// device write cache flush, latency 기록
+static void flush_device(void) {
+    uint64_t epoch = atomic_fetch_add(&FLUSH_EPOCH, 1);
+    uint64_t start = monotonic_ns();
+    int ret = io_backend_flush(BACKEND);
+    uint64_t latency = monotonic_ns() - start;
+
+    if (ret != 0) {
+        perror("flush");
+        atomic_fetch_add(&FLUSH_FAILURES, 1);
+        return;
+    }
+    atomic_fetch_add(&FLUSH_COUNT, 1);
+    atomic_fetch_add(&FLUSH_LAT_BUCKETS[shm_stats_latency_bucket(latency)], 1);
+    atomic_update_max(&FLUSH_LAT_MAX_NS, latency);
+    atomic_update_max(&DURABLE_EPOCH, epoch);
+}
 
-    size_t i = 0;
-    for(; i < length/8; i++)
-    {
-        crc = _mm_crc32_u64(crc, buf[i]);
+// write 완료 후: flush epoch 기록 및 N개마다 flush
+static void durability_after_write(uint64_t start_lba, size_t block_size) {
+    if (BLOCK_EPOCH != NULL) {
+        if (start_lba % SECTORS_PER_BLOCK == 0 && block_size == IO_BLOCK_SIZE) {
+            atomic_store_explicit(&BLOCK_EPOCH[start_lba / SECTORS_PER_BLOCK],
+                                  atomic_load(&FLUSH_EPOCH), memory_order_relaxed);
+        } else {
+            atomic_fetch_add(&UNTRACKED_WRITES, 1);
+        }
     }
-    // i가 수행되고 남아있는 것들에 대해서 수행
-    const uint8_t *remaining = (const uint8_t*)(buf+i);
-    for (i = 0; i< length % 8; i++)
-    {
-        crc = _mm_crc32_u8(crc, remaining[i]);
+    if (FLUSH_EVERY && (atomic_fetch_add(&TOTAL_WRITES, 1) + 1) % FLUSH_EVERY == 0) {
+        flush_device();
     }
+}
 
-    return ~crc;
+static void *flush_timer_thread(void *arg) {
+    atomic_bool *stop_flag = (atomic_bool *)arg;
+    struct timespec interval = {
+        .tv_sec = (time_t)(FLUSH_INTERVAL_MS / 1000),
+        .tv_nsec = (long)(FLUSH_INTERVAL_MS % 1000) * 1000000L
+    };
+    while (1) {
+        nanosleep(&interval, NULL);
+        if (atomic_load(stop_flag)) {
+            break;
+        }
+        flush_device();
+    }
+    return NULL;
 }
 
 void* monitor_thread(void* arg) {
@@ -79,6 +350,10 @@ void* monitor_thread(void* arg) {
     clock_gettime(CLOCK_MONOTONIC, &interval_start);
 
     uint64_t last_bytes = 0;
+    uint64_t last_phase[PHASE_COUNT] = {0};
+    if (CPU_STATS) {
+        phase_stats_totals(last_phase);
+    }
 
     while (!atomic_load(ctx->stop_flag)) {
         struct timespec sleep_time = {
@@ -101,13 +376,19 @@ void* monitor_thread(void* arg) {
         // 누적 처리량 (MB)
         double total_mb = current_bytes / (1024.0 * 1024.0);
 
-        // 진행률 계산
-        int progress = (int)((current_bytes * 100) / TOTAL_SIZE);
-        if (progress > 100) progress = 100;
-
-        // 출력
-        printf("[%s Interval %.1fs] Throughput: %.2f MB/s | Total: %.2f MB | Progress: %d%%\n",
-               ctx->operation_name, MONITOR_INTERVAL, throughput, total_mb, progress);
+        // 진행률 계산 (replay처럼 전체 크기를 모르면 생략)
+        if (ctx->total_bytes) {
+            int progress = (int)((current_bytes * 100) / ctx->total_bytes);
+            if (progress > 100) progress = 100;
+            printf("[%s Interval %.1fs] Throughput: %.2f MB/s | Total: %.2f MB | Progress: %d%%\n",
+                   ctx->operation_name, MONITOR_INTERVAL, throughput, total_mb, progress);
+        } else {
+            printf("[%s Interval %.1fs] Throughput: %.2f MB/s | Total: %.2f MB\n",
+                   ctx->operation_name, MONITOR_INTERVAL, throughput, total_mb);
+        }
+        if (CPU_STATS) {
+            print_phase_interval(ctx->operation_name, last_phase, interval_bytes);
+        }
 
         last_bytes = current_bytes;
     }
@@ -116,148 +397,296 @@ void* monitor_thread(void* arg) {
 }
 
 
-void sim_write_block(uint64_t start_lba, const unsigned char *data, size_t data_size, uint64_t timestamp) {
-    // 시작 LBA에 해당하는 디바이스 오프셋 계산
-    uint64_t offset = start_lba * SECTOR_SIZE;
-    if (offset + IO_BLOCK_SIZE > device_size) {
-        printf("Error: Block starting at LBA %lu exceeds device bounds\n", start_lba);
-        return;
-    }
-
+// thread별 O_DIRECT 정렬 I/O 버퍼 (필요 시 확장)
+static unsigned char *thread_io_buffer(size_t size) {
     static thread_local unsigned char *block = NULL;
-    if (block == NULL) {
-        if (posix_memalign((void**)&block, ALIGNMENT, IO_BLOCK_SIZE) != 0) {
+    static thread_local size_t capacity = 0;
+    if (capacity < size) {
+        free(block);
+        block = NULL;
+        capacity = 0;
+        if (posix_memalign((void**)&block, ALIGNMENT, size) != 0) {
             perror("posix_memalign");
-            return;
+            block = NULL;
+            return NULL;
         }
+        capacity = size;
     }
+    return block;
+}
 
-    // 각 섹터마다 verify_header 설정
-    for (uint64_t i = 0; i < SECTORS_PER_BLOCK; i++) {
-        uint64_t lba = start_lba + i;
-        uint64_t sector_offset_in_block = i * SECTOR_SIZE;
-        unsigned char *sector = block + sector_offset_in_block;
+// backend I/O, 실패 시 지수 backoff 후 재시도 (short transfer는 남은 부분만 재시도)
+// 전체 전송 시 len, 아니면 마지막 결과 (전송된 byte 수 또는 -1)
+static ssize_t backend_transfer(bool is_write, unsigned char *buf, size_t len, uint64_t offset) {
+    size_t done = 0;
+    for (uint64_t attempt = 0; ; attempt++) {
+        ssize_t ret = is_write
+            ? BACKEND->pwrite(BACKEND, buf + done, len - done, offset + done, WRITE_DSYNC)
+            : BACKEND->pread(BACKEND, buf + done, len - done, offset + done);
+        if (ret > 0) {
+            done += (size_t)ret;
+        }
+        if (done == len) {
+            if (attempt > 0) {
+                atomic_fetch_add(&RETRY_RECOVERED, 1);
+            }
+            return (ssize_t)len;
+        }
+        if (attempt >= IO_RETRIES) {
+            if (IO_RETRIES > 0) {
+                atomic_fetch_add(&RETRY_EXHAUSTED, 1);
+            }
+            return done > 0 ? (ssize_t)done : ret;
+        }
 
-        // verify_header 설정
-        verify_header *header = (verify_header *)sector;
-        header->magic = VERIFY_MAGIC;
-        header->lba = lba;
-        header->timestamp = timestamp;
-        header->offset = lba * SECTOR_SIZE;
+        atomic_fetch_add(&RETRY_ATTEMPTS, 1);
+        uint64_t backoff_us = RETRY_BACKOFF_US << (attempt < 16 ? attempt : 16);
+        struct timespec ts = {
+            .tv_sec = (time_t)(backoff_us / 1000000),
+            .tv_nsec = (long)(backoff_us % 1000000) * 1000L
+        };
+        nanosleep(&ts, NULL);
+    }
+}
 
-        // 데이터 영역 시작 위치
-        unsigned char *payload = sector + sizeof(verify_header);
-        size_t payload_size = SECTOR_SIZE - sizeof(verify_header);
+int sim_write_block(uint64_t start_lba, size_t block_size, uint64_t timestamp) {
+    // 시작 LBA에 해당하는 디바이스 오프셋 계산
+    uint64_t offset = start_lba * SECTOR_SIZE;
+    if (offset + block_size > device_size) {
+        printf("Error: Block starting at LBA %lu exceeds device bounds\n", start_lba);
+        return -1;
+    }
 
-        // 데이터 복사
-        size_t data_offset = i * SECTOR_SIZE;
-        size_t copy_size = payload_size;
-        if (data_offset + copy_size > data_size) {
-            copy_size = (data_size > data_offset) ? (data_size - data_offset) : 0;
-        }
+    unsigned char *block = thread_io_buffer(block_size);
+    if (block == NULL) {
+        return -1;
+    }
+    uint64_t sectors = block_size / SECTOR_SIZE;
+    uint64_t gen_start = phase_begin();
 
-        if (copy_size > 0) {
-            memcpy(payload, data + data_offset, copy_size);
-        }
+    // 각 섹터마다 verify_header + payload (dedupe 블록은 canonical 패턴)
+    fv_fill_block(TARGET, block, start_lba, sectors, timestamp);
 
-        // 남은 공간은 0으로 채움
-        if (copy_size < payload_size) {
-            memset(payload + copy_size, 0, payload_size - copy_size);
-        }
+    phase_end(PHASE_GENERATE, gen_start, block_size);
 
-        // checksum 계산 (payload에 대해서만)
-        header->checksum = crc32_checksum(payload, payload_size);
+    // 다시 write된 영역은 더 이상 trim 상태가 아님
+    if (TRIM_MAP.bits != NULL) {
+        trim_map_unmark(&TRIM_MAP, start_lba, sectors);
     }
 
     // 디바이스에 블록 전체 쓰기
-    ssize_t written = pwrite(device_fd, block, IO_BLOCK_SIZE, offset);
-    if (written != (ssize_t)IO_BLOCK_SIZE) {
+    uint64_t io_start = io_timing_begin();
+    ssize_t written = backend_transfer(true, block, block_size, offset);
+    io_timing_end(IO_OP_WRITE, start_lba, block_size, io_start, written != (ssize_t)block_size);
+
+    // 실패한 write도 일부가 반영됐을 수 있으므로 dirty로 기록
+    if (JOURNAL != NULL) {
+        write_journal_append(JOURNAL, worker_index(), start_lba, sectors);
+    }
+    if (written != (ssize_t)block_size) {
         printf("Error: Failed to write block at LBA %lu (written %ld bytes)\n", start_lba, written);
         perror("pwrite");
+        return -1;
+    }
+
+    if (FLUSH_EVERY || BLOCK_EPOCH != NULL) {
+        durability_after_write(start_lba, block_size);
+    }
+    return 0;
+}
+
+// 검증 실패 섹터 기록: manifest가 있으면 검출 시각/false positive 집계
+static inline void flag_sector(uint64_t lba) {
+    if (MANIFEST.records != NULL) {
+        int64_t idx = fault_manifest_find(&MANIFEST, lba);
+        if (idx < 0) {
+            atomic_fetch_add(&FALSE_POSITIVES, 1);
+        } else {
+            uint64_t expected = 0;
+            atomic_compare_exchange_strong(&MANIFEST.detect_ns[idx], &expected, monotonic_ns() - DETECT_START_NS + 1);
+        }
+    }
+}
+
+// libfioverify 검증 실패 보고: 종류별 메시지 출력 후 manifest 집계
+// forensics: 검증 중인 블록 (error callback에서 에러 섹터 내용을 분석)
+static thread_local const unsigned char *verify_buffer = NULL;
+static thread_local uint64_t verify_start_lba = 0;
+static thread_local uint64_t verify_sectors = 0;
+
+static void record_forensics(const fv_error *err) {
+    if (err->lba < verify_start_lba || err->lba >= verify_start_lba + verify_sectors) {
         return;
     }
+    fv_sector_info info;
+    fv_inspect_sector(TARGET, verify_buffer + (err->lba - verify_start_lba) * SECTOR_SIZE, &info);
+    forensic_add(&FORENSIC_LOG, err->lba, err->kind, &info);
+}
+
+static void report_verify_error(const fv_error *err, void *user) {
+    (void)user;
+    if (FORENSICS && err->kind != FV_ERR_IO && verify_buffer != NULL) {
+        record_forensics(err);
+    }
+    switch (err->kind) {
+        case FV_ERR_DEDUPE:
+            printf("[ERROR] Dedupe block mismatch at LBA=%lu: Slot=%d, Byte=%lu, Expected=0x%02lX, Got=0x%02lX\n",
+                   err->lba, err->slot, err->byte, err->expected, err->actual);
+            break;
+        case FV_ERR_TRIM_DATA:
+            printf("[ERROR] Non-deterministic data after trim at LBA=%lu\n", err->lba);
+            break;
+        case FV_ERR_TRIM_STALE:
+            printf("[ERROR] Stale data after trim at LBA=%lu: Header LBA=%lu, Timestamp=%lu\n",
+                   err->lba, err->actual, err->timestamp);
+            break;
+        case FV_ERR_LBA:
+            printf("[ERROR] LBA mismatch at LBA=%lu: Expected=%lu, Got=%lu, Timestamp=%lu\n",
+                   err->lba, err->expected, err->actual, err->timestamp);
+            break;
+        case FV_ERR_OFFSET:
+            printf("[ERROR] Offset mismatch at LBA=%lu: Expected=%lu, Got=%lu, Timestamp=%lu\n",
+                   err->lba, err->expected, err->actual, err->timestamp);
+            break;
+        case FV_ERR_SEED_TAG:
+            printf("[ERROR] Seed tag mismatch at LBA=%lu: Expected=0x%08lX, Got=0x%08lX, Timestamp=%lu\n",
+                   err->lba, err->expected, err->actual, err->timestamp);
+            break;
+        case FV_ERR_PAYLOAD:
+            printf("[ERROR] Payload mismatch at LBA=%lu: Byte=%lu, Expected=0x%02lX, Got=0x%02lX, Timestamp=%lu\n",
+                   err->lba, err->byte, err->expected, err->actual, err->timestamp);
+            break;
+        case FV_ERR_CHECKSUM:
+            printf("[ERROR] Checksum mismatch at LBA=%lu: Expected=0x%08lX, Got=0x%08lX, Timestamp=%lu\n",
+                   err->lba, err->expected, err->actual, err->timestamp);
+            break;
+        case FV_ERR_GENERATION:
+            printf("[ERROR] %s generation at LBA=%lu: Expected=%lu, Got=%lu\n",
+                   err->actual < err->expected ? "Stale" : "Unexpected", err->lba, err->expected, err->actual);
+            break;
+        case FV_ERR_IO:
+            printf("Error: I/O failed at LBA %lu (%lu of %lu bytes)\n", err->lba, err->actual, err->expected);
+            return;
+    }
+    flag_sector(err->lba);
+}
+
+static bool query_trim_map(uint64_t lba, void *user) {
+    (void)user;
+    return trim_map_test(&TRIM_MAP, lba);
+}
 
+// 읽은 블록의 섹터별 검증, 에러 섹터 수 반환
+static int verify_block(const unsigned char *block, uint64_t start_lba, uint64_t sectors) {
+    fv_block_result result;
+    if (FORENSICS) {
+        verify_buffer = block;
+        verify_start_lba = start_lba;
+        verify_sectors = sectors;
+    }
+    int errors = fv_verify_block(TARGET, block, start_lba, sectors, &result);
+    if (result.unwritten) {
+        atomic_fetch_add(&UNWRITTEN_SECTORS, result.unwritten);
+        // zero fault는 unwritten으로 보이므로 manifest에 있는 섹터만 검출로 집계 (false positive 아님)
+        for (uint64_t i = 0; MANIFEST.records != NULL && i < sectors; i++) {
+            const verify_header *header = (const verify_header *)(block + i * SECTOR_SIZE);
+            int64_t idx = header->magic != VERIFY_MAGIC ? fault_manifest_find(&MANIFEST, start_lba + i) : -1;
+            if (idx >= 0 && MANIFEST.records[idx].type == FAULT_ZERO) {
+                uint64_t expected = 0;
+                atomic_compare_exchange_strong(&MANIFEST.detect_ns[idx], &expected, monotonic_ns() - DETECT_START_NS + 1);
+            }
+        }
+    }
+    if (result.trimmed) {
+        atomic_fetch_add(&TRIMMED_SECTORS, result.trimmed);
+    }
+    return errors;
 }
 
-int sim_read_block(uint64_t start_lba) {
+int sim_read_block(uint64_t start_lba, size_t block_size) {
     // 시작 LBA에 해당하는 디바이스 오프셋 계산
     uint64_t offset = start_lba * SECTOR_SIZE;
 
-    if (offset + IO_BLOCK_SIZE > device_size) {
+    if (offset + block_size > device_size) {
         printf("Error: Block starting at LBA %lu exceeds device bounds\n", start_lba);
         return -1;
     }
 
-    static thread_local unsigned char *block = NULL;
+    unsigned char *block = thread_io_buffer(block_size);
     if (block == NULL) {
-        if (posix_memalign((void**)&block, ALIGNMENT, IO_BLOCK_SIZE) != 0) {
-            perror("posix_memalign");
-            return -1;
-        }
+        return -1;
     }
+    uint64_t sectors = block_size / SECTOR_SIZE;
 
     // 디바이스에서 블록 전체 읽기
-    ssize_t bytes_read = pread(device_fd, block, IO_BLOCK_SIZE, offset);
-    if (bytes_read != (ssize_t)IO_BLOCK_SIZE) {
+    uint64_t io_start = io_timing_begin();
+    ssize_t bytes_read = backend_transfer(false, block, block_size, offset);
+    io_timing_end(IO_OP_READ, start_lba, block_size, io_start, bytes_read != (ssize_t)block_size);
+    if (bytes_read != (ssize_t)block_size) {
         printf("Error: Failed to read block at LBA %lu (read %ld bytes)\n", start_lba, bytes_read);
         perror("pread");
         return -1;
     }
 
-    int errors = 0;
-
-    // 각 섹터마다 검증
-    for (uint64_t i = 0; i < SECTORS_PER_BLOCK; i++) {
-        uint64_t lba = start_lba + i;
-        uint64_t sector_offset_in_block = i * SECTOR_SIZE;
-        unsigned char *sector = block + sector_offset_in_block;
-
-        // verify_header 읽기
-        verify_header *header = (verify_header *)sector;
+    uint64_t verify_start = phase_begin();
+    int errors = verify_block(block, start_lba, sectors);
+    phase_end(PHASE_VERIFY, verify_start, block_size);
 
-        // Magic number 확인 - write되지 않은 섹터는 skip
-        if (header->magic != VERIFY_MAGIC) {
-            // Write되지 않은 섹터이므로 검증하지 않음
-            continue;
-        }
+    return errors;  
+}
 
-        // LBA 검증
-        if (header->lba != lba) {
-            printf("[ERROR] LBA mismatch at LBA=%lu: Expected=%lu, Got=%lu, Timestamp=%lu\n",
-                   lba, lba, header->lba, header->timestamp);
-            errors++;
-            continue;
-        }
+// 큰 전송 하나를 읽고 verify unit 단위로 검증, 에러 섹터 수 반환
+// 전송 전체가 실패하면 unit 단위로 다시 읽어 실패 범위를 unit으로 좁힘
+static int sim_read_transfer(uint64_t start_lba, size_t length, uint64_t *failed_units, uint64_t *bad_units) {
+    uint64_t offset = start_lba * SECTOR_SIZE;
+    unsigned char *block = thread_io_buffer(length);
+    if (block == NULL) {
+        *failed_units += (length + VERIFY_UNIT - 1) / VERIFY_UNIT;
+        return 0;
+    }
+    uint64_t io_start = io_timing_begin();
+    ssize_t bytes_read = backend_transfer(false, block, length, offset);
+    io_timing_end(IO_OP_READ, start_lba, length, io_start, bytes_read != (ssize_t)length);
+    bool whole = bytes_read == (ssize_t)length;
 
-        // Offset 검증
-        uint64_t expected_offset = lba * SECTOR_SIZE;
-        if (header->offset != expected_offset) {
-            printf("[ERROR] Offset mismatch at LBA=%lu: Expected=%lu, Got=%lu, Timestamp=%lu\n",
-                   lba, expected_offset, header->offset, header->timestamp);
-            errors++;
+    int errors = 0;
+    uint64_t verify_start = phase_begin();
+    for (size_t off = 0; off < length; off += VERIFY_UNIT) {
+        uint64_t lba = start_lba + off / SECTOR_SIZE;
+        // 마지막 unit은 짧을 수 있음 (journal extent 끝)
+        size_t unit = length - off < VERIFY_UNIT ? length - off : VERIFY_UNIT;
+        if (!whole && backend_transfer(false, block + off, unit, offset + off) != (ssize_t)unit) {
+            printf("Error: Failed to read unit at LBA %lu (%lu bytes)\n", lba, unit);
+            (*failed_units)++;
             continue;
         }
-
-        // payload 읽기 및 checksum 계산
-        unsigned char *payload = sector + sizeof(verify_header);
-        size_t payload_size = SECTOR_SIZE - sizeof(verify_header);
-        uint32_t calculated_checksum = crc32_checksum(payload, payload_size);
-
-        // checksum 검증
-        if (calculated_checksum != header->checksum) {
-            printf("[ERROR] Checksum mismatch at LBA=%lu: Expected=0x%08X, Got=0x%08X, Timestamp=%lu\n",
-                   lba, header->checksum, calculated_checksum, header->timestamp);
-            errors++;
+        int unit_errors = verify_block(block + off, lba, unit / SECTOR_SIZE);
+        if (unit_errors) {
+            errors += unit_errors;
+            (*bad_units)++;
         }
     }
-
-    return errors;  
+    phase_end(PHASE_VERIFY, verify_start, length);
+    return errors;
 }
 
+// magic 없는 섹터 분류 결과 (trim map이 있을 때만 trimmed가 집계됨)
+static void print_sector_classes(void) {
+    uint64_t unwritten = atomic_load(&UNWRITTEN_SECTORS);
+    uint64_t trimmed = atomic_load(&TRIMMED_SECTORS);
+    if (unwritten || trimmed) {
+        printf("  Unwritten sectors: %lu\n", unwritten);
+        printf("  Trimmed sectors: %lu%s\n", trimmed, TRIM_MAP.bits != NULL ? "" : " (no --trim-map)");
+    }
+    atomic_store(&UNWRITTEN_SECTORS, 0);
+    atomic_store(&TRIMMED_SECTORS, 0);
+}
 
-void test_sequential(void) {
+// 검증 결과가 실행 종료 코드가 되도록 에러 + 실패 수 반환
+int test_sequential(void) {
     printf("\n=== Sequential Test ===\n");
     printf("Reading all blocks sequentially...\n\n");
+    io_backend_advise(BACKEND, IO_PATTERN_SEQUENTIAL);
 
     // 모니터링용 atomic 변수
     atomic_uint_fast64_t completed_bytes = 0;
@@ -269,44 +698,195 @@ void test_sequential(void) {
     monitor_context ctx = {
         .completed_bytes = &completed_bytes,
         .stop_flag = &stop_flag,
-        .operation_name = "READ"
+        .operation_name = "READ",
+        .total_bytes = TOTAL_SIZE
     };
+    if (SHM_STATS) {
+        shm_stats_begin(SHM_STATS, "READ", TOTAL_SIZE);
+    }
 
     // 모니터링 스레드 시작
     pthread_t monitor_tid;
     pthread_create(&monitor_tid, NULL, monitor_thread, &ctx);
 
-    #pragma omp parallel for schedule(dynamic, CHUNK)
-    for (uint64_t block_idx = 0; block_idx < NUM_BLOCKS; block_idx++) {
-        uint64_t start_lba = block_idx * SECTORS_PER_BLOCK;
-        int block_errors = sim_read_block(start_lba);
-
-        if (block_errors > 0) {
-            // 섹터 에러 개수 누적
-            atomic_fetch_add(&errors, block_errors);
-        } else if (block_errors < 0) {
-            // 읽기 실패 (I/O 에러 등)
-            atomic_fetch_add(&read_failures, 1);
+    // 큰 전송 + 작은 검증 단위: 전송 하나를 읽은 thread가 unit별로 검증
+    bool coalesced = XFER_SIZE != IO_BLOCK_SIZE || VERIFY_UNIT != IO_BLOCK_SIZE;
+    atomic_uint_fast64_t bad_units = 0;
+    atomic_uint_fast64_t failed_units = 0;
+    uint64_t run_start = monotonic_ns();
+
+    if (coalesced) {
+        uint64_t xfer_blocks = XFER_SIZE / IO_BLOCK_SIZE;
+        uint64_t num_xfers = (NUM_BLOCKS + xfer_blocks - 1) / xfer_blocks;
+
+        #pragma omp parallel for schedule(dynamic, 1)
+        for (uint64_t x = 0; x < num_xfers; x++) {
+            uint64_t first_block = x * xfer_blocks;
+            uint64_t blocks = NUM_BLOCKS - first_block < xfer_blocks ? NUM_BLOCKS - first_block : xfer_blocks;
+            size_t length = blocks * IO_BLOCK_SIZE;
+            uint64_t failed = 0, bad = 0;
+            int xfer_errors = sim_read_transfer(first_block * SECTORS_PER_BLOCK, length, &failed, &bad);
+
+            atomic_fetch_add(&errors, xfer_errors);
+            if (failed) {
+                atomic_fetch_add(&failed_units, failed);
+            }
+            if (bad) {
+                atomic_fetch_add(&bad_units, bad);
+            }
+            record_block_stats(length, failed ? -1 : xfer_errors);
+            atomic_fetch_add(&completed_bytes, length);
         }
+    } else {
+        #pragma omp parallel for schedule(dynamic, CHUNK)
+        for (uint64_t block_idx = 0; block_idx < NUM_BLOCKS; block_idx++) {
+            uint64_t start_lba = block_idx * SECTORS_PER_BLOCK;
+            int block_errors = sim_read_block(start_lba, IO_BLOCK_SIZE);
+
+            if (block_errors > 0) {
+                // 섹터 에러 개수 누적
+                atomic_fetch_add(&errors, block_errors);
+            } else if (block_errors < 0) {
+                // 읽기 실패 (I/O 에러 등)
+                atomic_fetch_add(&read_failures, 1);
+            }
+            record_block_stats(IO_BLOCK_SIZE, block_errors);
 
-        // 완료된 바이트 수 업데이트
-        atomic_fetch_add(&completed_bytes, IO_BLOCK_SIZE);
+            // 완료된 바이트 수 업데이트
+            atomic_fetch_add(&completed_bytes, IO_BLOCK_SIZE);
+        }
     }
+    double seconds = (monotonic_ns() - run_start) / 1e9;
 
     // 모니터링 스레드 종료
     atomic_store(&stop_flag, true);
     pthread_join(monitor_tid, NULL);
+    BYTES_PROCESSED += atomic_load(&completed_bytes);
+    if (SHM_STATS) {
+        shm_stats_finish(SHM_STATS);
+    }
 
     int total_errors = atomic_load(&errors);
     int total_failures = atomic_load(&read_failures);
     printf("\nSequential Test Complete:\n");
+    printf("  Elapsed: %.2f s (%.2f MB/s)\n", seconds,
+           seconds > 0 ? atomic_load(&completed_bytes) / (1024.0 * 1024.0) / seconds : 0.0);
     printf("  Sector errors: %d\n", total_errors);
-    printf("  Read failures: %d blocks\n", total_failures);
+    if (coalesced) {
+        printf("  Transfer size: %lu bytes, verify unit: %lu bytes\n", XFER_SIZE, VERIFY_UNIT);
+        printf("  Units with errors: %lu\n", atomic_load(&bad_units));
+        printf("  Read failures: %lu units\n", atomic_load(&failed_units));
+    } else {
+        printf("  Read failures: %d blocks\n", total_failures);
+    }
+    print_sector_classes();
+    return total_errors + total_failures + (int)atomic_load(&failed_units);
+}
+
+// journal에서 generation >= since 인 dirty extent만 다시 읽어 검증 (--verify-since GEN)
+// 비용이 device 크기가 아니라 그 이후 write된 양에 비례
+int run_verify_since(uint64_t since) {
+    printf("\n=== Incremental Verify ===\n");
+
+    // O_DIRECT 정렬 단위 (dedupe unit과 같은 4K)
+    uint64_t granularity = ALIGNMENT / SECTOR_SIZE;
+    journal_dirty dirty;
+    if (!write_journal_load_dirty(JOURNAL_PATH, NUM_SECTOR, since, granularity, &dirty)) {
+        return -1;
+    }
+
+    // 병합된 extent를 XFER_SIZE 이하 전송으로 분할
+    uint64_t xfer_sectors = XFER_SIZE / SECTOR_SIZE;
+    uint64_t dirty_sectors = 0;
+    uint64_t num_xfers = 0;
+    for (uint64_t e = 0; e < dirty.count; e++) {
+        dirty_sectors += dirty.extents[e].sectors;
+        num_xfers += (dirty.extents[e].sectors + xfer_sectors - 1) / xfer_sectors;
+    }
+    printf("Journal: %s (%lu records, generations up to %lu)\n", JOURNAL_PATH, dirty.total_records, dirty.max_generation);
+    printf("Since generation %lu: %lu records -> %lu dirty extents, %.2f MB (%.2f%% of device)\n",
+           since, dirty.records, dirty.count, dirty_sectors * SECTOR_SIZE / (1024.0 * 1024.0),
+           NUM_SECTOR ? 100.0 * dirty_sectors / NUM_SECTOR : 0.0);
+    printf("Reading %lu transfers of up to %lu bytes, verify unit %lu bytes\n\n", num_xfers, XFER_SIZE, VERIFY_UNIT);
+
+    journal_extent *xfers = malloc((num_xfers ? num_xfers : 1) * sizeof(journal_extent));
+    if (xfers == NULL) {
+        printf("Error: Out of memory for %lu transfers\n", num_xfers);
+        write_journal_free_dirty(&dirty);
+        return -1;
+    }
+    uint64_t n = 0;
+    for (uint64_t e = 0; e < dirty.count; e++) {
+        for (uint64_t off = 0; off < dirty.extents[e].sectors; off += xfer_sectors) {
+            uint64_t left = dirty.extents[e].sectors - off;
+            xfers[n].start_lba = dirty.extents[e].start_lba + off;
+            xfers[n].sectors = left < xfer_sectors ? left : xfer_sectors;
+            n++;
+        }
+    }
+    write_journal_free_dirty(&dirty);
+    io_backend_advise(BACKEND, IO_PATTERN_SEQUENTIAL);
+
+    atomic_uint_fast64_t completed_bytes = 0;
+    atomic_bool stop_flag = false;
+    atomic_int errors = 0;
+    atomic_uint_fast64_t bad_units = 0;
+    atomic_uint_fast64_t failed_units = 0;
+
+    monitor_context ctx = {
+        .completed_bytes = &completed_bytes,
+        .stop_flag = &stop_flag,
+        .operation_name = "VERIFY",
+        .total_bytes = dirty_sectors * SECTOR_SIZE
+    };
+    if (SHM_STATS) {
+        shm_stats_begin(SHM_STATS, "VERIFY", dirty_sectors * SECTOR_SIZE);
+    }
+    pthread_t monitor_tid;
+    pthread_create(&monitor_tid, NULL, monitor_thread, &ctx);
+    uint64_t run_start = monotonic_ns();
+
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (uint64_t x = 0; x < num_xfers; x++) {
+        size_t length = xfers[x].sectors * SECTOR_SIZE;
+        uint64_t failed = 0, bad = 0;
+        int xfer_errors = sim_read_transfer(xfers[x].start_lba, length, &failed, &bad);
+
+        atomic_fetch_add(&errors, xfer_errors);
+        if (failed) {
+            atomic_fetch_add(&failed_units, failed);
+        }
+        if (bad) {
+            atomic_fetch_add(&bad_units, bad);
+        }
+        record_block_stats(length, failed ? -1 : xfer_errors);
+        atomic_fetch_add(&completed_bytes, length);
+    }
+    double seconds = (monotonic_ns() - run_start) / 1e9;
+
+    atomic_store(&stop_flag, true);
+    pthread_join(monitor_tid, NULL);
+    BYTES_PROCESSED += atomic_load(&completed_bytes);
+    if (SHM_STATS) {
+        shm_stats_finish(SHM_STATS);
+    }
+    free(xfers);
+
+    printf("\nIncremental Verify Complete:\n");
+    printf("  Elapsed: %.2f s (%.2f MB/s)\n", seconds,
+           seconds > 0 ? atomic_load(&completed_bytes) / (1024.0 * 1024.0) / seconds : 0.0);
+    printf("  Sector errors: %d\n", atomic_load(&errors));
+    printf("  Units with errors: %lu\n", atomic_load(&bad_units));
+    printf("  Read failures: %lu units\n", atomic_load(&failed_units));
+    print_sector_classes();
+    printf("  Next incremental check: --verify-since %lu\n", since > dirty.max_generation ? since : dirty.max_generation + 1);
+    return atomic_load(&errors) + (int)atomic_load(&failed_units);
 }
 
-void test_random(void) {
+int test_random(void) {
     printf("\n=== Random Test ===\n");
     printf("Reading blocks in random order...\n\n");
+    io_backend_advise(BACKEND, IO_PATTERN_RANDOM);
 
     // 모니터링용 atomic 변수
     atomic_uint_fast64_t completed_bytes = 0;
@@ -318,8 +898,12 @@ void test_random(void) {
     monitor_context ctx = {
         .completed_bytes = &completed_bytes,
         .stop_flag = &stop_flag,
-        .operation_name = "READ"
+        .operation_name = "READ",
+        .total_bytes = TOTAL_SIZE
     };
+    if (SHM_STATS) {
+        shm_stats_begin(SHM_STATS, "READ", TOTAL_SIZE);
+    }
 
     // 모니터링 스레드 시작
     pthread_t monitor_tid;
@@ -335,7 +919,7 @@ void test_random(void) {
 
         uint64_t block_idx = rand_r(&seed) % NUM_BLOCKS;
         uint64_t start_lba = block_idx * SECTORS_PER_BLOCK;
-        int block_errors = sim_read_block(start_lba);
+        int block_errors = sim_read_block(start_lba, IO_BLOCK_SIZE);
 
         if (block_errors > 0) {
             // 섹터 에러 개수 누적
@@ -344,6 +928,7 @@ void test_random(void) {
             // 읽기 실패 (I/O 에러 등)
             atomic_fetch_add(&read_failures, 1);
         }
+        record_block_stats(IO_BLOCK_SIZE, block_errors);
 
         // 완료된 바이트 수 업데이트
         atomic_fetch_add(&completed_bytes, IO_BLOCK_SIZE);
@@ -352,17 +937,24 @@ void test_random(void) {
     // 모니터링 스레드 종료
     atomic_store(&stop_flag, true);
     pthread_join(monitor_tid, NULL);
+    BYTES_PROCESSED += atomic_load(&completed_bytes);
+    if (SHM_STATS) {
+        shm_stats_finish(SHM_STATS);
+    }
 
     int total_errors = atomic_load(&errors);
     int total_failures = atomic_load(&read_failures);
     printf("\nRandom Test Complete:\n");
     printf("  Sector errors: %d\n", total_errors);
     printf("  Read failures: %d blocks\n", total_failures);
+    print_sector_classes();
+    return total_errors + total_failures;
 }
 
 // 테스트 데이터로 메모리 초기화
-void initialize_memory(void) {
+int initialize_memory(void) {
     printf("Initializing memory with test data...\n\n");
+    io_backend_advise(BACKEND, IO_PATTERN_SEQUENTIAL);
 
     // 모니터링용 atomic 변수
     atomic_uint_fast64_t completed_bytes = 0;
@@ -372,13 +964,23 @@ void initialize_memory(void) {
     monitor_context ctx = {
         .completed_bytes = &completed_bytes,
         .stop_flag = &stop_flag,
-        .operation_name = "WRITE"
+        .operation_name = "WRITE",
+        .total_bytes = TOTAL_SIZE
     };
+    if (SHM_STATS) {
+        shm_stats_begin(SHM_STATS, "WRITE", TOTAL_SIZE);
+    }
 
     // 모니터링 스레드 시작
     pthread_t monitor_tid;
     pthread_create(&monitor_tid, NULL, monitor_thread, &ctx);
 
+    // 실제 생성된 데이터의 압축/dedupe 특성 집계
+    atomic_uint_fast64_t incompressible_bytes = 0;
+    atomic_uint_fast64_t dedupe_units = 0;
+    atomic_uint dedupe_slots_used = 0;
+    atomic_int write_failures = 0;
+
     #pragma omp parallel for schedule(dynamic, CHUNK)
     for (uint64_t block_idx = 0; block_idx < NUM_BLOCKS; block_idx++) {
         static thread_local uint64_t thread_timestamp = 0;
@@ -390,16 +992,24 @@ void initialize_memory(void) {
 
         uint64_t start_lba = block_idx * SECTORS_PER_BLOCK;
 
-        // 블록 크기만큼 테스트 데이터 생성
-        unsigned char data[IO_BLOCK_SIZE];
-        for (size_t i = 0; i < IO_BLOCK_SIZE; i++) {
-            // 각 섹터마다 다른 패턴 생성
-            uint64_t sector_in_block = i / SECTOR_SIZE;
-            uint64_t lba = start_lba + sector_in_block;
-            data[i] = (unsigned char)((lba * 7 + i) % 256);
+        // payload는 sim_write_block에서 (seed, LBA)로 직접 생성
+        int result = sim_write_block(start_lba, IO_BLOCK_SIZE, thread_timestamp);
+        if (result < 0) {
+            atomic_fetch_add(&write_failures, 1);
+        }
+        record_block_stats(IO_BLOCK_SIZE, result);
+
+        for (uint64_t u = 0; u < SECTORS_PER_BLOCK; u += FV_DEDUPE_UNIT_SECTORS) {
+            int slot = fv_dedupe_slot(TARGET, start_lba + u);
+            if (slot >= 0) {
+                atomic_fetch_add(&dedupe_units, 1);
+                atomic_fetch_or(&dedupe_slots_used, 1u << slot);
+                atomic_fetch_add(&incompressible_bytes, FV_DEDUPE_UNIT_SECTORS * DEDUPE_RANDOM_LEN);
+            } else {
+                atomic_fetch_add(&incompressible_bytes,
+                                 FV_DEDUPE_UNIT_SECTORS * (sizeof(verify_header) + PAYLOAD_RANDOM_LEN));
+            }
         }
-
-        sim_write_block(start_lba, data, IO_BLOCK_SIZE, thread_timestamp);
 
         // 완료된 바이트 수 업데이트
         atomic_fetch_add(&completed_bytes, IO_BLOCK_SIZE);
@@ -408,85 +1018,1821 @@ void initialize_memory(void) {
     // 모니터링 스레드 종료
     atomic_store(&stop_flag, true);
     pthread_join(monitor_tid, NULL);
+    BYTES_PROCESSED += atomic_load(&completed_bytes);
+    if (SHM_STATS) {
+        shm_stats_finish(SHM_STATS);
+    }
+
+    // 유효 압축률 = 전체 / (header + random 영역), 유효 dedupe = 전체 4K unit / 고유 unit
+    uint64_t total_bytes = NUM_BLOCKS * IO_BLOCK_SIZE;
+    uint64_t incompressible = atomic_load(&incompressible_bytes);
+    uint64_t total_units = NUM_BLOCKS * (SECTORS_PER_BLOCK / FV_DEDUPE_UNIT_SECTORS);
+    uint64_t dup_units = atomic_load(&dedupe_units);
+    uint64_t unique_units = total_units - dup_units + (uint64_t)__builtin_popcount(atomic_load(&dedupe_slots_used));
+    printf("\nPayload Profile:\n");
+    printf("  Compression ratio: %.2f:1 (target %.2f:1)\n",
+           incompressible ? (double)total_bytes / incompressible : 0.0, COMPRESS_RATIO);
+    printf("  Dedupe: %.2f%% repeated 4K units, ratio %.2f:1 (target %.2f%%)\n",
+           total_units ? 100.0 * (total_units - unique_units) / total_units : 0.0,
+           unique_units ? (double)total_units / unique_units : 0.0, DEDUPE_RATIO * 100.0);
+
+    if (atomic_load(&write_failures)) {
+        printf("  Write failures: %d blocks\n", atomic_load(&write_failures));
+    }
 
     printf("\nMemory initialization complete\n");
     printf("Read start\n");
+    return atomic_load(&write_failures);
 }
 
-void corruption(int corruption_type)
-{
-    unsigned char *block = NULL;
-    if (posix_memalign((void**)&block, SECTOR_SIZE, SECTOR_SIZE) != 0) {
-        perror("posix_memalign");
-        return;
+// soak pass 하나의 결과
+typedef struct {
+    uint64_t generation;
+    double write_mbps;
+    double read_mbps;
+    uint64_t write_p50_us;
+    uint64_t write_p99_us;
+    uint64_t read_p50_us;
+    uint64_t read_p99_us;
+    uint64_t errors;
+    uint64_t failures;
+    double seconds;
+} soak_pass;
+
+// soak의 write 또는 read 단계: device 전체를 병렬로 처리, throughput과 I/O latency 분포 기록
+static double soak_phase(bool write, uint64_t generation, uint64_t buckets[SHM_STATS_LAT_BUCKETS],
+                         uint64_t *errors, uint64_t *failures) {
+    const char *name = write ? "SOAK WRITE" : "SOAK READ";
+    atomic_uint_fast64_t completed_bytes = 0;
+    atomic_uint_fast64_t lat_buckets[SHM_STATS_LAT_BUCKETS] = {0};
+    atomic_uint_fast64_t sector_errors = 0;
+    atomic_uint_fast64_t io_failures = 0;
+    atomic_bool stop_flag = false;
+
+    monitor_context ctx = {
+        .completed_bytes = &completed_bytes,
+        .stop_flag = &stop_flag,
+        .operation_name = name,
+        .total_bytes = TOTAL_SIZE
+    };
+    if (SHM_STATS) {
+        shm_stats_begin(SHM_STATS, name, TOTAL_SIZE);
     }
+    pthread_t monitor_tid;
+    pthread_create(&monitor_tid, NULL, monitor_thread, &ctx);
+    io_backend_advise(BACKEND, IO_PATTERN_SEQUENTIAL);
 
-    ssize_t ret;
-    switch(corruption_type){
-        case 1: {  // checksum mismatch
-            ret = pread(device_fd, block, SECTOR_SIZE, 5*SECTOR_SIZE);
-            if (ret != SECTOR_SIZE) {
-                perror("pread failed in corruption case 1");
-                break;
-            }
-            block[sizeof(verify_header)] = 'A';
-            ret = pwrite(device_fd, block, SECTOR_SIZE, 5*SECTOR_SIZE);
-            if (ret != SECTOR_SIZE) {
-                perror("pwrite failed in corruption case 1");
-            }
-            break;
-        }
-        case 2: {  // lba mismatch
-            ret = pread(device_fd, block, SECTOR_SIZE, 3*SECTOR_SIZE);
-            if (ret != SECTOR_SIZE) {
-                perror("pread failed in corruption case 2");
-                break;
-            }
-            verify_header* header = (verify_header*)block;
-            header->lba = 4;
-            ret = pwrite(device_fd, block, SECTOR_SIZE, 3*SECTOR_SIZE);
-            if (ret != SECTOR_SIZE) {
-                perror("pwrite failed in corruption case 2");
-            }
-            break;
+    uint64_t start = monotonic_ns();
+    #pragma omp parallel for schedule(dynamic, CHUNK)
+    for (uint64_t block_idx = 0; block_idx < NUM_BLOCKS; block_idx++) {
+        uint64_t start_lba = block_idx * SECTORS_PER_BLOCK;
+        // timestamp 자리에 generation 기록 (check_generation)
+        int result = write ? sim_write_block(start_lba, IO_BLOCK_SIZE, generation)
+                           : sim_read_block(start_lba, IO_BLOCK_SIZE);
+        if (result < 0) {
+            atomic_fetch_add(&io_failures, 1);
+        } else {
+            atomic_fetch_add(&sector_errors, (uint64_t)result);
+            atomic_fetch_add(&lat_buckets[shm_stats_latency_bucket(io_latency_ns)], 1);
         }
-        case 3: {  // offset mismatch
-            ret = pread(device_fd, block, SECTOR_SIZE, 1*SECTOR_SIZE);
-            if (ret != SECTOR_SIZE) {
-                perror("pread failed in corruption case 3");
-                break;
-            }
-            verify_header* header = (verify_header*)block;
-            header->offset = 8192;
-            ret = pwrite(device_fd, block, SECTOR_SIZE, 1*SECTOR_SIZE);
-            if (ret != SECTOR_SIZE) {
-                perror("pwrite failed in corruption case 3");
-            }
+        record_block_stats(IO_BLOCK_SIZE, result);
+        atomic_fetch_add(&completed_bytes, IO_BLOCK_SIZE);
+    }
+    double seconds = (monotonic_ns() - start) / 1e9;
+
+    atomic_store(&stop_flag, true);
+    pthread_join(monitor_tid, NULL);
+    BYTES_PROCESSED += atomic_load(&completed_bytes);
+    if (SHM_STATS) {
+        shm_stats_finish(SHM_STATS);
+    }
+
+    for (int b = 0; b < SHM_STATS_LAT_BUCKETS; b++) {
+        buckets[b] = atomic_load(&lat_buckets[b]);
+    }
+    *errors += atomic_load(&sector_errors);
+    *failures += atomic_load(&io_failures);
+    return seconds > 0 ? atomic_load(&completed_bytes) / (1024.0 * 1024.0) / seconds : 0.0;
+}
+
+// pass 번호에 대한 최소제곱 기울기 (pass당 변화량)
+static double soak_slope(const soak_pass *passes, int count, size_t field_offset) {
+    if (count < 2) {
+        return 0.0;
+    }
+    double sx = 0, sy = 0, sxx = 0, sxy = 0;
+    for (int i = 0; i < count; i++) {
+        double y = *(const double *)((const char *)&passes[i] + field_offset);
+        sx += i;
+        sy += y;
+        sxx += (double)i * i;
+        sxy += i * y;
+    }
+    double denom = count * sxx - sx * sx;
+    return denom != 0.0 ? (count * sxy - sx * sy) / denom : 0.0;
+}
+
+static double percent_change(double first, double last) {
+    return first != 0.0 ? 100.0 * (last - first) / first : 0.0;
+}
+
+// write + verify pass를 반복 (pass 수 또는 시간 제한), pass마다 generation 증가
+// 이전 pass의 섹터가 남아 있으면 verify에서 generation 불일치로 검출된다.
+int run_soak(uint64_t max_passes, uint64_t max_seconds) {
+    printf("\n=== Soak Test ===\n");
+    if (max_passes) {
+        printf("Passes: %lu\n", max_passes);
+    }
+    if (max_seconds) {
+        printf("Time limit: %lu s\n", max_seconds);
+    }
+
+    soak_pass *passes = NULL;
+    int count = 0;
+    int capacity = 0;
+    uint64_t base_generation = PAYLOAD_GENERATION;
+    uint64_t soak_start = monotonic_ns();
+
+    while (max_passes == 0 || (uint64_t)count < max_passes) {
+        if (count == capacity) {
+            capacity = capacity ? capacity * 2 : 16;
+            soak_pass *grown = realloc(passes, capacity * sizeof(soak_pass));
+            if (grown == NULL) {
+                perror("realloc");
+                break;
+            }
+            passes = grown;
+        }
+
+        soak_pass *pass = &passes[count];
+        memset(pass, 0, sizeof(*pass));
+        pass->generation = base_generation + (uint64_t)count + 1;
+        PAYLOAD_GENERATION = pass->generation;
+        fv_set_generation(TARGET, pass->generation);
+
+        printf("\n--- Pass %d (generation %lu) ---\n", count + 1, pass->generation);
+        uint64_t pass_start = monotonic_ns();
+        uint64_t buckets[SHM_STATS_LAT_BUCKETS];
+        uint64_t total;
+
+        pass->write_mbps = soak_phase(true, pass->generation, buckets, &pass->errors, &pass->failures);
+        total = latency_bucket_total(buckets);
+        pass->write_p50_us = latency_percentile_us(buckets, total, 50.0);
+        pass->write_p99_us = latency_percentile_us(buckets, total, 99.0);
+
+        pass->read_mbps = soak_phase(false, pass->generation, buckets, &pass->errors, &pass->failures);
+        total = latency_bucket_total(buckets);
+        pass->read_p50_us = latency_percentile_us(buckets, total, 50.0);
+        pass->read_p99_us = latency_percentile_us(buckets, total, 99.0);
+        pass->seconds = (monotonic_ns() - pass_start) / 1e9;
+        count++;
+
+        printf("Pass %d: write %.2f MB/s (p99 <%luus), read %.2f MB/s (p99 <%luus), "
+               "%lu sector errors, %lu failed blocks, %.1f s\n",
+               count, pass->write_mbps, pass->write_p99_us, pass->read_mbps, pass->read_p99_us,
+               pass->errors, pass->failures, pass->seconds);
+        print_sector_classes();
+
+        if (max_seconds && (monotonic_ns() - soak_start) / 1000000000ULL >= max_seconds) {
+            break;
+        }
+    }
+
+    printf("\n=== Soak Summary (%d passes, %.1f s) ===\n", count, (monotonic_ns() - soak_start) / 1e9);
+    printf("  Pass  Generation   Write MB/s  W p50 us  W p99 us    Read MB/s  R p50 us  R p99 us    Errors  Failures\n");
+    uint64_t total_errors = 0;
+    for (int i = 0; i < count; i++) {
+        const soak_pass *p = &passes[i];
+        printf("  %4d  %10lu  %11.2f  %8lu  %8lu  %11.2f  %8lu  %8lu  %8lu  %8lu\n",
+               i + 1, p->generation, p->write_mbps, p->write_p50_us, p->write_p99_us,
+               p->read_mbps, p->read_p50_us, p->read_p99_us, p->errors, p->failures);
+        total_errors += p->errors + p->failures;
+    }
+
+    if (count >= 2) {
+        const soak_pass *first = &passes[0];
+        const soak_pass *last = &passes[count - 1];
+        printf("\nDegradation (first -> last pass, least-squares slope per pass):\n");
+        printf("  Write throughput: %+.1f%% (%+.3f MB/s per pass)\n",
+               percent_change(first->write_mbps, last->write_mbps),
+               soak_slope(passes, count, offsetof(soak_pass, write_mbps)));
+        printf("  Read throughput:  %+.1f%% (%+.3f MB/s per pass)\n",
+               percent_change(first->read_mbps, last->read_mbps),
+               soak_slope(passes, count, offsetof(soak_pass, read_mbps)));
+        printf("  Write p99: %lu us -> %lu us\n", first->write_p99_us, last->write_p99_us);
+        printf("  Read p99:  %lu us -> %lu us\n", first->read_p99_us, last->read_p99_us);
+    }
+
+    free(passes);
+    return (int)total_errors;
+}
+
+// job file 실행 상태 (job별 통계)
+typedef struct {
+    job_config cfg;
+    uint64_t start_lba;              // 범위 시작 LBA
+    uint64_t num_blocks;             // 범위 내 블록 수
+    uint64_t unit_stride;            // 0/1 = 연속, N이면 I/O k가 블록 k*N + unit_offset (한 bank 고정)
+    uint64_t unit_offset;
+    uint64_t total_ios;              // 수행할 I/O 개수
+    atomic_uint_fast64_t next_io;    // 다음에 가져갈 I/O 번호
+    atomic_uint_fast64_t completed_bytes;
+    atomic_uint_fast64_t completed_ios;
+    atomic_int errors;
+    atomic_int failures;
+    atomic_int active_threads;
+    uint64_t start_ns;
+    _Atomic uint64_t end_ns;
+    atomic_uint_fast64_t lat_buckets[SHM_STATS_LAT_BUCKETS];   // IO_TIMING 시 I/O latency 분포
+} job_state;
+
+typedef struct {
+    job_state *job;
+    int worker_id;                   // 전체 job thread 중 번호 (통계/trace slot)
+} job_worker_arg;
+
+typedef struct {
+    job_state *jobs;
+    int num_jobs;
+    atomic_bool *stop_flag;
+} job_monitor_context;
+
+#define JOB_CHUNK 64
+
+// thread별 random 블록 선택 (xorshift64*)
+static inline uint64_t job_next_random(uint64_t *state) {
+    uint64_t x = *state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *state = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+static void *job_worker(void *arg) {
+    job_worker_arg *wa = (job_worker_arg *)arg;
+    job_state *job = wa->job;
+    WORKER_ID = wa->worker_id;
+
+    uint64_t sectors_per_io = job->cfg.block_size / SECTOR_SIZE;
+    uint64_t rng = (uint64_t)time(NULL) ^ ((uint64_t)wa->worker_id << 32) ^ 0x9E3779B97F4A7C15ULL;
+
+    while (1) {
+        // CHUNK 단위로 I/O 번호를 가져감 (omp dynamic schedule과 동일한 방식)
+        uint64_t first = atomic_fetch_add(&job->next_io, JOB_CHUNK);
+        if (first >= job->total_ios) {
+            break;
+        }
+        uint64_t last = first + JOB_CHUNK < job->total_ios ? first + JOB_CHUNK : job->total_ios;
+        uint64_t timestamp = (uint64_t)time(NULL);
+
+        for (uint64_t io = first; io < last; io++) {
+            uint64_t block_idx = job->cfg.random ? job_next_random(&rng) % job->num_blocks : io;
+            if (job->unit_stride > 1) {
+                block_idx = block_idx * job->unit_stride + job->unit_offset;
+            }
+            uint64_t start_lba = job->start_lba + block_idx * sectors_per_io;
+
+            int result = job->cfg.is_write
+                ? sim_write_block(start_lba, job->cfg.block_size, timestamp)
+                : sim_read_block(start_lba, job->cfg.block_size);
+            if (result > 0) {
+                atomic_fetch_add(&job->errors, result);
+            } else if (result < 0) {
+                atomic_fetch_add(&job->failures, 1);
+            }
+            record_block_stats(job->cfg.block_size, result);
+            if (IO_TIMING && result >= 0) {
+                atomic_fetch_add_explicit(&job->lat_buckets[shm_stats_latency_bucket(io_latency_ns)], 1,
+                                          memory_order_relaxed);
+            }
+
+            atomic_fetch_add(&job->completed_bytes, job->cfg.block_size);
+            atomic_fetch_add(&job->completed_ios, 1);
+        }
+    }
+
+    // 마지막으로 끝난 thread가 job 종료 시각 기록
+    if (atomic_fetch_sub(&job->active_threads, 1) == 1) {
+        atomic_store(&job->end_ns, monotonic_ns());
+    }
+    return NULL;
+}
+
+static void *job_monitor_thread(void *arg) {
+    job_monitor_context *ctx = (job_monitor_context *)arg;
+    uint64_t last_bytes[JOB_MAX] = {0};
+    uint64_t last_phase[PHASE_COUNT] = {0};
+    if (CPU_STATS) {
+        phase_stats_totals(last_phase);
+    }
+
+    while (!atomic_load(ctx->stop_flag)) {
+        struct timespec sleep_time = {
+            .tv_sec = (time_t)MONITOR_INTERVAL,
+            .tv_nsec = (long)((MONITOR_INTERVAL - (time_t)MONITOR_INTERVAL) * 1000000000)
+        };
+        nanosleep(&sleep_time, NULL);
+
+        uint64_t interval_bytes = 0;
+        for (int j = 0; j < ctx->num_jobs; j++) {
+            job_state *job = &ctx->jobs[j];
+            uint64_t current_bytes = atomic_load(&job->completed_bytes);
+            uint64_t total_bytes = job->total_ios * job->cfg.block_size;
+            double throughput = ((current_bytes - last_bytes[j]) / (1024.0 * 1024.0)) / MONITOR_INTERVAL;
+            int progress = total_bytes ? (int)((current_bytes * 100) / total_bytes) : 100;
+            if (progress > 100) progress = 100;
+
+            printf("[%s Interval %.1fs] Throughput: %.2f MB/s | Total: %.2f MB | Progress: %d%%\n",
+                   job->cfg.name, MONITOR_INTERVAL, throughput, current_bytes / (1024.0 * 1024.0), progress);
+            interval_bytes += current_bytes - last_bytes[j];
+            last_bytes[j] = current_bytes;
+        }
+        if (CPU_STATS) {
+            // phase 시간은 thread 단위로 집계되므로 전체 job 합산
+            print_phase_interval("JOBS", last_phase, interval_bytes);
+        }
+    }
+
+    return NULL;
+}
+
+// 준비된 job들의 worker thread를 띄우고 모두 끝날 때까지 대기
+// monitor가 false면 interval 출력 없이 실행 (sweep처럼 짧은 실행을 반복할 때)
+static int launch_jobs(job_state *jobs, int num_jobs, int total_threads, uint64_t total_bytes,
+                       const char *operation, bool monitor) {
+    pthread_t *tids = calloc((size_t)total_threads, sizeof(pthread_t));
+    job_worker_arg *args = calloc((size_t)total_threads, sizeof(job_worker_arg));
+    if (tids == NULL || args == NULL) {
+        perror("calloc");
+        free(tids);
+        free(args);
+        return -1;
+    }
+
+    if (SHM_STATS) {
+        shm_stats_begin(SHM_STATS, operation, total_bytes);
+    }
+
+    atomic_bool stop_flag = false;
+    job_monitor_context ctx = { .jobs = jobs, .num_jobs = num_jobs, .stop_flag = &stop_flag };
+    pthread_t monitor_tid;
+    if (monitor) {
+        pthread_create(&monitor_tid, NULL, job_monitor_thread, &ctx);
+    }
+
+    uint64_t run_start = monotonic_ns();
+    int worker = 0;
+    for (int j = 0; j < num_jobs; j++) {
+        jobs[j].start_ns = run_start;
+        for (int t = 0; t < jobs[j].cfg.threads; t++, worker++) {
+            args[worker].job = &jobs[j];
+            args[worker].worker_id = worker;
+            pthread_create(&tids[worker], NULL, job_worker, &args[worker]);
+        }
+    }
+    for (int w = 0; w < total_threads; w++) {
+        pthread_join(tids[w], NULL);
+    }
+
+    if (monitor) {
+        atomic_store(&stop_flag, true);
+        pthread_join(monitor_tid, NULL);
+    }
+    if (SHM_STATS) {
+        shm_stats_finish(SHM_STATS);
+    }
+
+    free(tids);
+    free(args);
+    return 0;
+}
+
+// job file의 모든 job을 동시에 실행
+int run_jobs(const job_config *configs, int num_jobs) {
+    printf("\n=== Job File Run (%d jobs) ===\n", num_jobs);
+
+    job_state *jobs = calloc((size_t)num_jobs, sizeof(job_state));
+    if (jobs == NULL) {
+        perror("calloc");
+        return -1;
+    }
+
+    int total_threads = 0;
+    uint64_t total_bytes = 0;
+    for (int j = 0; j < num_jobs; j++) {
+        job_state *job = &jobs[j];
+        job->cfg = configs[j];
+        uint64_t range = job->cfg.size ? job->cfg.size : device_size - job->cfg.offset;
+        if (job->cfg.offset >= device_size || job->cfg.offset + range > device_size ||
+            range < job->cfg.block_size) {
+            printf("Error: Job '%s': range exceeds device size\n", job->cfg.name);
+            free(jobs);
+            return -1;
+        }
+        job->start_lba = job->cfg.offset / SECTOR_SIZE;
+        job->num_blocks = range / job->cfg.block_size;
+        job->total_ios = (job->cfg.random && job->cfg.ios) ? job->cfg.ios : job->num_blocks;
+        atomic_init(&job->active_threads, job->cfg.threads);
+        total_threads += job->cfg.threads;
+        total_bytes += job->total_ios * job->cfg.block_size;
+
+        printf("  %-16s %-5s %-6s offset=%lu size=%lu bs=%lu threads=%d ios=%lu\n",
+               job->cfg.name, job->cfg.is_write ? "write" : "read", job->cfg.random ? "random" : "seq",
+               job->cfg.offset, job->num_blocks * job->cfg.block_size, job->cfg.block_size,
+               job->cfg.threads, job->total_ios);
+    }
+    printf("\n");
+
+    if (launch_jobs(jobs, num_jobs, total_threads, total_bytes, "JOBS", true) != 0) {
+        free(jobs);
+        return -1;
+    }
+
+    // job별 결과
+    printf("\nJob File Run Complete:\n");
+    printf("  %-16s %-12s %10s %10s %10s %10s %10s %10s\n",
+           "Job", "Type", "MB", "Seconds", "MB/s", "IOPS", "Errors", "Failures");
+    int total_errors = 0;
+    for (int j = 0; j < num_jobs; j++) {
+        job_state *job = &jobs[j];
+        double seconds = (atomic_load(&job->end_ns) - job->start_ns) / 1e9;
+        double mb = atomic_load(&job->completed_bytes) / (1024.0 * 1024.0);
+        uint64_t ios = atomic_load(&job->completed_ios);
+        char type[16];
+        snprintf(type, sizeof(type), "%s/%s", job->cfg.is_write ? "write" : "read", job->cfg.random ? "rand" : "seq");
+        printf("  %-16s %-12s %10.2f %10.2f %10.2f %10.0f %10d %10d\n",
+               job->cfg.name, type, mb, seconds, seconds > 0 ? mb / seconds : 0.0,
+               seconds > 0 ? ios / seconds : 0.0, atomic_load(&job->errors), atomic_load(&job->failures));
+        total_errors += atomic_load(&job->errors) + atomic_load(&job->failures);
+        BYTES_PROCESSED += atomic_load(&job->completed_bytes);
+    }
+
+    free(jobs);
+    return total_errors;
+}
+
+// 파라미터 sweep (--sweep): 모든 조합을 같은 target에 대해 차례로 실행
+#define SWEEP_MAX_VALUES 16
+
+typedef struct {
+    uint64_t block_sizes[SWEEP_MAX_VALUES];
+    int num_block_sizes;
+    uint64_t threads[SWEEP_MAX_VALUES];
+    int num_threads;
+    uint64_t depths[SWEEP_MAX_VALUES];       // thread당 동시 I/O 수
+    int num_depths;
+    uint64_t regions[SWEEP_MAX_VALUES];      // byte, 0 = 디바이스 전체
+    int num_regions;
+    bool is_write;
+    bool random;
+    const char *csv_path;
+} sweep_config;
+
+typedef struct {
+    uint64_t block_size;
+    uint64_t threads;
+    uint64_t depth;
+    uint64_t region;
+    double mbps;
+    double iops;
+    uint64_t p99_us;
+    double cpu_per_gb;
+    double efficiency;               // 같은 조건의 1 thread 대비, 음수면 기준 없음
+    uint64_t errors;
+} sweep_result;
+
+static double rusage_cpu_seconds(const struct rusage *ru) {
+    return ru->ru_utime.tv_sec + ru->ru_utime.tv_usec / 1e6 + ru->ru_stime.tv_sec + ru->ru_stime.tv_usec / 1e6;
+}
+
+// 조합 하나 실행: 동기 I/O 경로이므로 queue depth는 thread당 depth개의 submitter로 구성
+static bool sweep_run_one(const sweep_config *sw, sweep_result *r) {
+    job_state *job = calloc(1, sizeof(job_state));
+    if (job == NULL) {
+        perror("calloc");
+        return false;
+    }
+    snprintf(job->cfg.name, sizeof(job->cfg.name), "sweep");
+    job->cfg.is_write = sw->is_write;
+    job->cfg.random = sw->random;
+    job->cfg.block_size = r->block_size;
+    job->cfg.threads = (int)(r->threads * r->depth);
+    job->num_blocks = r->region / r->block_size;
+    job->total_ios = job->num_blocks;
+    atomic_init(&job->active_threads, job->cfg.threads);
+
+    struct rusage before, after;
+    getrusage(RUSAGE_SELF, &before);
+    int ret = launch_jobs(job, 1, job->cfg.threads, job->total_ios * r->block_size, "SWEEP", false);
+    getrusage(RUSAGE_SELF, &after);
+
+    double seconds = (atomic_load(&job->end_ns) - job->start_ns) / 1e9;
+    uint64_t bytes = atomic_load(&job->completed_bytes);
+    uint64_t buckets[SHM_STATS_LAT_BUCKETS];
+    uint64_t ios = 0;
+    for (int b = 0; b < SHM_STATS_LAT_BUCKETS; b++) {
+        buckets[b] = atomic_load(&job->lat_buckets[b]);
+        ios += buckets[b];
+    }
+    r->mbps = seconds > 0 ? bytes / (1024.0 * 1024.0) / seconds : 0.0;
+    r->iops = seconds > 0 ? atomic_load(&job->completed_ios) / seconds : 0.0;
+    r->p99_us = latency_percentile_us(buckets, ios, 99.0);
+    r->cpu_per_gb = bytes ? (rusage_cpu_seconds(&after) - rusage_cpu_seconds(&before)) /
+                            (bytes / (1024.0 * 1024.0 * 1024.0)) : 0.0;
+    r->errors = (uint64_t)atomic_load(&job->errors) + (uint64_t)atomic_load(&job->failures);
+    r->efficiency = -1.0;
+    BYTES_PROCESSED += bytes;
+    free(job);
+    return ret == 0;
+}
+
+static void format_size(uint64_t bytes, char *out, size_t size) {
+    if (bytes >= (1ULL << 30) && bytes % (1ULL << 30) == 0) {
+        snprintf(out, size, "%luG", bytes >> 30);
+    } else if (bytes >= (1ULL << 20) && bytes % (1ULL << 20) == 0) {
+        snprintf(out, size, "%luM", bytes >> 20);
+    } else if (bytes >= 1024 && bytes % 1024 == 0) {
+        snprintf(out, size, "%luK", bytes >> 10);
+    } else {
+        snprintf(out, size, "%lu", bytes);
+    }
+}
+
+int run_sweep(const sweep_config *sw) {
+    int total = sw->num_regions * sw->num_block_sizes * sw->num_depths * sw->num_threads;
+    printf("\n=== Parameter Sweep (%d runs, %s %s) ===\n\n", total,
+           sw->is_write ? "write" : "read", sw->random ? "random" : "seq");
+
+    sweep_result *results = calloc((size_t)total, sizeof(sweep_result));
+    if (results == NULL) {
+        perror("calloc");
+        return -1;
+    }
+
+    // thread 수가 가장 빠르게 바뀌도록 나열 (같은 조건의 1 thread 결과가 먼저 나옴)
+    int n = 0;
+    for (int g = 0; g < sw->num_regions; g++) {
+        for (int b = 0; b < sw->num_block_sizes; b++) {
+            for (int d = 0; d < sw->num_depths; d++) {
+                for (int t = 0; t < sw->num_threads; t++) {
+                    sweep_result *r = &results[n++];
+                    r->block_size = sw->block_sizes[b];
+                    r->threads = sw->threads[t];
+                    r->depth = sw->depths[d];
+                    r->region = sw->regions[g] ? sw->regions[g] : device_size;
+                    if (r->region > device_size || r->region < r->block_size) {
+                        printf("Error: Region %lu does not fit block size %lu on a %lu byte device\n",
+                               r->region, r->block_size, device_size);
+                        free(results);
+                        return -1;
+                    }
+                    if (!sweep_run_one(sw, r)) {
+                        free(results);
+                        return -1;
+                    }
+                    printf("[SWEEP %d/%d] bs=%lu threads=%lu qd=%lu region=%lu: %.2f MB/s, %.0f IOPS, p99 <%luus\n",
+                           n, total, r->block_size, r->threads, r->depth, r->region, r->mbps, r->iops, r->p99_us);
+                }
+            }
+        }
+    }
+
+    // 1 thread 대비 병렬 효율 = MB/s(T) / (T * MB/s(1))
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            if (results[j].threads == 1 && results[j].block_size == results[i].block_size &&
+                results[j].depth == results[i].depth && results[j].region == results[i].region &&
+                results[j].mbps > 0) {
+                results[i].efficiency = results[i].mbps / (results[i].threads * results[j].mbps);
+                break;
+            }
+        }
+    }
+
+    printf("\nScaling Table:\n");
+    printf("  %8s %8s %6s %8s %12s %12s %10s %10s %10s %8s\n",
+           "BS", "Threads", "QD", "Region", "MB/s", "IOPS", "p99 us", "CPU s/GB", "Eff", "Errors");
+    uint64_t total_errors = 0;
+    for (int i = 0; i < n; i++) {
+        const sweep_result *r = &results[i];
+        char bs[24], region[24], eff[16];
+        format_size(r->block_size, bs, sizeof(bs));
+        format_size(r->region, region, sizeof(region));
+        if (r->efficiency >= 0) {
+            snprintf(eff, sizeof(eff), "%.1f%%", r->efficiency * 100.0);
+        } else {
+            snprintf(eff, sizeof(eff), "-");
+        }
+        printf("  %8s %8lu %6lu %8s %12.2f %12.0f %10lu %10.2f %10s %8lu\n",
+               bs, r->threads, r->depth, region, r->mbps, r->iops, r->p99_us, r->cpu_per_gb, eff, r->errors);
+        total_errors += r->errors;
+    }
+
+    if (sw->csv_path != NULL) {
+        FILE *csv = fopen(sw->csv_path, "w");
+        if (csv == NULL) {
+            perror("Failed to open sweep CSV");
+        } else {
+            fprintf(csv, "block_size,threads,queue_depth,region,mbps,iops,p99_us,cpu_s_per_gb,efficiency,errors\n");
+            for (int i = 0; i < n; i++) {
+                const sweep_result *r = &results[i];
+                fprintf(csv, "%lu,%lu,%lu,%lu,%.3f,%.1f,%lu,%.4f,", r->block_size, r->threads, r->depth,
+                        r->region, r->mbps, r->iops, r->p99_us, r->cpu_per_gb);
+                if (r->efficiency >= 0) {
+                    fprintf(csv, "%.4f", r->efficiency);
+                }
+                fprintf(csv, ",%lu\n", r->errors);
+            }
+            fclose(csv);
+            printf("\nCSV: %s\n", sw->csv_path);
+        }
+    }
+
+    free(results);
+    return (int)total_errors;
+}
+
+// bank 병렬성 측정 (--bank-test): 같은 수의 page 단위 I/O를
+// 연속 page (모든 bank에 분산) 순서와 한 bank의 page만 고른 순서로 각각 실행
+int run_bank_test(bool is_write, uint64_t bank, uint64_t threads) {
+    uint64_t page = GEOMETRY.page_size;
+    uint64_t ios = device_size / page / GEOMETRY.bank;
+    printf("\n=== Bank Parallelism (%s, %lu byte pages, %lu banks, %lu threads) ===\n\n",
+           is_write ? "write" : "read", page, GEOMETRY.bank, threads);
+    if (ios == 0) {
+        printf("Error: Device holds fewer than %lu pages\n", GEOMETRY.bank);
+        return -1;
+    }
+
+    double mbps[2] = {0};
+    uint64_t total_errors = 0;
+    printf("  %-12s %12s %12s %12s %10s %8s\n", "Order", "I/Os", "MB/s", "IOPS", "p99 us", "Errors");
+    for (int pass = 0; pass < 2; pass++) {
+        job_state *job = calloc(1, sizeof(job_state));
+        if (job == NULL) {
+            perror("calloc");
+            return -1;
+        }
+        char label[24];
+        if (pass == 0) {
+            snprintf(label, sizeof(label), "all banks");
+        } else {
+            snprintf(label, sizeof(label), "bank %lu", bank);
+            job->unit_stride = GEOMETRY.bank;
+            job->unit_offset = bank;
+        }
+        snprintf(job->cfg.name, sizeof(job->cfg.name), "%s", pass == 0 ? "BANKS" : "BANK");
+        job->cfg.is_write = is_write;
+        job->cfg.block_size = page;
+        job->cfg.threads = (int)threads;
+        job->num_blocks = ios;
+        job->total_ios = ios;
+        atomic_init(&job->active_threads, job->cfg.threads);
+
+        int ret = launch_jobs(job, 1, job->cfg.threads, ios * page, "BANKTEST", false);
+
+        double seconds = (atomic_load(&job->end_ns) - job->start_ns) / 1e9;
+        uint64_t bytes = atomic_load(&job->completed_bytes);
+        uint64_t buckets[SHM_STATS_LAT_BUCKETS];
+        uint64_t samples = 0;
+        for (int b = 0; b < SHM_STATS_LAT_BUCKETS; b++) {
+            buckets[b] = atomic_load(&job->lat_buckets[b]);
+            samples += buckets[b];
+        }
+        uint64_t errors = (uint64_t)atomic_load(&job->errors) + (uint64_t)atomic_load(&job->failures);
+        mbps[pass] = seconds > 0 ? bytes / (1024.0 * 1024.0) / seconds : 0.0;
+        printf("  %-12s %12lu %12.2f %12.0f %10lu %8lu\n", label, atomic_load(&job->completed_ios), mbps[pass],
+               seconds > 0 ? atomic_load(&job->completed_ios) / seconds : 0.0,
+               latency_percentile_us(buckets, samples, 99.0), errors);
+        total_errors += errors;
+        BYTES_PROCESSED += bytes;
+        free(job);
+        if (ret != 0) {
+            return -1;
+        }
+    }
+
+    if (mbps[1] > 0) {
+        printf("\n  Internal parallelism: %.2fx (all banks / single bank, ideal %lux)\n", mbps[0] / mbps[1], GEOMETRY.bank);
+    }
+    return (int)total_errors;
+}
+
+// block trace replay 상태 (--replay FILE)
+#define REPLAY_QUEUE_DEPTH 1024                        // reader가 미리 읽어두는 최대 entry 수
+#define REPLAY_MAX_SECTORS (JOB_MAX_BLOCK_SIZE / SECTOR_SIZE)  // 이보다 큰 entry는 나누어 수행
+
+typedef struct {
+    uint64_t seq;                    // dispatch 순서 (0이면 비어 있음)
+    uint64_t lba;
+    uint64_t sectors;
+} replay_slot;
+
+typedef struct {
+    replay_reader *reader;
+    double speed;                    // 0이면 최대 속도, 아니면 trace 시간 / speed
+    int num_threads;
+
+    // reader thread -> worker 사이의 bounded queue
+    pthread_mutex_t lock;
+    pthread_cond_t not_empty;
+    pthread_cond_t not_full;
+    pthread_cond_t slot_done;
+    replay_entry queue[REPLAY_QUEUE_DEPTH];
+    int head;
+    int count;
+    bool eof;
+    bool parse_error;
+
+    // 겹치는 LBA 범위는 trace 순서대로 수행 (worker별 처리 중인 entry)
+    replay_slot *slots;
+    uint64_t next_seq;
+
+    uint64_t origin_ns;              // trace의 첫 timestamp
+    uint64_t start_ns;               // replay 시작 시각 (CLOCK_MONOTONIC)
+
+    atomic_uint_fast64_t completed_bytes;
+    atomic_uint_fast64_t reads;
+    atomic_uint_fast64_t writes;
+    atomic_uint_fast64_t wrapped;    // device 크기에 맞게 LBA를 접은 entry 수
+    atomic_uint_fast64_t skipped;    // device보다 큰 entry
+    atomic_uint_fast64_t lag_sum_ns;
+    atomic_uint_fast64_t lag_max_ns;
+    atomic_uint_fast64_t late_ios;   // 예정 시각보다 1ms 이상 늦게 시작한 I/O
+    atomic_int errors;
+    atomic_int failures;
+} replay_state;
+
+typedef struct {
+    replay_state *state;
+    int worker_id;
+} replay_worker_arg;
+
+static void *replay_reader_thread(void *arg) {
+    replay_state *rs = (replay_state *)arg;
+    replay_entry entry;
+    int ret;
+
+    while ((ret = replay_next(rs->reader, &entry)) > 0) {
+        pthread_mutex_lock(&rs->lock);
+        while (rs->count == REPLAY_QUEUE_DEPTH) {
+            pthread_cond_wait(&rs->not_full, &rs->lock);
+        }
+        rs->queue[(rs->head + rs->count) % REPLAY_QUEUE_DEPTH] = entry;
+        rs->count++;
+        pthread_cond_signal(&rs->not_empty);
+        pthread_mutex_unlock(&rs->lock);
+    }
+
+    if (ret < 0) {
+        printf("Error: Malformed replay trace entry at %s %lu\n",
+               replay_is_binary(rs->reader) ? "record" : "line", replay_position(rs->reader));
+    }
+    pthread_mutex_lock(&rs->lock);
+    rs->eof = true;
+    rs->parse_error = ret < 0;
+    pthread_cond_broadcast(&rs->not_empty);
+    pthread_mutex_unlock(&rs->lock);
+    return NULL;
+}
+
+static bool replay_overlaps_earlier(const replay_state *rs, uint64_t seq, uint64_t lba, uint64_t sectors) {
+    for (int t = 0; t < rs->num_threads; t++) {
+        const replay_slot *s = &rs->slots[t];
+        if (s->seq != 0 && s->seq < seq && s->lba < lba + sectors && lba < s->lba + s->sectors) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// trace LBA를 대상 device 범위로 맞춤 (4KB 정렬 유지), 불가능하면 false
+static bool replay_map_lba(replay_state *rs, replay_entry *entry) {
+    if (entry->sectors > NUM_SECTOR) {
+        atomic_fetch_add(&rs->skipped, 1);
+        return false;
+    }
+    if (entry->lba + entry->sectors > NUM_SECTOR) {
+        uint64_t span = NUM_SECTOR - entry->sectors + 1;
+        entry->lba = (entry->lba % span) & ~(uint64_t)(ALIGNMENT / SECTOR_SIZE - 1);
+        atomic_fetch_add(&rs->wrapped, 1);
+    }
+    return true;
+}
+
+static void *replay_worker(void *arg) {
+    replay_worker_arg *wa = (replay_worker_arg *)arg;
+    replay_state *rs = wa->state;
+    WORKER_ID = wa->worker_id;
+    replay_slot *slot = &rs->slots[wa->worker_id];
+
+    while (1) {
+        replay_entry entry;
+
+        pthread_mutex_lock(&rs->lock);
+        while (rs->count == 0 && !rs->eof) {
+            pthread_cond_wait(&rs->not_empty, &rs->lock);
+        }
+        if (rs->count == 0) {
+            pthread_mutex_unlock(&rs->lock);
+            break;
+        }
+        entry = rs->queue[rs->head];
+        rs->head = (rs->head + 1) % REPLAY_QUEUE_DEPTH;
+        rs->count--;
+        pthread_cond_signal(&rs->not_full);
+
+        if (!replay_map_lba(rs, &entry)) {
+            pthread_mutex_unlock(&rs->lock);
+            continue;
+        }
+
+        // 먼저 dispatch된 겹치는 I/O가 끝날 때까지 대기 (write 후 read 순서 보장)
+        slot->seq = ++rs->next_seq;
+        slot->lba = entry.lba;
+        slot->sectors = entry.sectors;
+        while (replay_overlaps_earlier(rs, slot->seq, entry.lba, entry.sectors)) {
+            pthread_cond_wait(&rs->slot_done, &rs->lock);
+        }
+        pthread_mutex_unlock(&rs->lock);
+
+        // 원래 시각 (speed 배율 적용)까지 대기
+        if (rs->speed > 0.0) {
+            uint64_t rel = entry.time_ns > rs->origin_ns ? entry.time_ns - rs->origin_ns : 0;
+            uint64_t due = rs->start_ns + (uint64_t)(rel / rs->speed);
+            uint64_t now = monotonic_ns();
+            if (now < due) {
+                struct timespec ts = { .tv_sec = (time_t)(due / 1000000000ULL), .tv_nsec = (long)(due % 1000000000ULL) };
+                clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+            } else {
+                uint64_t lag = now - due;
+                atomic_fetch_add(&rs->lag_sum_ns, lag);
+                atomic_update_max(&rs->lag_max_ns, lag);
+                if (lag >= 1000000) {
+                    atomic_fetch_add(&rs->late_ios, 1);
+                }
+            }
+        }
+
+        uint64_t timestamp = (uint64_t)time(NULL);
+        for (uint64_t done = 0; done < entry.sectors; done += REPLAY_MAX_SECTORS) {
+            uint64_t sectors = entry.sectors - done < REPLAY_MAX_SECTORS ? entry.sectors - done : REPLAY_MAX_SECTORS;
+            size_t bytes = sectors * SECTOR_SIZE;
+            int result = entry.is_write
+                ? sim_write_block(entry.lba + done, bytes, timestamp)
+                : sim_read_block(entry.lba + done, bytes);
+            if (result > 0) {
+                atomic_fetch_add(&rs->errors, result);
+            } else if (result < 0) {
+                atomic_fetch_add(&rs->failures, 1);
+            }
+            record_block_stats(bytes, result);
+            atomic_fetch_add(&rs->completed_bytes, bytes);
+        }
+        atomic_fetch_add(entry.is_write ? &rs->writes : &rs->reads, 1);
+
+        pthread_mutex_lock(&rs->lock);
+        slot->seq = 0;
+        pthread_cond_broadcast(&rs->slot_done);
+        pthread_mutex_unlock(&rs->lock);
+    }
+    return NULL;
+}
+
+// trace를 streaming 하면서 재수행, write는 header를 기록하고 read는 검증
+int run_replay(const char *path, double speed, int num_threads) {
+    printf("\n=== Trace Replay ===\n");
+
+    replay_reader *reader = replay_open(path);
+    if (reader == NULL) {
+        return -1;
+    }
+
+    // 첫 entry의 timestamp를 기준 시각으로 사용
+    replay_entry first;
+    int ret = replay_next(reader, &first);
+    if (ret <= 0) {
+        printf("Error: Replay trace '%s' has no usable entries\n", path);
+        replay_close(reader);
+        return -1;
+    }
+    replay_close(reader);
+    reader = replay_open(path);
+    if (reader == NULL) {
+        return -1;
+    }
+
+    replay_state *rs = calloc(1, sizeof(replay_state));
+    replay_slot *slots = calloc((size_t)num_threads, sizeof(replay_slot));
+    pthread_t *tids = calloc((size_t)num_threads, sizeof(pthread_t));
+    replay_worker_arg *args = calloc((size_t)num_threads, sizeof(replay_worker_arg));
+    if (rs == NULL || slots == NULL || tids == NULL || args == NULL) {
+        perror("calloc");
+        free(rs);
+        free(slots);
+        free(tids);
+        free(args);
+        replay_close(reader);
+        return -1;
+    }
+
+    rs->reader = reader;
+    rs->speed = speed;
+    rs->num_threads = num_threads;
+    rs->slots = slots;
+    rs->origin_ns = first.time_ns;
+    pthread_mutex_init(&rs->lock, NULL);
+    pthread_cond_init(&rs->not_empty, NULL);
+    pthread_cond_init(&rs->not_full, NULL);
+    pthread_cond_init(&rs->slot_done, NULL);
+
+    printf("Trace: %s (%s), speed %s", path, replay_is_binary(reader) ? "binary" : "text",
+           speed > 0.0 ? "" : "max");
+    if (speed > 0.0) {
+        printf("%.2fx", speed);
+    }
+    printf(", %d threads\n\n", num_threads);
+
+    if (SHM_STATS) {
+        shm_stats_begin(SHM_STATS, "REPLAY", 0);
+    }
+
+    atomic_bool stop_flag = false;
+    monitor_context ctx = {
+        .completed_bytes = &rs->completed_bytes,
+        .stop_flag = &stop_flag,
+        .operation_name = "REPLAY",
+        .total_bytes = 0
+    };
+    pthread_t monitor_tid;
+    pthread_create(&monitor_tid, NULL, monitor_thread, &ctx);
+
+    rs->start_ns = monotonic_ns();
+    pthread_t reader_tid;
+    pthread_create(&reader_tid, NULL, replay_reader_thread, rs);
+    for (int t = 0; t < num_threads; t++) {
+        args[t].state = rs;
+        args[t].worker_id = t;
+        pthread_create(&tids[t], NULL, replay_worker, &args[t]);
+    }
+    pthread_join(reader_tid, NULL);
+    for (int t = 0; t < num_threads; t++) {
+        pthread_join(tids[t], NULL);
+    }
+    double seconds = (monotonic_ns() - rs->start_ns) / 1e9;
+
+    atomic_store(&stop_flag, true);
+    pthread_join(monitor_tid, NULL);
+    if (SHM_STATS) {
+        shm_stats_finish(SHM_STATS);
+    }
+
+    uint64_t reads = atomic_load(&rs->reads);
+    uint64_t writes = atomic_load(&rs->writes);
+    uint64_t ios = reads + writes;
+    double mb = atomic_load(&rs->completed_bytes) / (1024.0 * 1024.0);
+    printf("\nTrace Replay Complete:\n");
+    printf("  I/Os: %lu (%lu reads, %lu writes), %.2f MB in %.2f s\n", ios, reads, writes, mb, seconds);
+    printf("  Throughput: %.2f MB/s, %.0f IOPS\n", seconds > 0 ? mb / seconds : 0.0, seconds > 0 ? ios / seconds : 0.0);
+    if (speed > 0.0) {
+        printf("  Schedule lag: avg %.1f us, max %.1f us, %lu I/Os late by >= 1 ms\n",
+               ios ? atomic_load(&rs->lag_sum_ns) / 1e3 / ios : 0.0, atomic_load(&rs->lag_max_ns) / 1e3,
+               atomic_load(&rs->late_ios));
+    }
+    if (atomic_load(&rs->wrapped) || atomic_load(&rs->skipped)) {
+        printf("  Remapped: %lu entries wrapped into device range, %lu larger than device skipped\n",
+               atomic_load(&rs->wrapped), atomic_load(&rs->skipped));
+    }
+    printf("  Sector errors: %d\n", atomic_load(&rs->errors));
+    printf("  I/O failures: %d\n", atomic_load(&rs->failures));
+    BYTES_PROCESSED += atomic_load(&rs->completed_bytes);
+
+    int result = atomic_load(&rs->errors) + atomic_load(&rs->failures) + (rs->parse_error ? 1 : 0);
+    pthread_mutex_destroy(&rs->lock);
+    pthread_cond_destroy(&rs->not_empty);
+    pthread_cond_destroy(&rs->not_full);
+    pthread_cond_destroy(&rs->slot_done);
+    replay_close(reader);
+    free(slots);
+    free(tids);
+    free(args);
+    free(rs);
+    return result;
+}
+
+// discard 방식 (--discard-mode)
+typedef enum {
+    DISCARD_TRIM = 0,   // BLKDISCARD, 파일은 punch hole
+    DISCARD_ZEROOUT,    // BLKZEROOUT, 파일은 zero range
+} discard_mode;
+
+static int issue_discard(discard_mode mode, uint64_t offset, uint64_t length) {
+    if (DEVICE_IS_FILE) {
+        int flags = mode == DISCARD_TRIM ? FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE
+                                         : FALLOC_FL_ZERO_RANGE | FALLOC_FL_KEEP_SIZE;
+        return fallocate(fv_fd(TARGET), flags, (off_t)offset, (off_t)length);
+    }
+    uint64_t range[2] = { offset, length };
+    return ioctl(fv_fd(TARGET), mode == DISCARD_TRIM ? BLKDISCARD : BLKZEROOUT, range);
+}
+
+// --discard-fraction: seed로 결정되는 extent 선택 (같은 seed면 같은 extent)
+static bool discard_selected(uint64_t extent_idx, double fraction) {
+    if (fraction >= 1.0) {
+        return true;
+    }
+    uint64_t h = (extent_idx + 1) * 0x9E3779B97F4A7C15ULL ^ PAYLOAD_SEED_VALUE;
+    double u = (double)(job_next_random(&h) >> 11) * (1.0 / 9007199254740992.0);
+    return u < fraction;
+}
+
+// extent 단위 discard 후 읽어서 0/결정적 패턴인지 확인
+int run_discard(discard_mode mode, uint64_t extent_size, double fraction) {
+    const char *mode_name = DEVICE_IS_FILE ? (mode == DISCARD_TRIM ? "punch-hole" : "zero-range")
+                                           : (mode == DISCARD_TRIM ? "BLKDISCARD" : "BLKZEROOUT");
+    uint64_t num_extents = device_size / extent_size;
+    printf("\n=== Discard Test (%s, extent %lu bytes, %.0f%% of %lu extents) ===\n\n",
+           mode_name, extent_size, fraction * 100.0, num_extents);
+
+    atomic_uint_fast64_t completed_bytes = 0;
+    atomic_uint_fast64_t discarded_extents = 0;
+    atomic_uint_fast64_t lat_buckets[SHM_STATS_LAT_BUCKETS] = {0};
+    atomic_uint_fast64_t lat_max_ns = 0;
+    atomic_int failures = 0;
+    atomic_bool stop_flag = false;
+
+    monitor_context ctx = {
+        .completed_bytes = &completed_bytes,
+        .stop_flag = &stop_flag,
+        .operation_name = "DISCARD",
+        .total_bytes = (uint64_t)(num_extents * fraction) * extent_size
+    };
+    if (SHM_STATS) {
+        shm_stats_begin(SHM_STATS, "DISCARD", ctx.total_bytes);
+    }
+    pthread_t monitor_tid;
+    pthread_create(&monitor_tid, NULL, monitor_thread, &ctx);
+
+    uint64_t run_start = monotonic_ns();
+    #pragma omp parallel for schedule(dynamic, 16)
+    for (uint64_t e = 0; e < num_extents; e++) {
+        if (!discard_selected(e, fraction)) {
+            continue;
+        }
+        uint64_t offset = e * extent_size;
+        uint64_t start = monotonic_ns();
+        int ret = issue_discard(mode, offset, extent_size);
+        io_latency_ns = monotonic_ns() - start;
+
+        if (ret != 0) {
+            printf("Error: %s failed at offset %lu: %s\n", mode_name, offset, strerror(errno));
+            atomic_fetch_add(&failures, 1);
+        } else {
+            atomic_fetch_add(&discarded_extents, 1);
+            atomic_fetch_add(&completed_bytes, extent_size);
+            atomic_fetch_add(&lat_buckets[shm_stats_latency_bucket(io_latency_ns)], 1);
+            atomic_update_max(&lat_max_ns, io_latency_ns);
+            if (TRIM_MAP.bits != NULL) {
+                trim_map_mark(&TRIM_MAP, offset / SECTOR_SIZE, extent_size / SECTOR_SIZE);
+            }
+            if (JOURNAL != NULL) {
+                write_journal_append(JOURNAL, worker_index(), offset / SECTOR_SIZE, extent_size / SECTOR_SIZE);
+            }
+        }
+        record_block_stats(extent_size, ret != 0 ? -1 : 0);
+    }
+    double seconds = (monotonic_ns() - run_start) / 1e9;
+
+    atomic_store(&stop_flag, true);
+    pthread_join(monitor_tid, NULL);
+    BYTES_PROCESSED += atomic_load(&completed_bytes);
+    if (SHM_STATS) {
+        shm_stats_finish(SHM_STATS);
+    }
+
+    uint64_t extents = atomic_load(&discarded_extents);
+    double mb = atomic_load(&completed_bytes) / (1024.0 * 1024.0);
+    uint64_t buckets[SHM_STATS_LAT_BUCKETS];
+    for (int b = 0; b < SHM_STATS_LAT_BUCKETS; b++) {
+        buckets[b] = atomic_load(&lat_buckets[b]);
+    }
+    printf("\nDiscard Complete:\n");
+    printf("  Extents: %lu (%.2f MB) in %.2f s, %.2f MB/s, %.0f ops/s\n", extents, mb, seconds,
+           seconds > 0 ? mb / seconds : 0.0, seconds > 0 ? extents / seconds : 0.0);
+    printf("  Failures: %d\n", atomic_load(&failures));
+    print_latency_histogram("Discard", buckets, atomic_load(&lat_max_ns));
+
+    // post-trim 검증: zeroout은 0, discard는 0 또는 섹터 내 균일 패턴이어야 함
+    printf("\nVerifying discarded extents...\n");
+    atomic_uint_fast64_t zero_sectors = 0;
+    atomic_uint_fast64_t pattern_sectors = 0;
+    atomic_uint_fast64_t stale_sectors = 0;
+    atomic_uint_fast64_t other_sectors = 0;
+    atomic_int read_failures = 0;
+
+    #pragma omp parallel for schedule(dynamic, 16)
+    for (uint64_t e = 0; e < num_extents; e++) {
+        if (!discard_selected(e, fraction)) {
+            continue;
+        }
+        for (uint64_t off = 0; off < extent_size; off += IO_BLOCK_SIZE) {
+            size_t len = extent_size - off < IO_BLOCK_SIZE ? extent_size - off : IO_BLOCK_SIZE;
+            unsigned char *block = thread_io_buffer(len);
+            // discard는 target fd에 직접 하지만 결과는 선택된 engine 경로로 읽어 확인
+            if (block == NULL || backend_transfer(false, block, len, e * extent_size + off) != (ssize_t)len) {
+                atomic_fetch_add(&read_failures, 1);
+                continue;
+            }
+            uint64_t zero = 0, pattern = 0, stale = 0, other = 0;
+            for (size_t i = 0; i < len; i += SECTOR_SIZE) {
+                const unsigned char *sector = block + i;
+                if (fv_sector_is_uniform(sector)) {
+                    if (sector[0] == 0) {
+                        zero++;
+                    } else {
+                        pattern++;
+                    }
+                } else if (((const verify_header *)sector)->magic == VERIFY_MAGIC) {
+                    stale++;
+                } else {
+                    other++;
+                }
+            }
+            atomic_fetch_add(&zero_sectors, zero);
+            atomic_fetch_add(&pattern_sectors, pattern);
+            atomic_fetch_add(&stale_sectors, stale);
+            atomic_fetch_add(&other_sectors, other);
+        }
+    }
+
+    uint64_t stale = atomic_load(&stale_sectors);
+    uint64_t other = atomic_load(&other_sectors);
+    uint64_t pattern = atomic_load(&pattern_sectors);
+    printf("  Zero sectors: %lu\n", atomic_load(&zero_sectors));
+    printf("  Deterministic pattern sectors: %lu\n", pattern);
+    printf("  Stale header sectors: %lu\n", stale);
+    printf("  Other data sectors: %lu\n", other);
+    printf("  Read failures: %d blocks\n", atomic_load(&read_failures));
+
+    // zeroout은 0만 허용
+    uint64_t bad = stale + other + (mode == DISCARD_ZEROOUT ? pattern : 0);
+    if (bad) {
+        printf("  [ERROR] %lu sectors did not read back as %s after %s\n", bad,
+               mode == DISCARD_ZEROOUT ? "zeroes" : "zeroes or a deterministic pattern", mode_name);
+    }
+    return (int)bad + atomic_load(&failures) + atomic_load(&read_failures);
+}
+
+// 마지막 flush 이전에 완료된 write가 모두 읽히는지 확인
+// header가 없거나 write_start 이전 timestamp인 섹터는 write가 유실된 것
+int verify_after_flush(time_t write_start) {
+    uint64_t durable = WRITE_DSYNC ? UINT64_MAX : atomic_load(&DURABLE_EPOCH);
+    printf("\n=== Verify After Flush ===\n");
+
+    atomic_uint_fast64_t checked_blocks = 0;
+    atomic_uint_fast64_t pending_blocks = 0;
+    atomic_uint_fast64_t lost_sectors = 0;
+    atomic_int errors = 0;
+    atomic_int read_failures = 0;
+
+    #pragma omp parallel for schedule(dynamic, CHUNK)
+    for (uint64_t block_idx = 0; block_idx < NUM_BLOCKS; block_idx++) {
+        uint64_t epoch = atomic_load_explicit(&BLOCK_EPOCH[block_idx], memory_order_relaxed);
+        if (epoch == 0) {
+            continue;
+        }
+        if (epoch > durable) {
+            atomic_fetch_add(&pending_blocks, 1);
+            continue;
+        }
+
+        uint64_t start_lba = block_idx * SECTORS_PER_BLOCK;
+        unsigned char *block = thread_io_buffer(IO_BLOCK_SIZE);
+        if (block == NULL || backend_transfer(false, block, IO_BLOCK_SIZE, start_lba * SECTOR_SIZE) != (ssize_t)IO_BLOCK_SIZE) {
+            atomic_fetch_add(&read_failures, 1);
+            continue;
+        }
+        atomic_fetch_add(&checked_blocks, 1);
+
+        int block_errors = verify_block(block, start_lba, SECTORS_PER_BLOCK);
+        if (block_errors > 0) {
+            atomic_fetch_add(&errors, block_errors);
+        }
+
+        // dedupe unit은 header가 없으므로 verify_block 결과만 사용
+        uint64_t lost = 0;
+        for (uint64_t i = 0; i < SECTORS_PER_BLOCK; i++) {
+            if (fv_dedupe_slot(TARGET, start_lba + i) >= 0) {
+                continue;
+            }
+            const verify_header *header = (const verify_header *)(block + i * SECTOR_SIZE);
+            if (header->magic != VERIFY_MAGIC || header->timestamp < (uint64_t)write_start) {
+                if (lost == 0) {
+                    printf("[ERROR] Lost write at LBA=%lu: acknowledged before flush, %s\n", start_lba + i,
+                           header->magic != VERIFY_MAGIC ? "no header" : "older timestamp");
+                }
+                lost++;
+            }
+        }
+        atomic_fetch_add(&lost_sectors, lost);
+    }
+
+    if (WRITE_DSYNC) {
+        printf("  Blocks verified: %lu (RWF_DSYNC: durable on completion)\n", atomic_load(&checked_blocks));
+    } else {
+        printf("  Blocks verified: %lu (durable epoch %lu)\n", atomic_load(&checked_blocks), durable);
+    }
+    printf("  Blocks written after last flush (not checked): %lu\n", atomic_load(&pending_blocks));
+    if (atomic_load(&UNTRACKED_WRITES)) {
+        printf("  Writes not aligned to %lu-byte blocks (not checked): %lu\n", IO_BLOCK_SIZE, atomic_load(&UNTRACKED_WRITES));
+    }
+    printf("  Sector errors: %d\n", atomic_load(&errors));
+    printf("  Lost sectors: %lu\n", atomic_load(&lost_sectors));
+    printf("  Read failures: %d blocks\n", atomic_load(&read_failures));
+    return atomic_load(&errors) + (int)atomic_load(&lost_sectors) + atomic_load(&read_failures);
+}
+
+// page cache engine의 적중률과 page fault
+static void print_engine_report(const struct rusage *start) {
+    struct rusage now;
+    getrusage(RUSAGE_SELF, &now);
+    printf("\n=== Engine Report (%s) ===\n", IO_ENGINE);
+
+    io_cache_stats cache;
+    if (io_backend_cache_stats(BACKEND, &cache) && cache.read_pages) {
+        printf("  Page cache: %lu of %lu read pages resident (%.1f%% hit rate)\n",
+               cache.cached_pages, cache.read_pages, 100.0 * cache.cached_pages / cache.read_pages);
+    }
+    printf("  Page faults: %ld major, %ld minor\n",
+           now.ru_majflt - start->ru_majflt, now.ru_minflt - start->ru_minflt);
+}
+
+// 주입된 fault와 retry 결과 요약
+static void print_fault_report(bool injected) {
+    printf("\n=== I/O Fault Report ===\n");
+    if (injected) {
+        fault_backend_stats stats;
+        io_backend_fault_stats(BACKEND, &stats);
+        printf("  Injected: %lu EIO, %lu short transfers, %lu latency spikes\n",
+               stats.eio, stats.short_io, stats.delayed);
+    }
+    printf("  Retries: %lu attempts, %lu I/Os recovered, %lu I/Os failed after %lu retries\n",
+           atomic_load(&RETRY_ATTEMPTS), atomic_load(&RETRY_RECOVERED), atomic_load(&RETRY_EXHAUSTED), IO_RETRIES);
+}
+
+// SSD emulator의 write amplification, GC, wear 요약
+static void print_ssd_report(void) {
+    ssd_stats stats;
+    io_backend_ssd_stats(SSD_BACKEND, &stats);
+    printf("\n=== SSD Emulator Report ===\n");
+    printf("  Host pages: %lu read, %lu programmed\n", stats.host_reads, stats.host_programs);
+    if (stats.host_programs) {
+        printf("  GC: %lu runs, %lu valid pages copied, WAF %.3f\n", stats.gc_runs, stats.gc_copies,
+               (double)(stats.host_programs + stats.gc_copies) / stats.host_programs);
+    } else {
+        printf("  GC: %lu runs, %lu valid pages copied\n", stats.gc_runs, stats.gc_copies);
+    }
+    printf("  GC stalls: %lu host page ops, %.3f ms waited\n", stats.stalled_ops, stats.stall_ns / 1e6);
+    printf("  Erases: %lu (per block min %lu, max %lu), %lu free blocks\n",
+           stats.erases, stats.min_erase, stats.max_erase, stats.free_blocks);
+}
+
+// durability 설정과 flush latency 요약
+static void print_durability_report(void) {
+    printf("\n=== Durability ===\n");
+    if (WRITE_DSYNC) {
+        printf("  Writes: RWF_DSYNC\n");
+    }
+    if (FLUSH_EVERY) {
+        printf("  Flush: fdatasync every %lu writes\n", FLUSH_EVERY);
+    }
+    if (FLUSH_INTERVAL_MS) {
+        printf("  Flush: fdatasync every %lu ms\n", FLUSH_INTERVAL_MS);
+    }
+    printf("  Flushes: %lu (%lu failed)\n", atomic_load(&FLUSH_COUNT), atomic_load(&FLUSH_FAILURES));
+    if (atomic_load(&FLUSH_COUNT)) {
+        uint64_t buckets[SHM_STATS_LAT_BUCKETS];
+        for (int b = 0; b < SHM_STATS_LAT_BUCKETS; b++) {
+            buckets[b] = atomic_load(&FLUSH_LAT_BUCKETS[b]);
+        }
+        print_latency_histogram("Flush", buckets, atomic_load(&FLUSH_LAT_MAX_NS));
+    }
+}
+
+// corruption 주입 대상 선택용 hash (seed, LBA, salt로 결정)
+#define FAULT_SALT 0xC2B2AE3D27D4EB4FULL
+
+static inline uint64_t fault_hash(uint64_t lba, uint64_t salt) {
+    uint64_t h = (lba + 1) * 0x9E3779B97F4A7C15ULL ^ PAYLOAD_SEED_VALUE ^ FAULT_SALT ^ salt;
+    return job_next_random(&h);
+}
+
+static inline double fault_uniform(uint64_t lba, uint64_t salt) {
+    return (double)(fault_hash(lba, salt) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// thread별 manifest record 버퍼
+typedef struct {
+    fault_record *records;
+    size_t count;
+    size_t capacity;
+} fault_buffer;
+
+static bool fault_append(fault_buffer *buf, uint64_t lba, fault_type type, uint32_t detail) {
+    if (buf->count == buf->capacity) {
+        size_t capacity = buf->capacity ? buf->capacity * 2 : 1024;
+        fault_record *records = realloc(buf->records, capacity * sizeof(fault_record));
+        if (records == NULL) {
+            return false;
+        }
+        buf->records = records;
+        buf->capacity = capacity;
+    }
+    buf->records[buf->count++] = (fault_record){ .lba = lba, .type = type, .detail = detail };
+    return true;
+}
+
+// misdirect 교환 상대: header가 있는 섹터끼리만 (dedupe/unwritten 섹터와 바꾸면 원래 자리는 unwritten으로 보임)
+// 이미 fault를 준 섹터와 바꾸면 manifest에 한 섹터가 두 번 기록되므로 제외
+static bool misdirect_partner_ok(const unsigned char *block, uint64_t start_lba, uint64_t j, const uint64_t *touched) {
+    const verify_header *header = (const verify_header *)(block + j * SECTOR_SIZE);
+    return !(touched[j / 64] & (1ULL << (j % 64))) && header->magic == VERIFY_MAGIC &&
+           fv_dedupe_slot(TARGET, start_lba + j) < 0;
+}
+
+// 선택된 섹터 하나에 fault 적용, 적용한 type 반환 (misdirect는 partner도 변경)
+// 교환할 partner가 없으면 FAULT_TYPE_COUNT (적용 안 함), touched는 이 블록에서 이미 fault를 준 섹터
+static fault_type apply_fault(unsigned char *block, uint64_t start_lba, uint64_t i, const uint64_t *touched,
+                              uint64_t *partner) {
+    uint64_t lba = start_lba + i;
+    unsigned char *sector = block + i * SECTOR_SIZE;
+    verify_header *header = (verify_header *)sector;
+
+    // 활성화된 type 중 하나를 선택
+    int enabled = __builtin_popcount(CORRUPT_TYPES);
+    int pick = (int)(fault_hash(lba, 1) % (uint64_t)enabled);
+    int type = 0;
+    for (; type < FAULT_TYPE_COUNT; type++) {
+        if ((CORRUPT_TYPES & (1u << type)) && pick-- == 0) {
+            break;
+        }
+    }
+
+    switch (type) {
+        case FAULT_BITFLIP: {
+            uint64_t bit = fault_hash(lba, 2) % ((SECTOR_SIZE - sizeof(verify_header)) * 8);
+            sector[sizeof(verify_header) + bit / 8] ^= (unsigned char)(1u << (bit % 8));
+            *partner = bit;
+            break;
+        }
+        case FAULT_TORN: {
+            // 뒤쪽 절반만 다음 generation 데이터로 바뀐 상태
+            unsigned char other[SECTOR_SIZE];
+            fv_fill_sector(TARGET, other, lba, header->timestamp, PAYLOAD_GENERATION + 1);
+            memcpy(sector + SECTOR_SIZE / 2, other + SECTOR_SIZE / 2, SECTOR_SIZE / 2);
+            break;
+        }
+        case FAULT_STALE:
+            // 이전 generation으로 완전하게 쓰여진 섹터 (CRC는 일치함, generation >= 1은 옵션 검사에서 보장)
+            fv_fill_sector(TARGET, sector, lba, header->timestamp, PAYLOAD_GENERATION - 1);
+            break;
+        case FAULT_MISDIRECT: {
+            // 같은 블록의 다른 섹터와 내용 교환 (다른 LBA로 간 write)
+            uint64_t j = (i + 1 + fault_hash(lba, 3) % (SECTORS_PER_BLOCK - 1)) % SECTORS_PER_BLOCK;
+            for (uint64_t k = 1; k < SECTORS_PER_BLOCK - 1 && !misdirect_partner_ok(block, start_lba, j, touched); k++) {
+                j = (j + 1) % SECTORS_PER_BLOCK;
+                j = j == i ? (j + 1) % SECTORS_PER_BLOCK : j;
+            }
+            if (!misdirect_partner_ok(block, start_lba, j, touched)) {
+                return FAULT_TYPE_COUNT;
+            }
+            unsigned char tmp[SECTOR_SIZE];
+            memcpy(tmp, sector, SECTOR_SIZE);
+            memcpy(sector, block + j * SECTOR_SIZE, SECTOR_SIZE);
+            memcpy(block + j * SECTOR_SIZE, tmp, SECTOR_SIZE);
+            *partner = j;
+            break;
+        }
+        default:
+            memset(sector, 0, SECTOR_SIZE);
+            break;
+    }
+    return (fault_type)type;
+}
+
+// 전체 device에 seed 기반 corruption을 병렬 주입하고 manifest 기록
+int run_injection(void) {
+    printf("\n=== Corruption Injection (rate %g, seed %lu) ===\n", CORRUPT_RATE, PAYLOAD_SEED_VALUE);
+    printf("Types:");
+    for (int t = 0; t < FAULT_TYPE_COUNT; t++) {
+        if (CORRUPT_TYPES & (1u << t)) {
+            printf(" %s", fault_type_name((fault_type)t));
+        }
+    }
+    printf("\n\n");
+
+    int max_threads = omp_get_max_threads();
+    fault_buffer *buffers = calloc((size_t)max_threads, sizeof(fault_buffer));
+    if (buffers == NULL) {
+        perror("calloc");
+        return -1;
+    }
+    atomic_uint_fast64_t touched_blocks = 0;
+    atomic_uint_fast64_t skipped_sectors = 0;
+    atomic_int failures = 0;
+    atomic_bool aborted = false;   // manifest record를 남기지 못하면 이후 블록은 건드리지 않음
+    uint64_t run_start = monotonic_ns();
+
+    #pragma omp parallel for schedule(dynamic, CHUNK)
+    for (uint64_t block_idx = 0; block_idx < NUM_BLOCKS; block_idx++) {
+        if (atomic_load_explicit(&aborted, memory_order_relaxed)) {
+            continue;
+        }
+        uint64_t start_lba = block_idx * SECTORS_PER_BLOCK;
+
+        // I/O 없이 hash만으로 대상 섹터 선택
+        uint64_t selected[JOB_MAX_BLOCK_SIZE / SECTOR_SIZE / 64] = {0};
+        bool any = false;
+        for (uint64_t i = 0; i < SECTORS_PER_BLOCK; i++) {
+            // dedupe unit은 header가 없어 manifest 종류별 판정을 할 수 없으므로 제외
+            if (fault_uniform(start_lba + i, 0) < CORRUPT_RATE && fv_dedupe_slot(TARGET, start_lba + i) < 0) {
+                selected[i / 64] |= 1ULL << (i % 64);
+                any = true;
+            }
+        }
+        if (!any) {
+            continue;
+        }
+
+        // 선택된 engine/wrapper backend를 거쳐 원본 블록을 읽고 다시 씀
+        unsigned char *block = thread_io_buffer(IO_BLOCK_SIZE);
+        uint64_t offset = start_lba * SECTOR_SIZE;
+        if (block == NULL || backend_transfer(false, block, IO_BLOCK_SIZE, offset) != (ssize_t)IO_BLOCK_SIZE) {
+            atomic_fetch_add(&failures, 1);
+            continue;
+        }
+
+        fault_buffer *buf = &buffers[omp_get_thread_num()];
+        size_t recorded = buf->count;
+        uint64_t touched[JOB_MAX_BLOCK_SIZE / SECTOR_SIZE / 64] = {0};
+        bool modified = false;
+        for (uint64_t i = 0; i < SECTORS_PER_BLOCK; i++) {
+            if (!(selected[i / 64] & (1ULL << (i % 64))) || (touched[i / 64] & (1ULL << (i % 64)))) {
+                continue;
+            }
+            // write된 적 없는 섹터는 검출 대상이 아니므로 제외
+            if (((verify_header *)(block + i * SECTOR_SIZE))->magic != VERIFY_MAGIC) {
+                atomic_fetch_add(&skipped_sectors, 1);
+                continue;
+            }
+            uint64_t detail = 0;
+            fault_type type = apply_fault(block, start_lba, i, touched, &detail);
+            if (type == FAULT_TYPE_COUNT) {
+                continue;
+            }
+            touched[i / 64] |= 1ULL << (i % 64);
+            if (type == FAULT_MISDIRECT) {
+                touched[detail / 64] |= 1ULL << (detail % 64);
+            }
+            bool appended = fault_append(buf, start_lba + i, type, (uint32_t)detail) &&
+                            (type != FAULT_MISDIRECT || fault_append(buf, start_lba + detail, type, (uint32_t)i));
+            if (!appended) {
+                // 기록하지 못한 fault가 device에 남지 않도록 이 블록은 쓰지 않고 record도 되돌림
+                buf->count = recorded;
+                atomic_store(&aborted, true);
+                modified = false;
+                break;
+            }
+            modified = true;
+        }
+
+        if (modified) {
+            if (backend_transfer(true, block, IO_BLOCK_SIZE, offset) != (ssize_t)IO_BLOCK_SIZE) {
+                atomic_fetch_add(&failures, 1);
+                continue;
+            }
+            atomic_fetch_add(&touched_blocks, 1);
+        }
+    }
+    double seconds = (monotonic_ns() - run_start) / 1e9;
+
+    // thread별 record 병합 후 저장
+    uint64_t total = 0;
+    for (int t = 0; t < max_threads; t++) {
+        total += buffers[t].count;
+    }
+    fault_record *records = malloc((total ? total : 1) * sizeof(fault_record));
+    uint64_t per_type[FAULT_TYPE_COUNT] = {0};
+    uint64_t n = 0;
+    for (int t = 0; t < max_threads; t++) {
+        for (size_t r = 0; records != NULL && r < buffers[t].count; r++) {
+            records[n++] = buffers[t].records[r];
+            per_type[buffers[t].records[r].type]++;
+        }
+        free(buffers[t].records);
+    }
+    free(buffers);
+    if (records == NULL) {
+        perror("malloc");
+        return -1;
+    }
+
+    printf("Injection Complete:\n");
+    printf("  Corrupted sectors: %lu in %lu blocks (%.2f s)\n", total, atomic_load(&touched_blocks), seconds);
+    for (int t = 0; t < FAULT_TYPE_COUNT; t++) {
+        if (CORRUPT_TYPES & (1u << t)) {
+            printf("    %-10s %lu\n", fault_type_name((fault_type)t), per_type[t]);
+        }
+    }
+    printf("  Skipped unwritten sectors: %lu\n", atomic_load(&skipped_sectors));
+    printf("  I/O failures: %d blocks\n", atomic_load(&failures));
+    if (atomic_load(&aborted)) {
+        printf("Error: Out of memory while recording faults, injection stopped early\n");
+    }
+
+    if (MANIFEST_PATH != NULL) {
+        fault_manifest_header header = {
+            .type_mask = CORRUPT_TYPES,
+            .seed = PAYLOAD_SEED_VALUE,
+            .count = total,
+            .rate = CORRUPT_RATE
+        };
+        if (fault_manifest_save(MANIFEST_PATH, &header, records)) {
+            printf("  Manifest: %s\n", MANIFEST_PATH);
+        }
+    }
+    free(records);
+    return atomic_load(&failures) + (atomic_load(&aborted) ? 1 : 0);
+}
+
+// manifest 기준 검출률과 검출까지 걸린 시간
+static void print_detection_report(void) {
+    uint64_t injected[FAULT_TYPE_COUNT] = {0};
+    uint64_t detected[FAULT_TYPE_COUNT] = {0};
+    uint64_t ttd_sum[FAULT_TYPE_COUNT] = {0};
+    uint64_t ttd_max[FAULT_TYPE_COUNT] = {0};
+
+    for (uint64_t r = 0; r < MANIFEST.header.count; r++) {
+        uint32_t type = MANIFEST.records[r].type < FAULT_TYPE_COUNT ? MANIFEST.records[r].type : FAULT_ZERO;
+        uint64_t when = atomic_load_explicit(&MANIFEST.detect_ns[r], memory_order_relaxed);
+        injected[type]++;
+        if (when) {
+            detected[type]++;
+            ttd_sum[type] += when - 1;
+            if (when - 1 > ttd_max[type]) {
+                ttd_max[type] = when - 1;
+            }
+        }
+    }
+
+    printf("\n=== Detection Report (%s) ===\n", MANIFEST_PATH);
+    printf("  %-10s %10s %10s %8s %12s %12s\n", "Type", "Injected", "Detected", "Recall", "TTD avg(s)", "TTD max(s)");
+    uint64_t all_injected = 0, all_detected = 0;
+    for (int t = 0; t < FAULT_TYPE_COUNT; t++) {
+        if (injected[t] == 0) {
+            continue;
+        }
+        printf("  %-10s %10lu %10lu %7.1f%% %12.3f %12.3f\n", fault_type_name((fault_type)t),
+               injected[t], detected[t], 100.0 * detected[t] / injected[t],
+               detected[t] ? ttd_sum[t] / 1e9 / detected[t] : 0.0, ttd_max[t] / 1e9);
+        all_injected += injected[t];
+        all_detected += detected[t];
+    }
+    printf("  %-10s %10lu %10lu %7.1f%%\n", "total", all_injected, all_detected,
+           all_injected ? 100.0 * all_detected / all_injected : 0.0);
+    printf("  False positives: %lu sectors flagged outside the manifest\n", atomic_load(&FALSE_POSITIVES));
+}
+
+// forensics 분석 중 misdirected write의 target 섹터를 다시 읽음
+static bool forensic_read(uint64_t lba, fv_sector_info *info, void *user) {
+    (void)user;
+    uint64_t unit_sectors = ALIGNMENT / SECTOR_SIZE;
+    uint64_t start = lba / unit_sectors * unit_sectors;
+    if ((start + unit_sectors) * SECTOR_SIZE > device_size) {
+        return false;
+    }
+    unsigned char *buf = thread_io_buffer(ALIGNMENT);
+    if (buf == NULL || backend_transfer(false, buf, ALIGNMENT, start * SECTOR_SIZE) != ALIGNMENT) {
+        return false;
+    }
+    fv_inspect_sector(TARGET, buf + (lba - start) * SECTOR_SIZE, info);
+    return true;
+}
+
+static const char *FV_ERROR_NAMES[] = {
+    "io", "lba", "offset", "checksum", "seed-tag", "payload", "dedupe", "trim-stale", "trim-data", "generation"
+};
+
+#define FORENSIC_DETAIL_LINES 20
+
+// 에러 분류 결과, manifest가 있으면 주입한 fault 종류별 분류표
+static void print_forensics_report(void) {
+    uint64_t counts[FORENSIC_CLASS_COUNT];
+    forensic_classify(&FORENSIC_LOG, PAYLOAD_GENERATION, forensic_read, NULL, counts);
+
+    uint64_t derived = 0;
+    for (uint64_t i = 0; i < FORENSIC_LOG.count; i++) {
+        derived += FORENSIC_LOG.records[i].derived;
+    }
+    printf("\n=== Forensics Report ===\n");
+    printf("  Error sectors analysed: %lu (+%lu misdirect targets found by re-reading)\n",
+           FORENSIC_LOG.count - derived, derived);
+    printf("  Reverse map memory: %.1f KB\n", FORENSIC_LOG.capacity * sizeof(forensic_record) / 1024.0);
+    if (FORENSIC_LOG.overflow) {
+        printf("  Warning: out of memory, some error sectors were not analysed\n");
+    }
+    for (int c = 0; c < FORENSIC_CLASS_COUNT; c++) {
+        printf("  %-12s %10lu\n", forensic_class_name((forensic_class)c), counts[c]);
+    }
+
+    uint64_t shown = 0;
+    for (uint64_t i = 0; i < FORENSIC_LOG.count && shown < FORENSIC_DETAIL_LINES; i++, shown++) {
+        const forensic_record *r = &FORENSIC_LOG.records[i];
+        printf("  LBA %-12lu %-12s ", r->lba, forensic_class_name(r->cls));
+        switch (r->cls) {
+            case FORENSIC_MISDIRECTED:
+                printf("holds data for LBA %lu", r->header_lba);
+                break;
+            case FORENSIC_LOST_WRITE:
+                if (r->peer != FORENSIC_NO_PEER) {
+                    printf("its data was written to LBA %lu", r->peer);
+                } else {
+                    printf("no header");
+                }
+                break;
+            case FORENSIC_STALE:
+                if (r->generation_known) {
+                    printf("intact generation %lu (current %lu)", r->generation, PAYLOAD_GENERATION);
+                } else {
+                    printf("intact data of an unknown earlier generation");
+                }
+                break;
+            default:
+                printf("%s mismatch", r->kind < sizeof(FV_ERROR_NAMES) / sizeof(FV_ERROR_NAMES[0])
+                                      ? FV_ERROR_NAMES[r->kind] : "unknown");
+                break;
+        }
+        printf("%s\n", r->derived ? " (not flagged by verify)" : "");
+    }
+    if (FORENSIC_LOG.count > shown) {
+        printf("  ... %lu more\n", FORENSIC_LOG.count - shown);
+    }
+
+    if (MANIFEST.records == NULL) {
+        return;
+    }
+    // 주입한 fault 종류 (행) x 분류 결과 (열)
+    uint64_t matrix[FAULT_TYPE_COUNT + 1][FORENSIC_CLASS_COUNT];
+    memset(matrix, 0, sizeof(matrix));
+    for (uint64_t i = 0; i < FORENSIC_LOG.count; i++) {
+        const forensic_record *r = &FORENSIC_LOG.records[i];
+        int64_t idx = fault_manifest_find(&MANIFEST, r->lba);
+        uint32_t type = idx < 0 ? FAULT_TYPE_COUNT : MANIFEST.records[idx].type;
+        matrix[type < FAULT_TYPE_COUNT ? type : FAULT_TYPE_COUNT][r->cls]++;
+    }
+    printf("\n  %-10s", "Injected");
+    for (int c = 0; c < FORENSIC_CLASS_COUNT; c++) {
+        printf(" %12s", forensic_class_name((forensic_class)c));
+    }
+    printf("\n");
+    for (int t = 0; t <= FAULT_TYPE_COUNT; t++) {
+        uint64_t row = 0;
+        for (int c = 0; c < FORENSIC_CLASS_COUNT; c++) {
+            row += matrix[t][c];
+        }
+        if (row == 0) {
+            continue;
+        }
+        printf("  %-10s", t < FAULT_TYPE_COUNT ? fault_type_name((fault_type)t) : "none");
+        for (int c = 0; c < FORENSIC_CLASS_COUNT; c++) {
+            printf(" %12lu", matrix[t][c]);
+        }
+        printf("\n");
+    }
+}
+
+// 기존 4가지 corruption: 섹터 하나를 backend로 읽어 고친 뒤 다시 씀 (--ssd면 FTL mapping을 거침)
+void corruption(int corruption_type)
+{
+    static const uint64_t target_lba[] = { 0, 5, 3, 1, 4 };
+    if (corruption_type < 1 || corruption_type > 4) {
+        printf("Unknown corruption type: %d\n", corruption_type);
+        return;
+    }
+    uint64_t offset = target_lba[corruption_type] * SECTOR_SIZE;
+
+    unsigned char *block = NULL;
+    if (posix_memalign((void**)&block, SECTOR_SIZE, SECTOR_SIZE) != 0) {
+        perror("posix_memalign");
+        return;
+    }
+    if (backend_transfer(false, block, SECTOR_SIZE, offset) != SECTOR_SIZE) {
+        printf("Error: Read failed in corruption case %d\n", corruption_type);
+        free(block);
+        return;
+    }
+
+    verify_header* header = (verify_header*)block;
+    switch(corruption_type){
+        case 1:  // checksum mismatch
+            block[sizeof(verify_header)] = 'A';
+            break;
+        case 2:  // lba mismatch
+            header->lba = 4;
+            break;
+        case 3:  // offset mismatch
+            header->offset = 8192;
             break;
-        }
-        case 4: {  // lba and offset mismatch
-            ret = pread(device_fd, block, SECTOR_SIZE, 4*SECTOR_SIZE);
-            if (ret != SECTOR_SIZE) {
-                perror("pread failed in corruption case 4");
-                break;
-            }
-            verify_header* header = (verify_header*)block;
+        case 4:  // lba and offset mismatch
             header->offset = 0;
             header->lba = 2;
-            ret = pwrite(device_fd, block, SECTOR_SIZE, 4*SECTOR_SIZE);
-            if (ret != SECTOR_SIZE) {
-                perror("pwrite failed in corruption case 4");
-            }
-            break;
-        }
-        default:
-            printf("Unknown corruption type: %d\n", corruption_type);
             break;
     }
+    if (backend_transfer(true, block, SECTOR_SIZE, offset) != SECTOR_SIZE) {
+        printf("Error: Write failed in corruption case %d\n", corruption_type);
+    }
 
     free(block);
 }
 
+// device 전체 Merkle fingerprint: leaf 영역을 병렬로 읽어 hash, 상위 node는 fp_build
+// leaf 파일을 fpdiff로 비교하면 device를 다시 읽지 않고 다른 영역을 찾을 수 있음
+int run_fingerprint(const char *path, uint64_t leaf_size) {
+    fingerprint fp;
+    if (!fp_init(&fp, device_size, leaf_size)) {
+        printf("Error: Failed to allocate fingerprint for %lu leaves\n", device_size / leaf_size + 1);
+        return 1;
+    }
+    printf("\n=== Fingerprint (%lu leaves of %lu bytes, %u levels) ===\n\n",
+           fp.header.leaf_count, leaf_size, fp.header.levels);
+
+    atomic_uint_fast64_t completed_bytes = 0;
+    atomic_int failures = 0;
+    atomic_bool stop_flag = false;
+
+    monitor_context ctx = {
+        .completed_bytes = &completed_bytes,
+        .stop_flag = &stop_flag,
+        .operation_name = "FINGERPRINT",
+        .total_bytes = device_size
+    };
+    if (SHM_STATS) {
+        shm_stats_begin(SHM_STATS, "FINGERPRINT", device_size);
+    }
+    pthread_t monitor_tid;
+    pthread_create(&monitor_tid, NULL, monitor_thread, &ctx);
+
+    uint64_t run_start = monotonic_ns();
+    #pragma omp parallel for schedule(dynamic, 4)
+    for (uint64_t leaf = 0; leaf < fp.header.leaf_count; leaf++) {
+        uint64_t offset = leaf * leaf_size;
+        // 마지막 leaf는 실제 남은 byte만 hash
+        size_t len = device_size - offset < leaf_size ? device_size - offset : leaf_size;
+        unsigned char *block = thread_io_buffer(leaf_size);
+
+        uint64_t submit = io_timing_begin();
+        ssize_t ret = block != NULL ? backend_transfer(false, block, len, offset) : -1;
+        io_timing_end(IO_OP_READ, offset / SECTOR_SIZE, len, submit, ret != (ssize_t)len);
+
+        if (ret != (ssize_t)len) {
+            // 읽지 못한 leaf는 bitmap에 표시: fpdiff가 상대 hash와 무관하게 차이로 보고
+            printf("Error: Failed to read leaf %lu at offset %lu\n", leaf, offset);
+            atomic_fetch_add(&failures, 1);
+            fp_set_failed(&fp, leaf);
+            record_block_stats(len, -1);
+            continue;
+        }
+        fp_set_leaf(&fp, leaf, fp_hash64(block, len, leaf));
+        atomic_fetch_add(&completed_bytes, len);
+        record_block_stats(len, 0);
+    }
+    fp_build(&fp);
+    double seconds = (monotonic_ns() - run_start) / 1e9;
+
+    atomic_store(&stop_flag, true);
+    pthread_join(monitor_tid, NULL);
+    BYTES_PROCESSED += atomic_load(&completed_bytes);
+    if (SHM_STATS) {
+        shm_stats_finish(SHM_STATS);
+    }
+
+    double mb = atomic_load(&completed_bytes) / (1024.0 * 1024.0);
+    printf("\nFingerprint Complete:\n");
+    printf("  Read: %.2f MB in %.2f s, %.2f MB/s\n", mb, seconds, seconds > 0 ? mb / seconds : 0.0);
+    printf("  Failures: %d leaves\n", atomic_load(&failures));
+    printf("  Root: %016lx\n", fp.header.root);
+
+    bool saved = fp_save(path, &fp);
+    if (saved) {
+        uint64_t words = fp.header.node_count + (fp.header.leaf_count + 63) / 64;  // node hash + failure bitmap
+        printf("  Saved: %s (%lu nodes, %.2f KB)\n", path, fp.header.node_count,
+               (sizeof(fp_header) + words * sizeof(uint64_t)) / 1024.0);
+    }
+    fp_free(&fp);
+    return atomic_load(&failures) + (saved ? 0 : 1);
+}
+
 // CRC 값 출력 
 void print_sample_checksums(void) {
     printf("\n=== CRC Checksum Info ===\n");
@@ -500,7 +2846,7 @@ void print_sample_checksums(void) {
         return;
     }
 
-    ssize_t bytes_read = pread(device_fd, block, SECTOR_SIZE, offset);
+    ssize_t bytes_read = backend_transfer(false, block, SECTOR_SIZE, offset);
     if (bytes_read == SECTOR_SIZE) {
         verify_header *header = (verify_header *)block;
         printf("CRC32 Checksum: 0x%08X\n", header->checksum);
@@ -519,14 +2865,144 @@ void print_usage(const char *prog_name) {
     printf("  %s --read --random            : Random read test\n", prog_name);
     printf("  %s --read --seq               : Sequential read test\n", prog_name);
     printf("  %s --corruption               : Introduce all data corruption types\n", prog_name);
+    printf("  %s --corruption --corrupt-rate R : Inject seeded random faults in parallel\n", prog_name);
+    printf("  %s --jobfile FILE             : Run all jobs in an INI job file concurrently\n", prog_name);
+    printf("  %s --replay FILE              : Replay a block trace (text, blkparse or binary), verifying reads\n", prog_name);
+    printf("  %s --discard                  : Discard extents, measure latency, verify trimmed data\n", prog_name);
+    printf("  %s --soak N                   : Repeat write + verify passes with increasing generations\n", prog_name);
+    printf("  %s --sweep                    : Run every combination of the --sweep-* lists and print a scaling table\n", prog_name);
+    printf("  %s --fingerprint FILE         : Hash the whole device into a Merkle tree (compare with fpdiff)\n", prog_name);
+    printf("  %s --verify-since GEN --journal FILE : Verify only extents written in journal generation >= GEN\n", prog_name);
+    printf("  %s --bank-test read|write --geometry META.INI : Compare page I/O over all banks with one bank\n", prog_name);
+    printf("\nOptions:\n");
+    printf("  --device PATH                 : Block device or pre-sized file (default %s)\n", device_path);
+    printf("  --payload crc|seed            : crc  = store CRC32, recompute on read (default)\n");
+    printf("                                  seed = payload derived from (seed, LBA, generation),\n");
+    printf("                                         regenerated and compared on read\n");
+    printf("  --seed N                      : PRNG seed for --payload seed (default 0)\n");
+    printf("  --generation N                : Generation for --payload seed (default 0)\n");
+    printf("  --compress R                  : Target compression ratio R:1 for written data (default 1.0)\n");
+    printf("  --dedupe F                    : Fraction of 4K units repeating a shared pattern, 0.0-1.0\n");
+    printf("                                  (pass the same value on read; verified with --payload seed)\n");
+    printf("  --shm NAME                    : Publish live stats in /dev/shm/%sNAME (read with fio_stat)\n", SHM_STATS_PREFIX);
+    printf("  --cpu-stats                   : Report CPU-s/GB and gen/submit/wait/verify phase shares\n");
+    printf("  --perf-counters               : perf_event counters around generate/verify (IPC, misses/KB)\n");
+    printf("  --trace FILE                  : Record outlier I/Os with surrounding events (convert with trace2json)\n");
+    printf("  --trace-threshold-us N        : Outlier latency threshold in microseconds (default 10000)\n");
+    printf("  --trace-window N              : Events kept before/after each outlier per thread (default 32)\n");
+    printf("  --replay-speed S              : original (default), max, or a speed-up factor (2 = twice as fast)\n");
+    printf("  --replay-threads N            : Concurrent replay I/Os (default 8)\n");
+    printf("  --discard-mode trim|zeroout   : BLKDISCARD/BLKZEROOUT (punch-hole/zero-range on files, default trim)\n");
+    printf("  --discard-extent SIZE         : Bytes per discard request, K/M/G suffix (default 1M)\n");
+    printf("  --discard-fraction F          : Fraction of extents discarded, chosen by --seed (default 1.0)\n");
+    printf("  --trim-map FILE               : Record discarded regions; reads then report trimmed vs unwritten\n");
+    printf("                                  sectors and flag stale headers in trimmed regions\n");
+    printf("  --journal FILE                : Append written/discarded extents, one generation per run\n");
+    printf("  --corrupt-rate R              : Fraction of sectors to corrupt with --corruption (e.g. 1e-4)\n");
+    printf("  --corrupt-types LIST          : bitflip,torn,stale,misdirect,zero or all (default all; stale only\n");
+    printf("                                  with --payload seed --generation N>=1)\n");
+    printf("  --manifest FILE               : Ground truth written by --corruption; a read pass with the\n");
+    printf("                                  same file reports detection recall and time-to-detect\n");
+    printf("  --forensics                   : Classify verify errors as misdirected, lost write, stale or corruption\n");
+    printf("  --soak-time SEC               : Stop soaking after the pass that crosses SEC seconds\n");
+    printf("                                  (--soak 0 runs until the time limit)\n");
+    printf("  --xfer-size SIZE              : Bytes per read in --read --seq and --verify-since, multiple of %lu up to 8M\n",
+           IO_BLOCK_SIZE);
+    printf("  --verify-unit SIZE            : Verification unit inside each transfer, 4K-%luK (default %luK, a divisor of the block size)\n",
+           IO_BLOCK_SIZE / 1024, IO_BLOCK_SIZE / 1024);
+    printf("  --sweep-bs LIST               : Block sizes, e.g. 4K,128K,1M (default 128K)\n");
+    printf("  --sweep-threads LIST          : Thread counts, e.g. 1,2,4,8 (default 1)\n");
+    printf("  --sweep-qd LIST               : Synchronous I/Os in flight per thread (default 1)\n");
+    printf("  --sweep-size LIST             : Region sizes from offset 0 (default whole device)\n");
+    printf("  --sweep-rw read|write         : I/O direction (default read; write the target first)\n");
+    printf("  --sweep-pattern seq|random    : Access pattern (default seq)\n");
+    printf("  --sweep-csv FILE              : Also write the scaling table as CSV\n");
+    printf("  --fp-leaf SIZE                : Bytes per fingerprint leaf, multiple of 4096 (default 1M)\n");
+    printf("  --engine direct|buffered|mmap : O_DIRECT (default), page-cache pread/pwrite with fadvise,\n");
+    printf("                                  or MAP_SHARED mapping with madvise\n");
+    printf("  --drop-cache                  : Evict the target from the page cache before running\n");
+    printf("  --ssd META.INI                : Emulate a NAND SSD (page-mapped FTL, greedy GC) on the target,\n");
+    printf("                                  exposing PROVISION_RATE %% of bank x block x page x page_size\n");
+    printf("  --ssd-latency R:P:E           : Page read, page program and block erase in us (default 50:500:3000,\n");
+    printf("                                  0:0:0 disables timing)\n");
+    printf("  --ssd-state FILE              : Load the FTL mapping before running and save it afterwards\n");
+    printf("  --geometry META.INI           : Use page_size x bank (one page on every bank) as the block size unit\n");
+    printf("                                  Verify runs should pass the same --geometry to cover the same blocks\n");
+    printf("  --geometry-stripes N          : Stripes per I/O block (default: closest to %lluK)\n", DEFAULT_IO_BLOCK_SIZE / 1024);
+    printf("  --bank N                      : Bank the --bank-test single-bank pass targets (default 0)\n");
+    printf("  --bank-threads N              : Threads for --bank-test (default: bank count)\n");
+    printf("  --fault-eio P                 : Fail worker I/Os with EIO with probability P\n");
+    printf("  --fault-short P               : Return a short (half-length) transfer with probability P\n");
+    printf("  --fault-delay P:US            : Add a US-microsecond latency spike with probability P\n");
+    printf("  --fault-lba START-END         : Only inject faults into I/Os overlapping sectors [START, END)\n");
+    printf("  --fault-ops read|write|both   : I/O direction faults apply to (default both)\n");
+    printf("  --retry N                     : Retry failed or short I/Os up to N times (default 0)\n");
+    printf("  --retry-backoff-us US         : First retry backoff, doubled per attempt (default 100)\n");
+    printf("  --dsync                       : Durable writes with RWF_DSYNC (FUA when supported)\n");
+    printf("  --flush-every N               : fdatasync after every N writes\n");
+    printf("  --flush-interval-ms MS        : fdatasync from a timer thread every MS milliseconds\n");
+    printf("  --verify-after-flush          : After writing, re-read every block acknowledged before the last flush\n");
     printf("\nCorruption types applied:\n");
 }
 
+// meta.ini 읽기, library 에러는 여기서 출력
+static bool load_geometry(const char *path, nand_geometry *geo) {
+    nand_geometry_status status = nand_geometry_load(path, geo);
+    if (status == NAND_GEOMETRY_OPEN) {
+        printf("Error: Cannot open geometry file '%s': %s\n", path, strerror(errno));
+    } else if (status != NAND_GEOMETRY_OK) {
+        printf("Error: Geometry file '%s' %s\n", path, nand_geometry_status_string(status));
+    }
+    return status == NAND_GEOMETRY_OK;
+}
+
+// 숫자 인자 파싱 (10진수/16진수)
+static bool parse_u64(const char *str, uint64_t *out) {
+    char *end = NULL;
+    errno = 0;
+    unsigned long long value = strtoull(str, &end, 0);
+    if (errno != 0 || end == str || *end != '\0') {
+        return false;
+    }
+    *out = (uint64_t)value;
+    return true;
+}
+
+static bool parse_double(const char *str, double *out) {
+    char *end = NULL;
+    errno = 0;
+    double value = strtod(str, &end);
+    if (errno != 0 || end == str || *end != '\0') {
+        return false;
+    }
+    *out = value;
+    return true;
+}
+
+// 쉼표로 구분된 목록 파싱 (sizes면 K/M/G 접미사 허용), 0은 허용하지 않음
+static bool parse_list(const char *str, uint64_t *out, int *count, bool sizes) {
+    char buf[256];
+    if (strlen(str) >= sizeof(buf)) {
+        return false;
+    }
+    strcpy(buf, str);
+    *count = 0;
+    char *save = NULL;
+    for (char *tok = strtok_r(buf, ",", &save); tok != NULL; tok = strtok_r(NULL, ",", &save)) {
+        uint64_t value;
+        bool ok = sizes ? parse_size(tok, &value) == 0 : parse_u64(tok, &value);
+        if (!ok || value == 0 || *count == SWEEP_MAX_VALUES) {
+            return false;
+        }
+        out[(*count)++] = value;
+    }
+    return *count > 0;
+}
+
 int main(int argc, char *argv[]) {
     printf("FIO Meta Verification Simulator\n");
     printf("================================\n");
     printf("Sector Size: %llu bytes\n", SECTOR_SIZE);
-    printf("I/O Block Size: %llu bytes (%llu sectors per block)\n", IO_BLOCK_SIZE, SECTORS_PER_BLOCK);
     printf("Header Size: %lu bytes\n", sizeof(verify_header));
     printf("Payload Size per Sector: %llu bytes\n\n", SECTOR_SIZE - sizeof(verify_header));
 
@@ -541,55 +3017,652 @@ int main(int argc, char *argv[]) {
     bool do_random = false;
     bool do_seq = false;
     bool do_corruption = false;
+    bool corrupt_types_given = false;
+    const char *job_file = NULL;
+    const char *replay_file = NULL;
+    double replay_speed = 1.0;
+    uint64_t replay_threads = 8;
+    bool do_discard = false;
+    fault_backend_config fault_cfg = { .reads = true, .writes = true };
+    bool drop_cache = false;
+    ssd_latency ssd_lat = { 50, 500, 3000 };
+    discard_mode discard_type = DISCARD_TRIM;
+    uint64_t discard_extent = 1024 * 1024;
+    double discard_fraction = 1.0;
+    const char *fingerprint_file = NULL;
+    bool do_soak = false;
+    bool do_sweep = false;
+    bool do_verify_since = false;
+    uint64_t verify_since = 0;
+    int sweep_workers = 0;
+    const char *geometry_path = NULL;
+    uint64_t geometry_stripes = 0;
+    bool do_bank_test = false;
+    bool bank_write = false;
+    uint64_t bank_target = 0;
+    uint64_t bank_threads = 0;
+    sweep_config sweep = {
+        .block_sizes = { 0 }, .num_block_sizes = 1,
+        .threads = { 1 }, .num_threads = 1,
+        .depths = { 1 }, .num_depths = 1,
+        .regions = { 0 }, .num_regions = 1,
+    };
+    uint64_t soak_passes = 0;
+    uint64_t soak_seconds = 0;
+    uint64_t fp_leaf = 1024 * 1024;
 
     // Parse arguments
-    if (strcmp(argv[1], "--write") == 0) {
-        if (argc != 2) {
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if (strcmp(arg, "--write") == 0) {
+            do_write = true;
+        } else if (strcmp(arg, "--read") == 0) {
+            do_read = true;
+        } else if (strcmp(arg, "--random") == 0) {
+            do_random = true;
+        } else if (strcmp(arg, "--seq") == 0) {
+            do_seq = true;
+        } else if (strcmp(arg, "--corruption") == 0) {
+            do_corruption = true;
+        } else if (strcmp(arg, "--jobfile") == 0 && value != NULL) {
+            job_file = value;
+            i++;
+        } else if (strcmp(arg, "--replay") == 0 && value != NULL) {
+            replay_file = value;
+            i++;
+        } else if (strcmp(arg, "--replay-speed") == 0 && value != NULL) {
+            if (strcmp(value, "original") == 0) {
+                replay_speed = 1.0;
+            } else if (strcmp(value, "max") == 0) {
+                replay_speed = 0.0;
+            } else if (!parse_double(value, &replay_speed) || replay_speed <= 0.0) {
+                printf("Error: Invalid replay speed '%s'\n", value);
+                return 1;
+            }
+            i++;
+        } else if (strcmp(arg, "--replay-threads") == 0 && value != NULL) {
+            if (!parse_u64(value, &replay_threads) || replay_threads == 0 || replay_threads > SHM_STATS_MAX_THREADS) {
+                printf("Error: Invalid replay thread count '%s'\n", value);
+                return 1;
+            }
+            i++;
+        } else if (strcmp(arg, "--discard") == 0) {
+            do_discard = true;
+        } else if (strcmp(arg, "--discard-mode") == 0 && value != NULL) {
+            if (strcmp(value, "trim") == 0) {
+                discard_type = DISCARD_TRIM;
+            } else if (strcmp(value, "zeroout") == 0) {
+                discard_type = DISCARD_ZEROOUT;
+            } else {
+                printf("Error: Unknown discard mode '%s'\n", value);
+                return 1;
+            }
+            i++;
+        } else if (strcmp(arg, "--discard-extent") == 0 && value != NULL) {
+            if (parse_size(value, &discard_extent) != 0 || discard_extent == 0 || discard_extent % ALIGNMENT != 0) {
+                printf("Error: Invalid discard extent '%s' (must be a multiple of %d)\n", value, ALIGNMENT);
+                return 1;
+            }
+            i++;
+        } else if (strcmp(arg, "--discard-fraction") == 0 && value != NULL) {
+            if (!parse_double(value, &discard_fraction) || discard_fraction <= 0.0 || discard_fraction > 1.0) {
+                printf("Error: Invalid discard fraction '%s' (must be 0.0-1.0)\n", value);
+                return 1;
+            }
+            i++;
+        } else if (strcmp(arg, "--xfer-size") == 0 && value != NULL) {
+            if (parse_size(value, &XFER_SIZE) != 0 || XFER_SIZE == 0) {
+                printf("Error: Invalid transfer size '%s'\n", value);
+                return 1;
+            }
+            i++;
+        } else if (strcmp(arg, "--verify-unit") == 0 && value != NULL) {
+            if (parse_size(value, &VERIFY_UNIT) != 0 || VERIFY_UNIT == 0) {
+                printf("Error: Invalid verify unit '%s'\n", value);
+                return 1;
+            }
+            i++;
+        } else if (strcmp(arg, "--bank-test") == 0 && value != NULL) {
+            if (strcmp(value, "read") != 0 && strcmp(value, "write") != 0) {
+                printf("Error: Invalid bank test direction '%s' (read or write)\n", value);
+                return 1;
+            }
+            do_bank_test = true;
+            bank_write = strcmp(value, "write") == 0;
+            i++;
+        } else if (strcmp(arg, "--bank") == 0 && value != NULL) {
+            if (!parse_u64(value, &bank_target)) {
+                printf("Error: Invalid bank '%s'\n", value);
+                return 1;
+            }
+            i++;
+        } else if (strcmp(arg, "--bank-threads") == 0 && value != NULL) {
+            if (!parse_u64(value, &bank_threads) || bank_threads == 0 || bank_threads > SHM_STATS_MAX_THREADS) {
+                printf("Error: Invalid bank test thread count '%s'\n", value);
+                return 1;
+            }
+            i++;
+        } else if (strcmp(arg, "--geometry") == 0 && value != NULL) {
+            geometry_path = value;
+            i++;
+        } else if (strcmp(arg, "--geometry-stripes") == 0 && value != NULL) {
+            if (!parse_u64(value, &geometry_stripes) || geometry_stripes == 0) {
+                printf("Error: Invalid stripe count '%s'\n", value);
+                return 1;
+            }
+            i++;
+        } else if (strcmp(arg, "--sweep") == 0) {
+            do_sweep = true;
+        } else if (strcmp(arg, "--sweep-bs") == 0 && value != NULL) {
+            if (!parse_list(value, sweep.block_sizes, &sweep.num_block_sizes, true)) {
+                printf("Error: Invalid block size list '%s'\n", value);
+                return 1;
+            }
+            for (int b = 0; b < sweep.num_block_sizes; b++) {
+                if (sweep.block_sizes[b] % ALIGNMENT != 0 || sweep.block_sizes[b] > JOB_MAX_BLOCK_SIZE) {
+                    printf("Error: Sweep block sizes must be multiples of %d up to %llu\n", ALIGNMENT, JOB_MAX_BLOCK_SIZE);
+                    return 1;
+                }
+            }
+            i++;
+        } else if (strcmp(arg, "--sweep-threads") == 0 && value != NULL) {
+            if (!parse_list(value, sweep.threads, &sweep.num_threads, false)) {
+                printf("Error: Invalid thread list '%s'\n", value);
+                return 1;
+            }
+            i++;
+        } else if (strcmp(arg, "--sweep-qd") == 0 && value != NULL) {
+            if (!parse_list(value, sweep.depths, &sweep.num_depths, false)) {
+                printf("Error: Invalid queue depth list '%s'\n", value);
+                return 1;
+            }
+            i++;
+        } else if (strcmp(arg, "--sweep-size") == 0 && value != NULL) {
+            if (!parse_list(value, sweep.regions, &sweep.num_regions, true)) {
+                printf("Error: Invalid region size list '%s'\n", value);
+                return 1;
+            }
+            i++;
+        } else if (strcmp(arg, "--sweep-rw") == 0 && value != NULL) {
+            if (strcmp(value, "read") != 0 && strcmp(value, "write") != 0) {
+                printf("Error: Invalid sweep direction '%s'\n", value);
+                return 1;
+            }
+            sweep.is_write = strcmp(value, "write") == 0;
+            i++;
+        } else if (strcmp(arg, "--sweep-pattern") == 0 && value != NULL) {
+            if (strcmp(value, "seq") != 0 && strcmp(value, "random") != 0) {
+                printf("Error: Invalid sweep pattern '%s'\n", value);
+                return 1;
+            }
+            sweep.random = strcmp(value, "random") == 0;
+            i++;
+        } else if (strcmp(arg, "--sweep-csv") == 0 && value != NULL) {
+            sweep.csv_path = value;
+            i++;
+        } else if (strcmp(arg, "--soak") == 0 && value != NULL) {
+            if (!parse_u64(value, &soak_passes)) {
+                printf("Error: Invalid soak pass count '%s'\n", value);
+                return 1;
+            }
+            do_soak = true;
+            i++;
+        } else if (strcmp(arg, "--soak-time") == 0 && value != NULL) {
+            if (!parse_u64(value, &soak_seconds) || soak_seconds == 0) {
+                printf("Error: Invalid soak time '%s'\n", value);
+                return 1;
+            }
+            i++;
+        } else if (strcmp(arg, "--fingerprint") == 0 && value != NULL) {
+            fingerprint_file = value;
+            i++;
+        } else if (strcmp(arg, "--fp-leaf") == 0 && value != NULL) {
+            if (parse_size(value, &fp_leaf) != 0 || fp_leaf == 0 || fp_leaf % ALIGNMENT != 0 || fp_leaf > JOB_MAX_BLOCK_SIZE) {
+                printf("Error: Invalid fingerprint leaf size '%s' (multiple of %d up to %llu)\n", value, ALIGNMENT, JOB_MAX_BLOCK_SIZE);
+                return 1;
+            }
+            i++;
+        } else if (strcmp(arg, "--trim-map") == 0 && value != NULL) {
+            TRIM_MAP_PATH = value;
+            i++;
+        } else if (strcmp(arg, "--journal") == 0 && value != NULL) {
+            JOURNAL_PATH = value;
+            i++;
+        } else if (strcmp(arg, "--verify-since") == 0 && value != NULL) {
+            if (!parse_u64(value, &verify_since)) {
+                printf("Error: Invalid journal generation '%s'\n", value);
+                return 1;
+            }
+            do_verify_since = true;
+            i++;
+        } else if (strcmp(arg, "--corrupt-rate") == 0 && value != NULL) {
+            if (!parse_double(value, &CORRUPT_RATE) || CORRUPT_RATE <= 0.0 || CORRUPT_RATE > 1.0) {
+                printf("Error: Invalid corruption rate '%s' (must be 0.0-1.0)\n", value);
+                return 1;
+            }
+            i++;
+        } else if (strcmp(arg, "--corrupt-types") == 0 && value != NULL) {
+            CORRUPT_TYPES = fault_parse_types(value);
+            corrupt_types_given = true;
+            if (CORRUPT_TYPES == 0) {
+                printf("Error: Invalid corruption types '%s'\n", value);
+                return 1;
+            }
+            i++;
+        } else if (strcmp(arg, "--forensics") == 0) {
+            FORENSICS = true;
+        } else if (strcmp(arg, "--manifest") == 0 && value != NULL) {
+            MANIFEST_PATH = value;
+            i++;
+        } else if (strcmp(arg, "--engine") == 0 && value != NULL) {
+            if (strcmp(value, "direct") != 0 && strcmp(value, "buffered") != 0 && strcmp(value, "mmap") != 0) {
+                printf("Error: Unknown engine '%s'\n", value);
+                return 1;
+            }
+            IO_ENGINE = value;
+            i++;
+        } else if (strcmp(arg, "--drop-cache") == 0) {
+            drop_cache = true;
+        } else if (strcmp(arg, "--ssd") == 0 && value != NULL) {
+            SSD_GEOMETRY_PATH = value;
+            i++;
+        } else if (strcmp(arg, "--ssd-latency") == 0 && value != NULL) {
+            unsigned long long read_us, program_us, erase_us;
+            char extra;
+            if (sscanf(value, "%llu:%llu:%llu%c", &read_us, &program_us, &erase_us, &extra) != 3) {
+                printf("Error: Invalid SSD latency '%s' (expected R:P:E in us)\n", value);
+                return 1;
+            }
+            ssd_lat = (ssd_latency){ read_us, program_us, erase_us };
+            i++;
+        } else if (strcmp(arg, "--ssd-state") == 0 && value != NULL) {
+            SSD_STATE_PATH = value;
+            i++;
+        } else if (strcmp(arg, "--fault-eio") == 0 && value != NULL) {
+            if (!parse_double(value, &fault_cfg.eio_prob) || fault_cfg.eio_prob < 0.0 || fault_cfg.eio_prob > 1.0) {
+                printf("Error: Invalid EIO probability '%s'\n", value);
+                return 1;
+            }
+            i++;
+        } else if (strcmp(arg, "--fault-short") == 0 && value != NULL) {
+            if (!parse_double(value, &fault_cfg.short_prob) || fault_cfg.short_prob < 0.0 || fault_cfg.short_prob > 1.0) {
+                printf("Error: Invalid short transfer probability '%s'\n", value);
+                return 1;
+            }
+            i++;
+        } else if (strcmp(arg, "--fault-delay") == 0 && value != NULL) {
+            unsigned long long delay_us;
+            char extra;
+            if (sscanf(value, "%lf:%llu%c", &fault_cfg.delay_prob, &delay_us, &extra) != 2 ||
+                fault_cfg.delay_prob < 0.0 || fault_cfg.delay_prob > 1.0) {
+                printf("Error: Invalid latency spike '%s' (expected P:US)\n", value);
+                return 1;
+            }
+            fault_cfg.delay_us = delay_us;
+            i++;
+        } else if (strcmp(arg, "--fault-lba") == 0 && value != NULL) {
+            unsigned long long start, end;
+            char extra;
+            if (sscanf(value, "%llu-%llu%c", &start, &end, &extra) != 2 || end <= start) {
+                printf("Error: Invalid fault LBA range '%s' (expected START-END)\n", value);
+                return 1;
+            }
+            fault_cfg.lba_start = start;
+            fault_cfg.lba_end = end;
+            i++;
+        } else if (strcmp(arg, "--fault-ops") == 0 && value != NULL) {
+            fault_cfg.reads = strcmp(value, "read") == 0 || strcmp(value, "both") == 0;
+            fault_cfg.writes = strcmp(value, "write") == 0 || strcmp(value, "both") == 0;
+            if (!fault_cfg.reads && !fault_cfg.writes) {
+                printf("Error: Invalid fault ops '%s'\n", value);
+                return 1;
+            }
+            i++;
+        } else if (strcmp(arg, "--retry") == 0 && value != NULL) {
+            if (!parse_u64(value, &IO_RETRIES) || IO_RETRIES > 64) {
+                printf("Error: Invalid retry count '%s'\n", value);
+                return 1;
+            }
+            i++;
+        } else if (strcmp(arg, "--retry-backoff-us") == 0 && value != NULL) {
+            if (!parse_u64(value, &RETRY_BACKOFF_US)) {
+                printf("Error: Invalid retry backoff '%s'\n", value);
+                return 1;
+            }
+            i++;
+        } else if (strcmp(arg, "--dsync") == 0) {
+            WRITE_DSYNC = true;
+        } else if (strcmp(arg, "--flush-every") == 0 && value != NULL) {
+            if (!parse_u64(value, &FLUSH_EVERY) || FLUSH_EVERY == 0) {
+                printf("Error: Invalid flush count '%s'\n", value);
+                return 1;
+            }
+            i++;
+        } else if (strcmp(arg, "--flush-interval-ms") == 0 && value != NULL) {
+            if (!parse_u64(value, &FLUSH_INTERVAL_MS) || FLUSH_INTERVAL_MS == 0) {
+                printf("Error: Invalid flush interval '%s'\n", value);
+                return 1;
+            }
+            i++;
+        } else if (strcmp(arg, "--verify-after-flush") == 0) {
+            VERIFY_AFTER_FLUSH = true;
+        } else if (strcmp(arg, "--device") == 0 && value != NULL) {
+            device_path = value;
+            i++;
+        } else if (strcmp(arg, "--payload") == 0 && value != NULL) {
+            if (strcmp(value, "crc") == 0) {
+                PAYLOAD_MODE = PAYLOAD_CRC;
+            } else if (strcmp(value, "seed") == 0) {
+                PAYLOAD_MODE = PAYLOAD_SEED;
+            } else {
+                printf("Error: Unknown payload mode '%s'\n", value);
+                print_usage(argv[0]);
+                return 1;
+            }
+            i++;
+        } else if (strcmp(arg, "--seed") == 0 && value != NULL) {
+            if (!parse_u64(value, &PAYLOAD_SEED_VALUE)) {
+                printf("Error: Invalid seed '%s'\n", value);
+                return 1;
+            }
+            i++;
+        } else if (strcmp(arg, "--generation") == 0 && value != NULL) {
+            if (!parse_u64(value, &PAYLOAD_GENERATION)) {
+                printf("Error: Invalid generation '%s'\n", value);
+                return 1;
+            }
+            i++;
+        } else if (strcmp(arg, "--shm") == 0 && value != NULL) {
+            SHM_NAME = value;
+            i++;
+        } else if (strcmp(arg, "--cpu-stats") == 0) {
+            CPU_STATS = true;
+        } else if (strcmp(arg, "--perf-counters") == 0) {
+            PERF_COUNTERS = true;
+        } else if (strcmp(arg, "--trace") == 0 && value != NULL) {
+            TRACE_PATH = value;
+            i++;
+        } else if (strcmp(arg, "--trace-threshold-us") == 0 && value != NULL) {
+            if (!parse_u64(value, &TRACE_THRESHOLD_US)) {
+                printf("Error: Invalid trace threshold '%s'\n", value);
+                return 1;
+            }
+            i++;
+        } else if (strcmp(arg, "--trace-window") == 0 && value != NULL) {
+            uint64_t window;
+            if (!parse_u64(value, &window) || window > 65536) {
+                printf("Error: Invalid trace window '%s'\n", value);
+                return 1;
+            }
+            TRACE_WINDOW = (uint32_t)window;
+            i++;
+        } else if (strcmp(arg, "--compress") == 0 && value != NULL) {
+            if (!parse_double(value, &COMPRESS_RATIO) || COMPRESS_RATIO < 1.0) {
+                printf("Error: Invalid compression ratio '%s' (must be >= 1.0)\n", value);
+                return 1;
+            }
+            i++;
+        } else if (strcmp(arg, "--dedupe") == 0 && value != NULL) {
+            if (!parse_double(value, &DEDUPE_RATIO) || DEDUPE_RATIO < 0.0 || DEDUPE_RATIO > 1.0) {
+                printf("Error: Invalid dedupe ratio '%s' (must be 0.0-1.0)\n", value);
+                return 1;
+            }
+            i++;
+        } else {
+            printf("Error: Unknown command '%s'\n", arg);
             print_usage(argv[0]);
             return 1;
         }
-        do_write = true;
-    } else if (strcmp(argv[1], "--read") == 0) {
-        if (argc != 3) {
-            print_usage(argv[0]);
+    }
+
+    // 명령은 정확히 하나, read는 random/seq 중 하나
+    if ((int)do_write + (int)do_read + (int)do_corruption + (job_file != NULL) + (replay_file != NULL) + (int)do_discard +
+        (fingerprint_file != NULL) + (int)do_soak +
+        (int)do_sweep + (int)do_verify_since + (int)do_bank_test != 1 ||
+        (do_read && (int)do_random + (int)do_seq != 1) ||
+        (!do_read && (do_random || do_seq))) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    // geometry에서 I/O 단위 결정: 모든 bank의 page 하나씩 (stripe) x N
+    if (geometry_path != NULL) {
+        if (!load_geometry(geometry_path, &GEOMETRY)) {
             return 1;
         }
-        do_read = true;
-        if (strcmp(argv[2], "--random") == 0) {
-            do_random = true;
-        } else if (strcmp(argv[2], "--seq") == 0) {
-            do_seq = true;
-        } else {
-            printf("Error: Unknown read mode '%s'\n", argv[2]);
-            print_usage(argv[0]);
+        uint64_t stripe = nand_geometry_stripe(&GEOMETRY);
+        if (GEOMETRY.page_size % ALIGNMENT != 0 || stripe == 0 || stripe > JOB_MAX_BLOCK_SIZE) {
+            printf("Error: Geometry needs page_size a multiple of %d and page_size x bank up to %llu\n",
+                   ALIGNMENT, JOB_MAX_BLOCK_SIZE);
             return 1;
         }
-    } else if (strcmp(argv[1], "--corruption") == 0) {
-        if (argc != 2) {
-            print_usage(argv[0]);
+        // 지정하지 않으면 기본 블록 크기에 가장 가까운 stripe 배수
+        if (geometry_stripes == 0) {
+            geometry_stripes = nand_geometry_default_stripes(&GEOMETRY, DEFAULT_IO_BLOCK_SIZE);
+        }
+        if (geometry_stripes > JOB_MAX_BLOCK_SIZE / stripe) {
+            printf("Error: %lu stripes of %lu bytes exceed %llu\n", geometry_stripes, stripe, JOB_MAX_BLOCK_SIZE);
             return 1;
         }
-        do_corruption = true;
-    } else {
-        printf("Error: Unknown command '%s'\n", argv[1]);
-        print_usage(argv[0]);
+        IO_BLOCK_SIZE = stripe * geometry_stripes;
+    } else if (geometry_stripes) {
+        printf("Error: --geometry-stripes requires --geometry META.INI\n");
+        return 1;
+    }
+    if (do_bank_test) {
+        if (GEOMETRY.page_size == 0) {
+            printf("Error: --bank-test requires --geometry META.INI\n");
+            return 1;
+        }
+        if (bank_target >= GEOMETRY.bank) {
+            printf("Error: Bank %lu outside 0-%lu\n", bank_target, GEOMETRY.bank - 1);
+            return 1;
+        }
+        // 모든 bank에 하나씩 요청이 걸리도록 기본 thread 수는 bank 수
+        if (bank_threads == 0) {
+            bank_threads = GEOMETRY.bank < SHM_STATS_MAX_THREADS ? GEOMETRY.bank : SHM_STATS_MAX_THREADS;
+        }
+    }
+
+    XFER_SIZE = XFER_SIZE ? XFER_SIZE : IO_BLOCK_SIZE;
+    VERIFY_UNIT = VERIFY_UNIT ? VERIFY_UNIT : IO_BLOCK_SIZE;
+    if (XFER_SIZE % IO_BLOCK_SIZE != 0 || XFER_SIZE > JOB_MAX_BLOCK_SIZE) {
+        printf("Error: Invalid transfer size %lu (multiple of %lu up to %llu)\n", XFER_SIZE, IO_BLOCK_SIZE, JOB_MAX_BLOCK_SIZE);
+        return 1;
+    }
+    if (VERIFY_UNIT < ALIGNMENT || VERIFY_UNIT % ALIGNMENT != 0 || IO_BLOCK_SIZE % VERIFY_UNIT != 0) {
+        printf("Error: Invalid verify unit %lu (multiple of %d dividing %lu)\n", VERIFY_UNIT, ALIGNMENT, IO_BLOCK_SIZE);
+        return 1;
+    }
+    if (sweep.block_sizes[0] == 0) {
+        sweep.block_sizes[0] = IO_BLOCK_SIZE;
+    }
+    printf("I/O Block Size: %lu bytes (%lu sectors per block)%s\n\n", IO_BLOCK_SIZE, (uint64_t)SECTORS_PER_BLOCK,
+           geometry_path != NULL ? ", from geometry" : "");
+
+    bool coalesced = XFER_SIZE != IO_BLOCK_SIZE || VERIFY_UNIT != IO_BLOCK_SIZE;
+    if (coalesced && !(do_read && do_seq) && !do_verify_since) {
+        printf("Error: --xfer-size and --verify-unit apply to --read --seq and --verify-since\n");
+        return 1;
+    }
+    if (do_verify_since && JOURNAL_PATH == NULL) {
+        printf("Error: --verify-since requires --journal FILE\n");
+        return 1;
+    }
+    // discard는 backend를 거치지 않고 target fd에 직접 하므로 FTL mapping과 어긋남
+    if (SSD_GEOMETRY_PATH != NULL && do_discard) {
+        printf("Error: --ssd cannot be combined with --discard\n");
+        return 1;
+    }
+    if (SSD_STATE_PATH != NULL && SSD_GEOMETRY_PATH == NULL) {
+        printf("Error: --ssd-state requires --ssd META.INI\n");
+        return 1;
+    }
+    if (FORENSICS) {
+        forensic_init(&FORENSIC_LOG);
+    }
+
+    // sweep의 동시 worker 수 (thread x queue depth) 는 통계 slot 수를 넘을 수 없음
+    if (do_sweep) {
+        for (int t = 0; t < sweep.num_threads; t++) {
+            for (int d = 0; d < sweep.num_depths; d++) {
+                uint64_t workers = sweep.threads[t] * sweep.depths[d];
+                if (workers > SHM_STATS_MAX_THREADS) {
+                    printf("Error: threads x qd = %lu exceeds %d workers\n", workers, SHM_STATS_MAX_THREADS);
+                    return 1;
+                }
+                if ((int)workers > sweep_workers) {
+                    sweep_workers = (int)workers;
+                }
+            }
+        }
+    }
+
+    if (do_soak && soak_passes == 0 && soak_seconds == 0) {
+        printf("Error: --soak 0 requires --soak-time\n");
+        return 1;
+    }
+    if (soak_seconds && !do_soak) {
+        printf("Error: --soak-time requires --soak\n");
+        return 1;
+    }
+
+    // stale은 이전 generation으로 완전하게 쓰인 섹터: CRC가 맞으므로 seed payload와
+    // 이전 generation (>= 1)이 있어야 검출 가능
+    bool stale_detectable = PAYLOAD_MODE == PAYLOAD_SEED && PAYLOAD_GENERATION >= 1;
+    if (do_corruption && CORRUPT_RATE > 0.0 && !stale_detectable && (CORRUPT_TYPES & (1u << FAULT_STALE))) {
+        if (corrupt_types_given) {
+            printf("Error: stale faults require --payload seed --generation N (N >= 1)\n");
+            return 1;
+        }
+        CORRUPT_TYPES &= ~(1u << FAULT_STALE);
+    }
+
+    if (MANIFEST_PATH != NULL && !(do_corruption && CORRUPT_RATE > 0.0) && !do_read) {
+        printf("Error: --manifest requires --corruption --corrupt-rate or --read\n");
+        return 1;
+    }
+
+    // durability 옵션은 write가 있는 명령에서만 의미가 있음
+    bool durability = WRITE_DSYNC || FLUSH_EVERY || FLUSH_INTERVAL_MS;
+    if ((durability || VERIFY_AFTER_FLUSH) && !do_write && job_file == NULL && replay_file == NULL && !do_soak) {
+        printf("Error: Durability options require --write, --jobfile, --replay or --soak\n");
+        return 1;
+    }
+    // soak은 timestamp 자리에 generation을 기록하므로 write 시각 기준 확인과 맞지 않음
+    if (VERIFY_AFTER_FLUSH && do_soak) {
+        printf("Error: --verify-after-flush cannot be combined with --soak\n");
+        return 1;
+    }
+    if (VERIFY_AFTER_FLUSH && !durability) {
+        printf("Error: --verify-after-flush requires --dsync, --flush-every or --flush-interval-ms\n");
         return 1;
     }
 
+    // job file은 디바이스를 열기 전에 검증
+    static job_config jobs[JOB_MAX];
+    int num_jobs = 0;
+    int job_threads = 0;
+    if (job_file != NULL) {
+        num_jobs = parse_job_file(job_file, jobs, JOB_MAX, IO_BLOCK_SIZE);
+        if (num_jobs < 0) {
+            return 1;
+        }
+        for (int j = 0; j < num_jobs; j++) {
+            job_threads += jobs[j].threads;
+        }
+        // job마다 256 thread까지 허용되지만 worker 통계 slot은 전체 합 기준 (sweep과 동일)
+        if (job_threads > SHM_STATS_MAX_THREADS) {
+            printf("Error: Jobs use %d threads in total, exceeding %d workers\n",
+                   job_threads, SHM_STATS_MAX_THREADS);
+            return 1;
+        }
+    }
+
+    if (do_sweep) {
+        job_threads = sweep_workers;
+    }
+    if (do_bank_test) {
+        job_threads = (int)bank_threads;
+    }
+
+    if (replay_file != NULL) {
+        job_threads = (int)replay_threads;
+    }
+
+    PAYLOAD_RANDOM_LEN = payload_random_len(SECTOR_SIZE, sizeof(verify_header), COMPRESS_RATIO);
+    DEDUPE_RANDOM_LEN = payload_random_len(SECTOR_SIZE, 0, COMPRESS_RATIO);
+
+    if (PAYLOAD_MODE == PAYLOAD_SEED) {
+        printf("Payload Mode: seed (seed=%lu, generation=%lu, %s compare)\n\n",
+               PAYLOAD_SEED_VALUE, PAYLOAD_GENERATION, payload_simd_name());
+    } else {
+        printf("Payload Mode: crc\n\n");
+    }
+    if (COMPRESS_RATIO > 1.0 || DEDUPE_RATIO > 0.0) {
+        printf("Payload Profile: compress %.2f:1 (%zu random bytes/sector), dedupe %.2f%%\n\n",
+               COMPRESS_RATIO, PAYLOAD_RANDOM_LEN, DEDUPE_RATIO * 100.0);
+    }
+
     // 블록 디바이스 열기
     printf("Opening block device: %s\n", device_path);
-    device_fd = open(device_path, O_RDWR | O_DIRECT);
-    if (device_fd == -1) {
+    fv_config target_cfg = {
+        .path = device_path,
+        .engine = IO_ENGINE,
+        .mode = PAYLOAD_MODE,
+        .seed = PAYLOAD_SEED_VALUE,
+        .generation = PAYLOAD_GENERATION,
+        .compress_ratio = COMPRESS_RATIO,
+        .dedupe_ratio = DEDUPE_RATIO,
+        .block_size = IO_BLOCK_SIZE,
+        .on_error = report_verify_error,
+        .is_trimmed = query_trim_map,
+        .check_generation = do_soak,
+    };
+    TARGET = fv_open(&target_cfg);
+    if (TARGET == NULL) {
         perror("Failed to open block device");
         printf("Note: You may need to run with sudo privileges\n");
         return 1;
     }
-
-    // 디바이스 크기 확인
-    if (ioctl(device_fd, BLKGETSIZE64, &device_size) == -1) {
-        perror("Failed to get device size");
-        close(device_fd);
-        return 1;
+    // 일반 파일 대상이면 파일 크기 사용
+    device_size = fv_size(TARGET);
+    DEVICE_IS_FILE = fv_is_file(TARGET);
+
+    // SSD emulator: target은 raw NAND page 저장소, worker에는 논리 용량만 노출
+    if (SSD_GEOMETRY_PATH != NULL) {
+        nand_geometry geo;
+        if (!load_geometry(SSD_GEOMETRY_PATH, &geo)) {
+            fv_close(TARGET);
+            return 1;
+        }
+        SSD_BACKEND = io_backend_ssd(fv_backend(TARGET), device_size, &geo, &ssd_lat, SSD_STATE_PATH);
+        if (SSD_BACKEND == NULL && errno == EBADMSG) {
+            printf("Error: SSD state '%s' is invalid or was saved for a different geometry\n", SSD_STATE_PATH);
+            fv_close(TARGET);
+            return 1;
+        }
+        if (SSD_BACKEND == NULL && errno != EINVAL) {
+            perror("Failed to start SSD emulator");
+            fv_close(TARGET);
+            return 1;
+        }
+        if (SSD_BACKEND == NULL) {
+            printf("Error: Cannot emulate %lu x %lu x %lu x %lu B NAND on a %lu byte target "
+                   "(needs page_size multiple of 4096, more than %d blocks per bank, under 2^32 pages)\n",
+                   geo.bank, geo.block, geo.page, geo.page_size, device_size, SSD_GC_RESERVE + 1);
+            fv_close(TARGET);
+            return 1;
+        }
+        // target이 ssd backend를 소유하고, ssd backend가 원래 backend를 소유
+        fv_set_backend(TARGET, SSD_BACKEND);
+        device_size = io_backend_ssd_logical_size(SSD_BACKEND);
+        printf("SSD emulator: %lu banks x %lu blocks x %lu pages x %lu B, %lu%% provisioned "
+               "(read %lu us, program %lu us, erase %lu us)\n",
+               geo.bank, geo.block, geo.page, geo.page_size, geo.provision_rate,
+               ssd_lat.read_us, ssd_lat.program_us, ssd_lat.erase_us);
     }
 
     printf("Device size: %llu bytes (%.2f GB)\n", (unsigned long long)device_size, device_size / (1024.0 * 1024.0 * 1024.0));
@@ -603,18 +3676,163 @@ int main(int argc, char *argv[]) {
 
     printf("Number of Sectors: %lu\n", NUM_SECTOR);
     printf("Number of I/O Blocks: %lu\n", NUM_BLOCKS);
+    // stripe 배수 block은 device를 나누어떨어지지 않을 수 있음: 마지막 자투리는 write/read 범위 밖
+    if (geometry_path != NULL && device_size % IO_BLOCK_SIZE != 0) {
+        printf("Note: Last %lu bytes fall outside the geometry block grid; read back with the same --geometry\n",
+               device_size % IO_BLOCK_SIZE);
+    }
     printf("Total Size to Test: %lu bytes (%.2f GB)\n", TOTAL_SIZE, TOTAL_SIZE / (1024.0 * 1024.0 * 1024.0));
     printf("Block device opened successfully!\n\n");
 
-    // Execute based on parsed arguments
+    if (TRIM_MAP_PATH != NULL) {
+        if (!trim_map_load(&TRIM_MAP, TRIM_MAP_PATH, NUM_SECTOR)) {
+            fv_close(TARGET);
+            return 1;
+        }
+        printf("Trim map: %s (%lu trimmed 4KB units)\n\n", TRIM_MAP_PATH, trim_map_count(&TRIM_MAP));
+    }
+
+    // 검증만 하는 실행은 journal을 읽기만 함
+    bool writes_data = !do_read && !do_corruption && !do_verify_since && fingerprint_file == NULL &&
+                       !(do_bank_test && !bank_write);
+    if (JOURNAL_PATH != NULL && writes_data) {
+        JOURNAL = write_journal_open(JOURNAL_PATH, NUM_SECTOR);
+        if (JOURNAL == NULL) {
+            fv_close(TARGET);
+            return 1;
+        }
+        printf("Write journal: %s (generation %lu)\n\n", JOURNAL_PATH, JOURNAL->generation);
+    }
+
+    // worker I/O backend
+    bool inject_faults = fault_cfg.eio_prob > 0.0 || fault_cfg.short_prob > 0.0 || fault_cfg.delay_prob > 0.0;
+    BACKEND = fv_backend(TARGET);
+    if (inject_faults) {
+        fault_cfg.seed = PAYLOAD_SEED_VALUE;
+        io_backend *fault = io_backend_fault(BACKEND, &fault_cfg);
+        if (fault == NULL) {
+            printf("Error: Failed to create I/O backend\n");
+            fv_close(TARGET);
+            return 1;
+        }
+        // target이 fault backend를 소유하고, fault backend가 원래 backend를 소유
+        fv_set_backend(TARGET, fault);
+        BACKEND = fault;
+    }
+    if (strcmp(IO_ENGINE, "direct") != 0) {
+        printf("I/O engine: %s\n\n", IO_ENGINE);
+    }
+    if (drop_cache) {
+        // dirty page를 먼저 내려야 DONTNEED로 제거됨
+        fdatasync(fv_fd(TARGET));
+        posix_fadvise(fv_fd(TARGET), 0, 0, POSIX_FADV_DONTNEED);
+    }
+    if (inject_faults) {
+        printf("Fault injection: EIO %g, short %g, delay %g x %lu us, LBA %lu-%lu, %s%s\n",
+               fault_cfg.eio_prob, fault_cfg.short_prob, fault_cfg.delay_prob, fault_cfg.delay_us,
+               fault_cfg.lba_start, fault_cfg.lba_end ? fault_cfg.lba_end : NUM_SECTOR,
+               fault_cfg.reads ? "reads" : "", fault_cfg.writes ? (fault_cfg.reads ? "+writes" : "writes") : "");
+        printf("Retry policy: %lu retries, backoff %lu us doubling\n\n", IO_RETRIES, RETRY_BACKOFF_US);
+    }
+
+    if (VERIFY_AFTER_FLUSH) {
+        BLOCK_EPOCH = calloc(NUM_BLOCKS, sizeof(*BLOCK_EPOCH));
+        if (BLOCK_EPOCH == NULL) {
+            perror("calloc");
+            fv_close(TARGET);
+            return 1;
+        }
+    }
+
+    if (SHM_NAME != NULL) {
+        SHM_STATS = shm_stats_create(SHM_NAME);
+        if (SHM_STATS == NULL) {
+            printf("Error: Failed to create stats segment '%s'\n", SHM_NAME);
+            fv_close(TARGET);
+            return 1;
+        }
+        printf("Live stats: /dev/shm/%s%s\n\n", SHM_STATS_PREFIX, SHM_NAME);
+    }
+
+    if (TRACE_PATH != NULL) {
+        if (!io_trace_open(TRACE_PATH, TRACE_THRESHOLD_US * 1000, TRACE_WINDOW,
+                           job_threads > omp_get_max_threads() ? job_threads : omp_get_max_threads())) {
+            printf("Error: Failed to open trace file '%s'\n", TRACE_PATH);
+            fv_close(TARGET);
+            return 1;
+        }
+        printf("I/O Trace: %s (threshold %lu us, window %u events)\n\n", TRACE_PATH, TRACE_THRESHOLD_US, TRACE_WINDOW);
+    }
+
+    int max_workers = job_threads > omp_get_max_threads() ? job_threads : omp_get_max_threads();
+    if (CPU_STATS && !phase_stats_init(max_workers)) {
+        printf("Error: Failed to allocate CPU accounting slots\n");
+        fv_close(TARGET);
+        return 1;
+    }
+
+    if (PERF_COUNTERS && !perf_counters_init(max_workers)) {
+        printf("Error: Failed to allocate perf counter slots\n");
+        fv_close(TARGET);
+        return 1;
+    }
+
+    // I/O 시간 측정이 필요하면 TSC 주파수를 미리 측정
+    IO_TIMING = SHM_STATS != NULL || TRACE_PATH != NULL || CPU_STATS || do_soak || do_sweep || do_bank_test;
+    if (IO_TIMING) {
+        tsc_hz();
+    }
+
+    if (MANIFEST_PATH != NULL && do_read) {
+        if (!fault_manifest_load(MANIFEST_PATH, &MANIFEST)) {
+            fv_close(TARGET);
+            return 1;
+        }
+        printf("Manifest: %s (%lu injected faults, seed %lu)\n\n", MANIFEST_PATH,
+               MANIFEST.header.count, MANIFEST.header.seed);
+        DETECT_START_NS = monotonic_ns();
+    }
+
+    // engine 비교용 page fault 수
+    struct rusage usage_start;
+    getrusage(RUSAGE_SELF, &usage_start);
+
+    // timer flush는 명령 실행 동안만 동작
+    time_t write_start = time(NULL);
+    atomic_bool flush_stop = false;
+    pthread_t flush_tid;
+    if (FLUSH_INTERVAL_MS) {
+        pthread_create(&flush_tid, NULL, flush_timer_thread, &flush_stop);
+    }
+
+    // Execute based on parsed arguments (검증 에러나 I/O 실패가 있으면 종료 코드 1)
+    int result = 0;
     if (do_write) {
-        initialize_memory();
+        result = initialize_memory();
     } else if (do_read) {
         if (do_random) {
-            test_random();
+            result = test_random();
         } else if (do_seq) {
-            test_sequential();
+            result = test_sequential();
         }
+    } else if (job_file != NULL) {
+        result = run_jobs(jobs, num_jobs);
+    } else if (replay_file != NULL) {
+        result = run_replay(replay_file, replay_speed, (int)replay_threads);
+    } else if (do_discard) {
+        result = run_discard(discard_type, discard_extent, discard_fraction);
+    } else if (do_sweep) {
+        result = run_sweep(&sweep);
+    } else if (do_bank_test) {
+        result = run_bank_test(bank_write, bank_target, bank_threads);
+    } else if (do_soak) {
+        result = run_soak(soak_passes, soak_seconds);
+    } else if (fingerprint_file != NULL) {
+        result = run_fingerprint(fingerprint_file, fp_leaf);
+    } else if (do_verify_since) {
+        result = run_verify_since(verify_since);
+    } else if (do_corruption && CORRUPT_RATE > 0.0) {
+        result = run_injection();
     } else if (do_corruption) {
         printf("\n=== Applying Data Corruption ===\n");
         corruption(1);
@@ -628,15 +3846,100 @@ int main(int argc, char *argv[]) {
         printf("\nAll corruption types applied successfully.\n");
     }
 
-    // 샘플 블록들의 CRC 값 출력 (write나 read 시에만)
-    if (do_write || do_read) {
+    if (strcmp(IO_ENGINE, "direct") != 0) {
+        print_engine_report(&usage_start);
+    }
+
+    if (inject_faults || IO_RETRIES) {
+        print_fault_report(inject_faults);
+    }
+
+    if (SSD_BACKEND != NULL) {
+        print_ssd_report();
+        if (SSD_STATE_PATH != NULL) {
+            if (io_backend_ssd_save(SSD_BACKEND, SSD_STATE_PATH)) {
+                printf("  FTL state saved to %s\n", SSD_STATE_PATH);
+            } else {
+                printf("Error: Cannot save SSD state '%s': %s\n", SSD_STATE_PATH, strerror(errno));
+            }
+        }
+    }
+
+    if (FORENSICS) {
+        print_forensics_report();
+        forensic_free(&FORENSIC_LOG);
+    }
+
+    if (MANIFEST.records != NULL) {
+        print_detection_report();
+        fault_manifest_free(&MANIFEST);
+    }
+
+    if (FLUSH_INTERVAL_MS) {
+        atomic_store(&flush_stop, true);
+        pthread_join(flush_tid, NULL);
+    }
+    if (durability) {
+        print_durability_report();
+    }
+    if (VERIFY_AFTER_FLUSH) {
+        if (verify_after_flush(write_start) != 0) {
+            result = 1;
+        }
+        free(BLOCK_EPOCH);
+    }
+
+    // 전체 실행 기준 phase 통계
+    if (CPU_STATS) {
+        uint64_t totals[PHASE_COUNT];
+        phase_stats_totals(totals);
+        printf("\n");
+        phase_stats_print("TOTAL", totals, BYTES_PROCESSED);
+    }
+
+    if (PERF_COUNTERS) {
+        perf_counters_report();
+    }
+
+    // 샘플 블록들의 CRC 값 출력 (write나 read 시에만, SSD emulator는 물리 위치가 달라 제외)
+    if ((do_write || do_read) && SSD_BACKEND == NULL) {
         print_sample_checksums();
     }
 
+    // write/discard로 바뀐 trim 상태 저장
+    if (TRIM_MAP.bits != NULL) {
+        if (!do_read && !do_corruption) {
+            trim_map_save(&TRIM_MAP, TRIM_MAP_PATH);
+        }
+        trim_map_free(&TRIM_MAP);
+    }
+
+    if (JOURNAL != NULL) {
+        uint64_t generation = JOURNAL->generation;
+        uint64_t records, sectors;
+        if (write_journal_close(JOURNAL, &records, &sectors)) {
+            printf("\nJournal generation %lu: %lu extents, %.2f MB written\n",
+                   generation, records, sectors * SECTOR_SIZE / (1024.0 * 1024.0));
+        } else {
+            result = 1;
+        }
+        JOURNAL = NULL;
+    }
+
     // 정리
     printf("\nCleaning up...\n");
-    close(device_fd);
+    if (SHM_STATS) {
+        shm_stats_destroy(SHM_STATS, SHM_NAME);
+    }
+    io_trace_close();
+    if (CPU_STATS) {
+        phase_stats_free();
+    }
+    if (PERF_COUNTERS) {
+        perf_counters_free();
+    }
+    fv_close(TARGET);
     printf("Done.\n");
 
-    return 0;
+    return result != 0 ? 1 : 0;
 }
\ No newline at end of file
@@ -0,0 +1,201 @@
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <dirent.h>
+#include <signal.h>
+#include <errno.h>
+
+#include "shm_stats.h"
+
+// fio_simulator --shm NAME 으로 공개된 통계를 읽는 observer
+// segment를 read-only로 mmap 하므로 observer 수와 무관하게 I/O loop에 영향 없음
+
+static const char *state_name(uint64_t state) {
+    switch (state) {
+        case SHM_THREAD_RUNNING: return "running";
+        case SHM_THREAD_DONE:    return "done";
+        default:                 return "idle";
+    }
+}
+
+// bucket 분포에서 백분위 latency (bucket 상한, us)
+static uint64_t percentile_us(const uint64_t *buckets, uint64_t total, double pct) {
+    if (total == 0) {
+        return 0;
+    }
+    uint64_t target = (uint64_t)(total * pct / 100.0);
+    uint64_t acc = 0;
+    for (int b = 0; b < SHM_STATS_LAT_BUCKETS; b++) {
+        acc += buckets[b];
+        if (acc > target) {
+            return 1ULL << b;
+        }
+    }
+    return 1ULL << (SHM_STATS_LAT_BUCKETS - 1);
+}
+
+static void list_segments(void) {
+    DIR *dir = opendir("/dev/shm");
+    if (dir == NULL) {
+        perror("opendir /dev/shm");
+        return;
+    }
+    printf("Available segments:\n");
+    struct dirent *ent;
+    size_t prefix_len = strlen(SHM_STATS_PREFIX);
+    while ((ent = readdir(dir)) != NULL) {
+        if (strncmp(ent->d_name, SHM_STATS_PREFIX, prefix_len) == 0) {
+            printf("  %s\n", ent->d_name + prefix_len);
+        }
+    }
+    closedir(dir);
+}
+
+static void print_usage(const char *prog_name) {
+    printf("Usage:\n");
+    printf("  %s                            : List published segments\n", prog_name);
+    printf("  %s NAME [options]             : Watch segment NAME\n", prog_name);
+    printf("\nOptions:\n");
+    printf("  --interval MS                 : Sample interval in milliseconds (default 500)\n");
+    printf("  --once                        : Print one sample and exit\n");
+    printf("  --threads                     : Also print per-thread state\n");
+}
+
+int main(int argc, char *argv[]) {
+    const char *name = NULL;
+    long interval_ms = 500;
+    bool once = false;
+    bool show_threads = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--interval") == 0 && i + 1 < argc) {
+            interval_ms = strtol(argv[++i], NULL, 10);
+            if (interval_ms <= 0) {
+                printf("Error: Invalid interval '%s'\n", argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--once") == 0) {
+            once = true;
+        } else if (strcmp(argv[i], "--threads") == 0) {
+            show_threads = true;
+        } else if (argv[i][0] != '-' && name == NULL) {
+            name = argv[i];
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (name == NULL) {
+        list_segments();
+        return 0;
+    }
+
+    shm_stats_segment *seg = shm_stats_attach(name);
+    if (seg == NULL) {
+        printf("Error: Cannot attach segment '%s' (missing or incompatible version)\n", name);
+        return 1;
+    }
+
+    uint64_t last_bytes = 0;
+    uint64_t last_ios = 0;
+    bool first_sample = true;
+    struct timespec last;
+    clock_gettime(CLOCK_MONOTONIC, &last);
+
+    while (1) {
+        char operation[16];
+        uint64_t total_size, start_ns, finished;
+        shm_stats_snapshot_run(seg, operation, &total_size, &start_ns, &finished);
+
+        uint64_t nthreads = atomic_load_explicit(&seg->nthreads, memory_order_acquire);
+        if (nthreads > SHM_STATS_MAX_THREADS) {
+            nthreads = SHM_STATS_MAX_THREADS;
+        }
+
+        shm_thread_snapshot sum;
+        memset(&sum, 0, sizeof(sum));
+        shm_thread_snapshot per_thread[SHM_STATS_MAX_THREADS];
+        for (uint64_t t = 0; t < nthreads; t++) {
+            shm_stats_snapshot_thread(seg, (int)t, &per_thread[t]);
+            sum.bytes += per_thread[t].bytes;
+            sum.ios += per_thread[t].ios;
+            sum.errors += per_thread[t].errors;
+            sum.failures += per_thread[t].failures;
+            for (int b = 0; b < SHM_STATS_LAT_BUCKETS; b++) {
+                sum.lat_buckets[b] += per_thread[t].lat_buckets[b];
+            }
+        }
+
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        double elapsed = (now.tv_sec - last.tv_sec) + (now.tv_nsec - last.tv_nsec) / 1e9;
+        if (elapsed <= 0.0) {
+            elapsed = 1e-9;
+        }
+        // 작업이 바뀌어 카운터가 초기화된 경우
+        if (sum.bytes < last_bytes || sum.ios < last_ios) {
+            last_bytes = 0;
+            last_ios = 0;
+        }
+
+        // 첫 sample은 작업 시작 시각 기준 평균
+        if (first_sample && start_ns != 0) {
+            struct timespec real;
+            clock_gettime(CLOCK_REALTIME, &real);
+            uint64_t real_ns = (uint64_t)real.tv_sec * 1000000000ULL + (uint64_t)real.tv_nsec;
+            if (real_ns > start_ns) {
+                elapsed = (real_ns - start_ns) / 1e9;
+            }
+        }
+        first_sample = false;
+
+        double throughput = (sum.bytes - last_bytes) / (1024.0 * 1024.0) / elapsed;
+        double iops = (sum.ios - last_ios) / elapsed;
+        int progress = total_size ? (int)((sum.bytes * 100) / total_size) : 0;
+        if (progress > 100) progress = 100;
+
+        printf("[%s pid %d] %.2f MB/s | %.0f IOPS | Total: %.2f MB | Progress: %d%% | "
+               "Errors: %lu | Failures: %lu | p50 <%luus p99 <%luus%s\n",
+               operation[0] ? operation : "-", seg->pid, throughput, iops,
+               sum.bytes / (1024.0 * 1024.0), progress, sum.errors, sum.failures,
+               percentile_us(sum.lat_buckets, sum.ios, 50.0),
+               percentile_us(sum.lat_buckets, sum.ios, 99.0),
+               finished ? " | finished" : "");
+
+        if (show_threads) {
+            for (uint64_t t = 0; t < nthreads; t++) {
+                printf("  thread %3lu: %-7s %10.2f MB  %8lu IOs  %lu errors  %lu failures\n",
+                       t, state_name(per_thread[t].state), per_thread[t].bytes / (1024.0 * 1024.0),
+                       per_thread[t].ios, per_thread[t].errors, per_thread[t].failures);
+            }
+        }
+        fflush(stdout);
+
+        if (once || finished) {
+            break;
+        }
+        // writer 프로세스가 사라진 경우 종료
+        if (kill(seg->pid, 0) == -1 && errno == ESRCH) {
+            printf("Process %d exited\n", seg->pid);
+            break;
+        }
+
+        last_bytes = sum.bytes;
+        last_ios = sum.ios;
+        last = now;
+
+        struct timespec sleep_time = {
+            .tv_sec = interval_ms / 1000,
+            .tv_nsec = (interval_ms % 1000) * 1000000L
+        };
+        nanosleep(&sleep_time, NULL);
+    }
+
+    return 0;
+}
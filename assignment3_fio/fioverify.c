@@ -0,0 +1,501 @@
+#define _GNU_SOURCE
+
+#include "fioverify.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <stdatomic.h>
+#include <sys/stat.h>
+#include <sys/ioctl.h>
+#include <linux/fs.h>
+#include <smmintrin.h>
+
+struct fv_target {
+    int fd;
+    uint64_t size;
+    bool is_file;
+    io_backend *backend;
+
+    payload_mode mode;
+    uint64_t seed;
+    uint64_t generation;
+    double dedupe_ratio;
+    size_t random_len;           // header 있는 섹터의 random byte 수
+    size_t dedupe_random_len;    // header 없는 dedupe 섹터의 random byte 수
+
+    uint32_t block_size;
+    uint32_t stats_interval_ms;
+    fv_error_callback on_error;
+    fv_stats_callback on_stats;
+    fv_trim_query is_trimmed;
+    bool check_generation;
+    void *user;
+};
+
+#define PAYLOAD_SIZE (FV_SECTOR_SIZE - sizeof(verify_header))
+
+fv_target *fv_open(const fv_config *cfg) {
+    uint32_t block_size = cfg->block_size ? cfg->block_size : FV_DEFAULT_BLOCK_SIZE;
+    if (cfg->path == NULL || block_size % FV_ALIGNMENT != 0 || cfg->compress_ratio < 0.0) {
+        errno = EINVAL;
+        return NULL;
+    }
+
+    fv_target *t = calloc(1, sizeof(fv_target));
+    if (t == NULL) {
+        return NULL;
+    }
+    t->fd = open(cfg->path, O_RDWR | O_DIRECT);
+    if (t->fd == -1) {
+        free(t);
+        return NULL;
+    }
+
+    // 일반 파일이면 파일 크기, 아니면 블록 디바이스 크기
+    struct stat st;
+    if (fstat(t->fd, &st) == 0 && S_ISREG(st.st_mode)) {
+        t->size = (uint64_t)st.st_size;
+        t->is_file = true;
+    } else if (ioctl(t->fd, BLKGETSIZE64, &t->size) == -1) {
+        int saved = errno;
+        close(t->fd);
+        free(t);
+        errno = saved;
+        return NULL;
+    }
+
+    t->backend = io_backend_create(cfg->engine ? cfg->engine : "direct", t->fd, cfg->path, t->size);
+    if (t->backend == NULL) {
+        int saved = errno;
+        close(t->fd);
+        free(t);
+        errno = saved;
+        return NULL;
+    }
+
+    double compress = cfg->compress_ratio > 0.0 ? cfg->compress_ratio : 1.0;
+    t->mode = cfg->mode;
+    t->seed = cfg->seed;
+    t->generation = cfg->generation;
+    t->dedupe_ratio = cfg->dedupe_ratio;
+    t->random_len = payload_random_len(FV_SECTOR_SIZE, sizeof(verify_header), compress);
+    t->dedupe_random_len = payload_random_len(FV_SECTOR_SIZE, 0, compress);
+    t->block_size = block_size;
+    t->stats_interval_ms = cfg->stats_interval_ms;
+    t->on_error = cfg->on_error;
+    t->on_stats = cfg->on_stats;
+    t->is_trimmed = cfg->is_trimmed;
+    t->check_generation = cfg->check_generation;
+    t->user = cfg->user;
+    return t;
+}
+
+void fv_close(fv_target *t) {
+    if (t == NULL) {
+        return;
+    }
+    io_backend_destroy(t->backend);
+    close(t->fd);
+    free(t);
+}
+
+uint64_t fv_size(const fv_target *t) {
+    return t->size;
+}
+
+int fv_fd(const fv_target *t) {
+    return t->fd;
+}
+
+bool fv_is_file(const fv_target *t) {
+    return t->is_file;
+}
+
+io_backend *fv_backend(const fv_target *t) {
+    return t->backend;
+}
+
+void fv_set_backend(fv_target *t, io_backend *backend) {
+    t->backend = backend;
+}
+
+void fv_set_generation(fv_target *t, uint64_t generation) {
+    t->generation = generation;
+}
+
+// CRC32 checksum 계산 함수
+uint32_t fv_crc32(const void *data, size_t length) {
+    uint32_t crc = 0xFFFFFFFF;
+    const uint64_t *buf = (const uint64_t*)data;
+
+    size_t i = 0;
+    for(; i < length/8; i++)
+    {
+        crc = _mm_crc32_u64(crc, buf[i]);
+    }
+    // i가 수행되고 남아있는 것들에 대해서 수행
+    const uint8_t *remaining = (const uint8_t*)(buf+i);
+    for (i = 0; i< length % 8; i++)
+    {
+        crc = _mm_crc32_u8(crc, remaining[i]);
+    }
+
+    return ~crc;
+}
+
+int fv_dedupe_slot(const fv_target *t, uint64_t lba) {
+    return payload_dedupe_slot(t->seed, lba - lba % FV_DEDUPE_UNIT_SECTORS, t->dedupe_ratio);
+}
+
+static inline uint64_t dedupe_key(const fv_target *t, int slot, uint64_t lba) {
+    return payload_dedupe_key(t->seed, slot, lba % FV_DEDUPE_UNIT_SECTORS, t->generation);
+}
+
+// 섹터 하나를 header + payload로 채움 (corruption 주입 시 다른 generation으로도 사용)
+void fv_fill_sector(const fv_target *t, unsigned char *sector, uint64_t lba, uint64_t timestamp, uint64_t generation) {
+    verify_header *header = (verify_header *)sector;
+    header->magic = VERIFY_MAGIC;
+    header->lba = lba;
+    header->timestamp = t->check_generation ? generation : timestamp;
+    header->offset = lba * FV_SECTOR_SIZE;
+
+    // 데이터 영역: (seed, LBA, generation)으로 생성
+    unsigned char *payload = sector + sizeof(verify_header);
+    uint64_t key = payload_key(t->seed, lba, generation);
+    payload_fill(key, payload, PAYLOAD_SIZE, t->random_len);
+
+    if (t->mode == PAYLOAD_SEED) {
+        // seed 모드: read 시 재생성 비교하므로 CRC 계산 없음
+        header->checksum = payload_key_tag(key);
+    } else {
+        header->checksum = fv_crc32(payload, PAYLOAD_SIZE);
+    }
+}
+
+// dedupe unit의 섹터는 header 없이 canonical 패턴으로 채움
+// 같은 slot의 unit은 LBA와 무관하게 byte 단위로 동일하다.
+void fv_fill_block(const fv_target *t, unsigned char *block, uint64_t start_lba, uint64_t sectors, uint64_t timestamp) {
+    for (uint64_t i = 0; i < sectors; i++) {
+        unsigned char *sector = block + i * FV_SECTOR_SIZE;
+        int slot = fv_dedupe_slot(t, start_lba + i);
+        if (slot >= 0) {
+            payload_fill(dedupe_key(t, slot, start_lba + i), sector, FV_SECTOR_SIZE, t->dedupe_random_len);
+        } else {
+            fv_fill_sector(t, sector, start_lba + i, timestamp, t->generation);
+        }
+    }
+}
+
+// 섹터 전체가 같은 byte인지 (trim 후 0x00/0xFF 등 결정적 패턴)
+bool fv_sector_is_uniform(const unsigned char *sector) {
+    uint64_t first;
+    memset(&first, sector[0], sizeof(first));
+    for (size_t i = 0; i < FV_SECTOR_SIZE; i += sizeof(uint64_t)) {
+        uint64_t w;
+        memcpy(&w, sector + i, sizeof(w));
+        if (w != first) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static inline bool target_trimmed(const fv_target *t, uint64_t lba) {
+    return t->is_trimmed != NULL && t->is_trimmed(lba, t->user);
+}
+
+// 에러 하나를 callback으로 전달, 항상 1 반환
+static int report(const fv_target *t, fv_error_kind kind, uint64_t lba, uint64_t expected, uint64_t actual,
+                  uint64_t timestamp, uint64_t byte, int slot) {
+    if (t->on_error != NULL) {
+        fv_error err = {
+            .kind = kind, .lba = lba, .expected = expected, .actual = actual,
+            .timestamp = timestamp, .byte = byte, .slot = slot
+        };
+        t->on_error(&err, t->user);
+    }
+    return 1;
+}
+
+static int verify_dedupe_sector(const fv_target *t, const unsigned char *sector, uint64_t lba, int slot,
+                                fv_block_result *result) {
+    // header가 없으므로 payload 모드와 무관하게 (seed, slot, unit 내 섹터 위치)로 재생성 비교
+    if (target_trimmed(t, lba) && fv_sector_is_uniform(sector)) {
+        result->trimmed++;
+        return 0;
+    }
+    uint64_t key = dedupe_key(t, slot, lba);
+    size_t diff = payload_verify(key, sector, FV_SECTOR_SIZE, t->dedupe_random_len);
+    if (diff != PAYLOAD_MATCH && fv_sector_is_uniform(sector) && sector[0] == 0) {
+        // canonical 패턴과 다른 0으로 채워진 섹터는 write되지 않은 것
+        result->unwritten++;
+        return 0;
+    }
+    if (diff != PAYLOAD_MATCH) {
+        return report(t, FV_ERR_DEDUPE, lba, payload_expected_byte(key, diff, t->dedupe_random_len),
+                      sector[diff], 0, diff, slot);
+    }
+    return 0;
+}
+
+int fv_verify_block(const fv_target *t, const unsigned char *block, uint64_t start_lba, uint64_t sectors,
+                    fv_block_result *result) {
+    fv_block_result local = {0};
+    if (result == NULL) {
+        result = &local;
+    }
+    result->unwritten = 0;
+    result->trimmed = 0;
+
+    int errors = 0;
+    for (uint64_t i = 0; i < sectors; i++) {
+        uint64_t lba = start_lba + i;
+        const unsigned char *sector = block + i * FV_SECTOR_SIZE;
+        const verify_header *header = (const verify_header *)sector;
+
+        int slot = fv_dedupe_slot(t, lba);
+        if (slot >= 0) {
+            errors += verify_dedupe_sector(t, sector, lba, slot, result);
+            continue;
+        }
+
+        // Magic number 확인 - write되지 않았거나 trim된 섹터는 skip
+        bool was_trimmed = target_trimmed(t, lba);
+        if (header->magic != VERIFY_MAGIC) {
+            if (was_trimmed && fv_sector_is_uniform(sector)) {
+                result->trimmed++;
+            } else if (was_trimmed) {
+                errors += report(t, FV_ERR_TRIM_DATA, lba, 0, 0, 0, 0, -1);
+            } else {
+                result->unwritten++;
+            }
+            continue;
+        }
+
+        // trim 이후 write 기록이 없는데 header가 남아 있으면 이전 데이터가 노출된 것
+        if (was_trimmed) {
+            errors += report(t, FV_ERR_TRIM_STALE, lba, lba, header->lba, header->timestamp, 0, -1);
+            continue;
+        }
+
+        if (header->lba != lba) {
+            errors += report(t, FV_ERR_LBA, lba, lba, header->lba, header->timestamp, 0, -1);
+            continue;
+        }
+
+        uint64_t expected_offset = lba * FV_SECTOR_SIZE;
+        if (header->offset != expected_offset) {
+            errors += report(t, FV_ERR_OFFSET, lba, expected_offset, header->offset, header->timestamp, 0, -1);
+            continue;
+        }
+
+        // 이전 pass에서 쓰인 섹터는 CRC가 맞아도 거부
+        if (t->check_generation && header->timestamp != t->generation) {
+            errors += report(t, FV_ERR_GENERATION, lba, t->generation, header->timestamp, header->timestamp, 0, -1);
+            continue;
+        }
+
+        const unsigned char *payload = sector + sizeof(verify_header);
+
+        // seed 모드: 기대 payload를 재생성하면서 SIMD 비교
+        if (t->mode == PAYLOAD_SEED) {
+            uint64_t key = payload_key(t->seed, lba, t->generation);
+            if (header->checksum != payload_key_tag(key)) {
+                errors += report(t, FV_ERR_SEED_TAG, lba, payload_key_tag(key), header->checksum,
+                                 header->timestamp, 0, -1);
+                continue;
+            }
+            size_t diff = payload_verify(key, payload, PAYLOAD_SIZE, t->random_len);
+            if (diff != PAYLOAD_MATCH) {
+                errors += report(t, FV_ERR_PAYLOAD, lba, payload_expected_byte(key, diff, t->random_len),
+                                 payload[diff], header->timestamp, diff, -1);
+            }
+            continue;
+        }
+
+        uint32_t calculated_checksum = fv_crc32(payload, PAYLOAD_SIZE);
+        if (calculated_checksum != header->checksum) {
+            errors += report(t, FV_ERR_CHECKSUM, lba, header->checksum, calculated_checksum,
+                             header->timestamp, 0, -1);
+        }
+    }
+    return errors;
+}
+
+void fv_inspect_sector(const fv_target *t, const unsigned char *sector, fv_sector_info *info) {
+    memset(info, 0, sizeof(*info));
+    const verify_header *header = (const verify_header *)sector;
+    if (header->magic != VERIFY_MAGIC) {
+        return;
+    }
+    info->has_header = true;
+    info->header_lba = header->lba;
+    if (header->offset != header->lba * FV_SECTOR_SIZE) {
+        return;
+    }
+
+    const unsigned char *payload = sector + sizeof(verify_header);
+    bool crc_ok = t->mode != PAYLOAD_SEED && fv_crc32(payload, PAYLOAD_SIZE) == header->checksum;
+
+    // check_generation 이면 header에 generation이 있음, 아니면 최근 generation부터 0까지 재생성 비교
+    uint64_t depth = FV_INSPECT_GENERATIONS;
+    if (!t->check_generation && t->generation < depth) {
+        depth = t->generation + 1;  // generation 0 아래로 wrap 방지
+    }
+    for (uint64_t back = 0; back < depth; back++) {
+        uint64_t generation = t->check_generation ? header->timestamp : t->generation - back;
+        uint64_t key = payload_key(t->seed, header->lba, generation);
+        bool tag_ok = t->mode != PAYLOAD_SEED || header->checksum == payload_key_tag(key);
+        if (tag_ok && payload_verify(key, payload, PAYLOAD_SIZE, t->random_len) == PAYLOAD_MATCH) {
+            info->intact = true;
+            info->generation_known = true;
+            info->generation = generation;
+            return;
+        }
+        if (t->check_generation) {
+            break;
+        }
+    }
+    // CRC가 맞으면 generation을 모르더라도 온전한 섹터
+    info->intact = crc_ok;
+}
+
+static bool block_in_range(const fv_target *t, uint64_t start_lba, size_t length) {
+    return length % FV_SECTOR_SIZE == 0 && start_lba * FV_SECTOR_SIZE + length <= t->size;
+}
+
+int fv_write_block(fv_target *t, unsigned char *buf, uint64_t start_lba, size_t length, uint64_t timestamp) {
+    if (!block_in_range(t, start_lba, length)) {
+        return -1;
+    }
+    fv_fill_block(t, buf, start_lba, length / FV_SECTOR_SIZE, timestamp);
+    ssize_t written = t->backend->pwrite(t->backend, buf, length, start_lba * FV_SECTOR_SIZE, false);
+    if (written != (ssize_t)length) {
+        report(t, FV_ERR_IO, start_lba, length, written < 0 ? 0 : (uint64_t)written, 0, 0, -1);
+        return -1;
+    }
+    return 0;
+}
+
+int fv_read_block(fv_target *t, unsigned char *buf, uint64_t start_lba, size_t length, fv_block_result *result) {
+    if (!block_in_range(t, start_lba, length)) {
+        return -1;
+    }
+    ssize_t bytes_read = t->backend->pread(t->backend, buf, length, start_lba * FV_SECTOR_SIZE);
+    if (bytes_read != (ssize_t)length) {
+        report(t, FV_ERR_IO, start_lba, length, bytes_read < 0 ? 0 : (uint64_t)bytes_read, 0, 0, -1);
+        return -1;
+    }
+    return fv_verify_block(t, buf, start_lba, length / FV_SECTOR_SIZE, result);
+}
+
+static uint64_t monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// scan 한 번의 집계 (호출마다 stack에 두므로 target 간 공유 없음)
+typedef struct {
+    atomic_uint_fast64_t bytes;
+    atomic_uint_fast64_t ios;
+    atomic_uint_fast64_t errors;
+    atomic_uint_fast64_t failures;
+    atomic_uint_fast64_t unwritten;
+    atomic_uint_fast64_t trimmed;
+    atomic_uint_fast64_t next_report_ns;
+    uint64_t start_ns;
+} scan_counters;
+
+static void scan_snapshot(scan_counters *c, fv_stats *out, bool finished) {
+    out->bytes = atomic_load(&c->bytes);
+    out->ios = atomic_load(&c->ios);
+    out->errors = atomic_load(&c->errors);
+    out->failures = atomic_load(&c->failures);
+    out->unwritten = atomic_load(&c->unwritten);
+    out->trimmed = atomic_load(&c->trimmed);
+    out->elapsed_ns = monotonic_ns() - c->start_ns;
+    out->finished = finished;
+}
+
+// 주기가 지났으면 먼저 CAS에 성공한 worker 하나만 on_stats 호출
+static void scan_maybe_report(const fv_target *t, scan_counters *c) {
+    if (t->on_stats == NULL || t->stats_interval_ms == 0) {
+        return;
+    }
+    uint64_t now = monotonic_ns();
+    uint64_t due = atomic_load(&c->next_report_ns);
+    if (now < due || !atomic_compare_exchange_strong(&c->next_report_ns, &due,
+                                                     now + t->stats_interval_ms * 1000000ULL)) {
+        return;
+    }
+    fv_stats stats;
+    scan_snapshot(c, &stats, false);
+    t->on_stats(&stats, t->user);
+}
+
+int64_t fv_scan(fv_target *t, bool write, uint64_t start_lba, uint64_t sectors, uint64_t timestamp, fv_stats *out) {
+    uint64_t total = sectors * FV_SECTOR_SIZE;
+    if (sectors == 0 || !block_in_range(t, start_lba, total)) {
+        errno = EINVAL;
+        return -1;
+    }
+    uint64_t block_sectors = t->block_size / FV_SECTOR_SIZE;
+    uint64_t blocks = (sectors + block_sectors - 1) / block_sectors;
+
+    scan_counters c;
+    memset(&c, 0, sizeof(c));
+    c.start_ns = monotonic_ns();
+    atomic_store(&c.next_report_ns, c.start_ns + t->stats_interval_ms * 1000000ULL);
+    io_backend_advise(t->backend, IO_PATTERN_SEQUENTIAL);
+
+    #pragma omp parallel
+    {
+        unsigned char *buf = NULL;
+        if (posix_memalign((void **)&buf, FV_ALIGNMENT, t->block_size) != 0) {
+            buf = NULL;
+        }
+
+        #pragma omp for schedule(dynamic, 16)
+        for (uint64_t b = 0; b < blocks; b++) {
+            uint64_t lba = start_lba + b * block_sectors;
+            uint64_t n = sectors - b * block_sectors < block_sectors ? sectors - b * block_sectors : block_sectors;
+            size_t length = n * FV_SECTOR_SIZE;
+
+            fv_block_result r = {0};
+            int result = buf == NULL ? -1
+                       : write ? fv_write_block(t, buf, lba, length, timestamp)
+                               : fv_read_block(t, buf, lba, length, &r);
+            if (result < 0) {
+                atomic_fetch_add(&c.failures, 1);
+            } else {
+                atomic_fetch_add(&c.errors, (uint64_t)result);
+                atomic_fetch_add(&c.bytes, length);
+            }
+            if (r.unwritten) {
+                atomic_fetch_add(&c.unwritten, r.unwritten);
+            }
+            if (r.trimmed) {
+                atomic_fetch_add(&c.trimmed, r.trimmed);
+            }
+            atomic_fetch_add(&c.ios, 1);
+            scan_maybe_report(t, &c);
+        }
+        free(buf);
+    }
+
+    fv_stats stats;
+    scan_snapshot(&c, &stats, true);
+    if (t->on_stats != NULL) {
+        t->on_stats(&stats, t->user);
+    }
+    if (out != NULL) {
+        *out = stats;
+    }
+    return (int64_t)(stats.errors + stats.failures);
+}
@@ -0,0 +1,151 @@
+#ifndef FIOVERIFY_H
+#define FIOVERIFY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "payload.h"
+#include "io_backend.h"
+
+// libfioverify: 섹터 header 형식, payload 생성/검증, target I/O를 담은 재진입 가능 library
+// 전역 상태 없이 target(fv_target)마다 설정과 backend를 가지므로
+// 한 프로세스에서 여러 target을 동시에 scrub 할 수 있다.
+// 에러/통계는 callback으로 전달 (callback은 worker thread에서 동시에 호출될 수 있음)
+// fio_simulator는 이 library 위의 CLI: 섹터 형식/검증/backend I/O는 여기서 하고,
+// workload 스케줄링(jobs, sweep, soak, replay, bank-test)과 출력만 CLI 전역 상태로 남음
+
+#define FV_SECTOR_SIZE        512
+#define FV_DEFAULT_BLOCK_SIZE (128 * 1024)
+#define FV_ALIGNMENT          4096
+
+// dedupe 판정 단위 (4K): I/O block 크기와 무관하게 LBA로 결정되므로 다른 bs로 읽어도 검증 가능
+#define FV_DEDUPE_UNIT_SECTORS (FV_ALIGNMENT / FV_SECTOR_SIZE)
+
+// 섹터 앞에 기록하는 verify_header
+#define VERIFY_MAGIC 0xDEADBEEF
+typedef struct {
+    uint32_t magic;        // Magic number for validation
+    uint64_t lba;          // Logical Block Address
+    uint64_t timestamp;    // 시간 (check_generation 이면 write generation)
+    uint32_t checksum;     // CRC32 체크섬 (seed 모드는 key tag)
+    uint64_t offset;       // 메모리 오프셋
+} verify_header;
+
+// 검증 실패 종류
+typedef enum {
+    FV_ERR_IO = 0,         // read/write 실패 (lba = 블록 시작)
+    FV_ERR_LBA,            // header LBA 불일치
+    FV_ERR_OFFSET,         // header offset 불일치
+    FV_ERR_CHECKSUM,       // CRC 불일치
+    FV_ERR_SEED_TAG,       // seed/generation tag 불일치
+    FV_ERR_PAYLOAD,        // 재생성한 payload와 불일치
+    FV_ERR_DEDUPE,         // dedupe unit 불일치
+    FV_ERR_TRIM_STALE,     // trim된 영역에 이전 header가 남아 있음
+    FV_ERR_TRIM_DATA,      // trim된 영역에 비결정적 data
+    FV_ERR_GENERATION,     // header의 generation이 현재 pass와 다름 (이전 pass 데이터)
+} fv_error_kind;
+
+typedef struct {
+    fv_error_kind kind;
+    uint64_t lba;
+    uint64_t expected;     // 종류별 기대값 (LBA, offset, checksum/tag, byte 값)
+    uint64_t actual;
+    uint64_t timestamp;    // header timestamp (header가 있는 경우)
+    uint64_t byte;         // payload/dedupe 불일치 byte 위치
+    int slot;              // dedupe slot
+} fv_error;
+
+// 에러 섹터 내용 분석 (forensics): header가 주장하는 LBA의 데이터로서 온전한지
+#define FV_INSPECT_GENERATIONS 16      // 현재 generation부터 거슬러 확인하는 개수
+
+typedef struct {
+    bool has_header;
+    bool intact;              // header LBA 기준 payload/checksum/offset이 모두 맞음
+    bool generation_known;    // intact이고 어떤 generation의 데이터인지 확인됨
+    uint64_t header_lba;
+    uint64_t generation;
+} fv_sector_info;
+
+// 블록 하나의 magic 없는 섹터 분류
+typedef struct {
+    uint64_t unwritten;
+    uint64_t trimmed;
+} fv_block_result;
+
+// fv_scan 진행 통계
+typedef struct {
+    uint64_t bytes;
+    uint64_t ios;
+    uint64_t errors;       // 검증 실패 섹터 수
+    uint64_t failures;     // I/O 실패 블록 수
+    uint64_t unwritten;
+    uint64_t trimmed;
+    uint64_t elapsed_ns;
+    bool finished;
+} fv_stats;
+
+typedef void (*fv_error_callback)(const fv_error *err, void *user);
+typedef void (*fv_stats_callback)(const fv_stats *stats, void *user);
+typedef bool (*fv_trim_query)(uint64_t lba, void *user);   // lba가 discard된 영역인지
+
+typedef struct {
+    const char *path;
+    const char *engine;              // "direct"(NULL), "buffered", "mmap"
+    payload_mode mode;
+    uint64_t seed;
+    uint64_t generation;
+    double compress_ratio;           // 1.0 = 압축 불가
+    double dedupe_ratio;             // 0.0 = dedupe 없음
+    uint32_t block_size;             // fv_scan I/O 단위, 0이면 FV_DEFAULT_BLOCK_SIZE
+    uint32_t stats_interval_ms;      // fv_scan on_stats 주기, 0이면 종료 시에만
+    fv_error_callback on_error;      // NULL 가능
+    fv_stats_callback on_stats;      // NULL 가능
+    fv_trim_query is_trimmed;        // NULL이면 trim 기록 없음
+    bool check_generation;           // header timestamp = generation, 다른 generation 섹터는 에러
+    void *user;
+} fv_config;
+
+typedef struct fv_target fv_target;
+
+// target 열기 (O_DIRECT), 실패 시 NULL (errno 유지)
+fv_target *fv_open(const fv_config *cfg);
+void fv_close(fv_target *t);
+
+uint64_t fv_size(const fv_target *t);
+int fv_fd(const fv_target *t);
+bool fv_is_file(const fv_target *t);
+
+// worker I/O backend, 교체 시 새 backend가 이전 것을 소유해야 함 (fault wrapper 등)
+io_backend *fv_backend(const fv_target *t);
+void fv_set_backend(fv_target *t, io_backend *backend);
+
+// 이후 write/verify에 사용할 generation (soak pass 전환 시)
+void fv_set_generation(fv_target *t, uint64_t generation);
+
+// header payload CRC32 (SSE4.2)
+uint32_t fv_crc32(const void *data, size_t length);
+
+// buffer 단위 생성/검증 (I/O 없음, thread-safe)
+void fv_fill_sector(const fv_target *t, unsigned char *sector, uint64_t lba, uint64_t timestamp, uint64_t generation);
+void fv_fill_block(const fv_target *t, unsigned char *block, uint64_t start_lba, uint64_t sectors, uint64_t timestamp);
+// lba가 속한 dedupe unit의 slot, dedupe 대상이 아니면 -1
+int fv_dedupe_slot(const fv_target *t, uint64_t lba);
+bool fv_sector_is_uniform(const unsigned char *sector);
+
+// header가 가리키는 LBA와 최근 FV_INSPECT_GENERATIONS 개 generation으로 섹터를 재검사
+void fv_inspect_sector(const fv_target *t, const unsigned char *sector, fv_sector_info *info);
+
+// 에러 섹터 수 반환, 각 에러는 on_error로 전달
+int fv_verify_block(const fv_target *t, const unsigned char *block, uint64_t start_lba, uint64_t sectors,
+                    fv_block_result *result);
+
+// backend를 통한 블록 I/O (buf는 FV_ALIGNMENT 정렬), 실패 시 -1
+int fv_write_block(fv_target *t, unsigned char *buf, uint64_t start_lba, size_t length, uint64_t timestamp);
+int fv_read_block(fv_target *t, unsigned char *buf, uint64_t start_lba, size_t length, fv_block_result *result);
+
+// [start_lba, start_lba + sectors) 범위를 block_size 단위로 병렬 write 또는 read+검증
+// 검증 실패 섹터 수 + I/O 실패 블록 수 반환, 범위가 잘못되면 -1
+int64_t fv_scan(fv_target *t, bool write, uint64_t start_lba, uint64_t sectors, uint64_t timestamp, fv_stats *out);
+
+#endif
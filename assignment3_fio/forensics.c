@@ -0,0 +1,261 @@
+#include "forensics.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static const char *CLASS_NAMES[FORENSIC_CLASS_COUNT] = {
+    "misdirected", "lost-write", "stale", "corruption"
+};
+
+const char *forensic_class_name(forensic_class cls) {
+    return cls < FORENSIC_CLASS_COUNT ? CLASS_NAMES[cls] : "unknown";
+}
+
+void forensic_init(forensic_log *log) {
+    memset(log, 0, sizeof(*log));
+    pthread_mutex_init(&log->lock, NULL);
+}
+
+void forensic_free(forensic_log *log) {
+    free(log->records);
+    log->records = NULL;
+    log->count = 0;
+    log->capacity = 0;
+    pthread_mutex_destroy(&log->lock);
+}
+
+// lock을 잡은 상태에서 호출
+static forensic_record *push(forensic_log *log) {
+    if (log->count == log->capacity) {
+        uint64_t capacity = log->capacity ? log->capacity * 2 : 256;
+        forensic_record *grown = realloc(log->records, capacity * sizeof(forensic_record));
+        if (grown == NULL) {
+            log->overflow = true;
+            return NULL;
+        }
+        log->records = grown;
+        log->capacity = capacity;
+    }
+    forensic_record *rec = &log->records[log->count++];
+    memset(rec, 0, sizeof(*rec));
+    rec->peer = FORENSIC_NO_PEER;
+    return rec;
+}
+
+void forensic_add(forensic_log *log, uint64_t lba, fv_error_kind kind, const fv_sector_info *info) {
+    pthread_mutex_lock(&log->lock);
+    forensic_record *rec = push(log);
+    if (rec != NULL) {
+        rec->lba = lba;
+        rec->kind = (uint32_t)kind;
+        rec->header_lba = info->header_lba;
+        rec->generation = info->generation;
+        rec->has_header = info->has_header;
+        rec->intact = info->intact;
+        rec->generation_known = info->generation_known;
+    }
+    pthread_mutex_unlock(&log->lock);
+}
+
+static int compare_records(const void *a, const void *b) {
+    const forensic_record *ra = a, *rb = b;
+    return (ra->lba > rb->lba) - (ra->lba < rb->lba);
+}
+
+// 정렬된 앞쪽 count개에서 이진 탐색
+static const forensic_record *find_sorted(const forensic_record *records, uint64_t count, uint64_t lba) {
+    uint64_t lo = 0, hi = count;
+    while (lo < hi) {
+        uint64_t mid = lo + (hi - lo) / 2;
+        if (records[mid].lba < lba) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return (lo < count && records[lo].lba == lba) ? &records[lo] : NULL;
+}
+
+const forensic_record *forensic_find(const forensic_log *log, uint64_t lba) {
+    return find_sorted(log->records, log->count, lba);
+}
+
+// LBA -> record index (open addressing, 빈 slot의 key는 UINT64_MAX)
+typedef struct {
+    uint64_t *keys;
+    uint64_t *values;
+    uint64_t mask;
+} lba_map;
+
+static inline uint64_t hash_lba(uint64_t lba) {
+    lba ^= lba >> 33;
+    lba *= 0xff51afd7ed558ccdULL;
+    lba ^= lba >> 33;
+    return lba;
+}
+
+// entries개를 넣어도 절반 이하로 차도록 slot 할당
+static bool lba_map_init(lba_map *map, uint64_t entries) {
+    uint64_t slots = 16;
+    while (slots < entries * 2) {
+        slots *= 2;
+    }
+    map->mask = slots - 1;
+    map->keys = malloc(slots * sizeof(uint64_t));
+    map->values = malloc(slots * sizeof(uint64_t));
+    if (map->keys == NULL || map->values == NULL) {
+        free(map->keys);
+        free(map->values);
+        return false;
+    }
+    memset(map->keys, 0xFF, slots * sizeof(uint64_t));
+    return true;
+}
+
+static void lba_map_free(lba_map *map) {
+    free(map->keys);
+    free(map->values);
+}
+
+// lba가 있는 slot, 없으면 넣을 빈 slot
+static uint64_t lba_map_slot(const lba_map *map, uint64_t lba) {
+    uint64_t h = hash_lba(lba) & map->mask;
+    while (map->keys[h] != UINT64_MAX && map->keys[h] != lba) {
+        h = (h + 1) & map->mask;
+    }
+    return h;
+}
+
+static int64_t lba_map_find(const lba_map *map, uint64_t lba) {
+    uint64_t h = lba_map_slot(map, lba);
+    return map->keys[h] == UINT64_MAX ? -1 : (int64_t)map->values[h];
+}
+
+// 역방향 map: 다른 위치에서 발견된 온전한 데이터의 header LBA -> record index
+static bool reverse_map_build(lba_map *map, const forensic_log *log) {
+    uint64_t foreign = 0;
+    for (uint64_t i = 0; i < log->count; i++) {
+        const forensic_record *r = &log->records[i];
+        foreign += r->has_header && r->intact && r->header_lba != r->lba;
+    }
+    if (!lba_map_init(map, foreign)) {
+        return false;
+    }
+
+    for (uint64_t i = 0; i < log->count; i++) {
+        const forensic_record *r = &log->records[i];
+        if (!(r->has_header && r->intact && r->header_lba != r->lba)) {
+            continue;
+        }
+        uint64_t h = lba_map_slot(map, r->header_lba);
+        // 같은 LBA의 데이터가 여러 곳에 있으면 가장 최신 generation을 유지
+        if (map->keys[h] == UINT64_MAX || log->records[map->values[h]].generation < r->generation) {
+            map->keys[h] = r->header_lba;
+            map->values[h] = i;
+        }
+    }
+    return true;
+}
+
+void forensic_classify(forensic_log *log, uint64_t generation, forensic_read_sector read, void *user,
+                       uint64_t counts[FORENSIC_CLASS_COUNT]) {
+    memset(counts, 0, FORENSIC_CLASS_COUNT * sizeof(uint64_t));
+
+    // 같은 섹터가 여러 번 보고될 수 있으므로 (job 재read 등) 물리 LBA 기준 중복 제거
+    qsort(log->records, log->count, sizeof(forensic_record), compare_records);
+    uint64_t unique = 0;
+    for (uint64_t i = 0; i < log->count; i++) {
+        if (unique == 0 || log->records[unique - 1].lba != log->records[i].lba) {
+            log->records[unique++] = log->records[i];
+        }
+    }
+    log->count = unique;
+
+    lba_map map;
+    if (!reverse_map_build(&map, log)) {
+        log->overflow = true;
+        return;
+    }
+
+    for (uint64_t i = 0; i < log->count; i++) {
+        forensic_record *r = &log->records[i];
+        if (r->has_header && r->header_lba != r->lba) {
+            // 다른 LBA로 가야 할 write가 이 위치에 기록됨
+            r->cls = r->intact ? FORENSIC_MISDIRECTED : FORENSIC_CORRUPTION;
+            r->peer = r->intact ? r->header_lba : FORENSIC_NO_PEER;
+            continue;
+        }
+
+        // 이 LBA의 데이터가 다른 위치에서 발견되면 write가 잘못 전달되어 유실된 것
+        int64_t found = lba_map_find(&map, r->lba);
+        if (found >= 0) {
+            r->cls = FORENSIC_LOST_WRITE;
+            r->peer = log->records[found].lba;
+        } else if (r->has_header && r->intact &&
+                   (!r->generation_known || r->generation != generation || r->kind == FV_ERR_TRIM_STALE)) {
+            r->cls = FORENSIC_STALE;
+        } else {
+            r->cls = FORENSIC_CORRUPTION;
+        }
+    }
+
+    // misdirected write의 target이 검증 에러가 아니었다면 직접 읽어서 유실 여부 확인
+    // 이미 읽은 target은 derived map (LBA hash)으로 건너뜀: 추가한 record를 매번 다시 훑지 않음
+    uint64_t scanned = log->count;
+    uint64_t misdirected = 0;
+    for (uint64_t i = 0; i < scanned; i++) {
+        misdirected += log->records[i].cls == FORENSIC_MISDIRECTED;
+    }
+    lba_map derived = {0};
+    if (read != NULL && !lba_map_init(&derived, misdirected)) {
+        log->overflow = true;
+        read = NULL;
+    }
+    for (uint64_t i = 0; i < scanned && read != NULL; i++) {
+        if (log->records[i].cls != FORENSIC_MISDIRECTED) {
+            continue;
+        }
+        uint64_t target = log->records[i].header_lba;
+        uint64_t source = log->records[i].lba;
+        uint64_t slot = lba_map_slot(&derived, target);
+        if (derived.keys[slot] != UINT64_MAX || find_sorted(log->records, scanned, target) != NULL) {
+            continue;
+        }
+        // 읽기 결과와 무관하게 같은 target은 다시 읽지 않음
+        derived.keys[slot] = target;
+        derived.values[slot] = i;
+        fv_sector_info info;
+        if (!read(target, &info, user)) {
+            continue;
+        }
+        // target에 최신 데이터가 온전히 있으면 단순 중복 기록
+        if (info.has_header && info.intact && info.header_lba == target &&
+            info.generation_known && info.generation == generation) {
+            continue;
+        }
+        forensic_record *rec = push(log);
+        if (rec == NULL) {
+            break;
+        }
+        rec->lba = target;
+        rec->kind = FV_ERR_LBA;
+        rec->header_lba = info.header_lba;
+        rec->generation = info.generation;
+        rec->has_header = info.has_header;
+        rec->intact = info.intact;
+        rec->generation_known = info.generation_known;
+        rec->derived = 1;
+        rec->cls = FORENSIC_LOST_WRITE;
+        rec->peer = source;
+    }
+    lba_map_free(&derived);
+    lba_map_free(&map);
+
+    // 추가된 record 포함 다시 정렬
+    if (log->count > scanned) {
+        qsort(log->records, log->count, sizeof(forensic_record), compare_records);
+    }
+    for (uint64_t i = 0; i < log->count; i++) {
+        counts[log->records[i].cls]++;
+    }
+}
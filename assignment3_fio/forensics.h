@@ -0,0 +1,64 @@
+#ifndef FORENSICS_H
+#define FORENSICS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+#include "fioverify.h"
+
+// 검증 실패 섹터의 원인 분석 (--forensics)
+// scan 중에는 에러 섹터만 기록하고, scan 후 header LBA -> 물리 위치 역방향 map을 만들어
+// 각 에러를 misdirected / lost write / stale generation / corruption 으로 분류한다.
+// 메모리는 device 크기가 아니라 에러 수에 비례
+
+typedef enum {
+    FORENSIC_MISDIRECTED = 0,   // 다른 LBA의 온전한 데이터가 이 위치에 있음
+    FORENSIC_LOST_WRITE,        // 이 LBA의 최신 데이터가 없음 (다른 위치에서 발견되었거나 header 없음)
+    FORENSIC_STALE,             // 이 LBA의 이전 generation 데이터가 온전히 남아 있음
+    FORENSIC_CORRUPTION,        // 어느 LBA/generation과도 맞지 않는 손상
+    FORENSIC_CLASS_COUNT
+} forensic_class;
+
+#define FORENSIC_NO_PEER UINT64_MAX
+
+typedef struct {
+    uint64_t lba;               // 물리 위치
+    uint64_t header_lba;
+    uint64_t generation;
+    uint64_t peer;              // misdirected: header LBA, lost write: 데이터가 발견된 위치
+    uint32_t kind;              // 처음 보고된 fv_error_kind
+    uint8_t has_header;
+    uint8_t intact;
+    uint8_t generation_known;
+    uint8_t derived;            // 검증 에러가 아니라 분석 중 target을 다시 읽어 찾은 것
+    forensic_class cls;
+} forensic_record;
+
+typedef struct {
+    pthread_mutex_t lock;
+    forensic_record *records;
+    uint64_t count;
+    uint64_t capacity;
+    bool overflow;              // 메모리 부족으로 누락된 기록이 있음
+} forensic_log;
+
+// 분석 중 misdirected write의 target 섹터를 다시 읽는 callback, 실패 시 false
+typedef bool (*forensic_read_sector)(uint64_t lba, fv_sector_info *info, void *user);
+
+const char *forensic_class_name(forensic_class cls);
+
+void forensic_init(forensic_log *log);
+void forensic_free(forensic_log *log);
+
+// 여러 thread에서 동시 호출 가능
+void forensic_add(forensic_log *log, uint64_t lba, fv_error_kind kind, const fv_sector_info *info);
+
+// scan이 끝난 뒤 호출: 물리 LBA 순 정렬/중복 제거 후 분류, counts[FORENSIC_CLASS_COUNT] 집계
+void forensic_classify(forensic_log *log, uint64_t generation, forensic_read_sector read, void *user,
+                       uint64_t counts[FORENSIC_CLASS_COUNT]);
+
+// 물리 LBA의 record, 없으면 NULL (forensic_classify 이후)
+const forensic_record *forensic_find(const forensic_log *log, uint64_t lba);
+
+#endif
@@ -0,0 +1,93 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "fingerprint.h"
+
+// fio_simulator --fingerprint 로 만든 두 파일 비교
+// root가 같고 읽지 못한 leaf가 없으면 즉시 종료, 아니면 다른 subtree만 내려가며 byte 구간 출력
+// 어느 한쪽에서 읽지 못한 leaf는 hash가 같더라도 다른 구간으로 출력
+
+typedef struct {
+    const fingerprint *fp;
+    uint64_t regions;
+    uint64_t max_regions;
+} diff_print_context;
+
+static void print_region(uint64_t first_leaf, uint64_t last_leaf, void *arg) {
+    diff_print_context *ctx = (diff_print_context *)arg;
+    ctx->regions++;
+    if (ctx->max_regions && ctx->regions > ctx->max_regions) {
+        return;
+    }
+    uint64_t start = first_leaf * ctx->fp->header.leaf_size;
+    uint64_t end = (last_leaf + 1) * ctx->fp->header.leaf_size;
+    if (end > ctx->fp->header.device_size) {
+        end = ctx->fp->header.device_size;
+    }
+    printf("  [%lu, %lu) bytes, LBA %lu-%lu, %lu leaves\n",
+           start, end, start / 512, end / 512 - 1, last_leaf - first_leaf + 1);
+}
+
+static void print_usage(const char *prog_name) {
+    printf("Usage:\n");
+    printf("  %s FINGERPRINT_A FINGERPRINT_B [--max-regions N]\n", prog_name);
+    printf("\nOptions:\n");
+    printf("  --max-regions N               : Print at most N differing regions (default all)\n");
+    printf("\nExit status: 0 identical, 1 different, 2 error\n");
+}
+
+int main(int argc, char *argv[]) {
+    uint64_t max_regions = 0;
+    if (argc == 5 && strcmp(argv[3], "--max-regions") == 0) {
+        max_regions = strtoull(argv[4], NULL, 0);
+    } else if (argc != 3) {
+        print_usage(argv[0]);
+        return 2;
+    }
+
+    fingerprint a, b;
+    if (!fp_load(argv[1], &a)) {
+        return 2;
+    }
+    if (!fp_load(argv[2], &b)) {
+        fp_free(&a);
+        return 2;
+    }
+
+    uint64_t failed_a = fp_failed_count(&a);
+    uint64_t failed_b = fp_failed_count(&b);
+    printf("A: root %016lx (%lu leaves of %lu bytes, %lu unreadable)\n",
+           a.header.root, a.header.leaf_count, a.header.leaf_size, failed_a);
+    printf("B: root %016lx (%lu leaves of %lu bytes, %lu unreadable)\n",
+           b.header.root, b.header.leaf_count, b.header.leaf_size, failed_b);
+
+    int status = 0;
+    if (a.header.root == b.header.root && a.header.device_size == b.header.device_size &&
+        a.header.leaf_size == b.header.leaf_size && failed_a == 0 && failed_b == 0) {
+        printf("Identical\n");
+    } else {
+        diff_print_context ctx = { .fp = &a, .max_regions = max_regions };
+        printf("Differing regions:\n");
+        int64_t leaves = fp_diff(&a, &b, print_region, &ctx);
+        if (leaves < 0) {
+            printf("Error: Fingerprints cover different device or leaf sizes\n");
+            status = 2;
+        } else {
+            if (max_regions && ctx.regions > max_regions) {
+                printf("  ... %lu more regions\n", ctx.regions - max_regions);
+            }
+            printf("%lu regions, %ld differing leaves (%.2f MB)\n", ctx.regions, leaves,
+                   leaves * (double)a.header.leaf_size / (1024.0 * 1024.0));
+            status = 1;
+        }
+    }
+
+    fp_free(&a);
+    fp_free(&b);
+    return status;
+}
@@ -0,0 +1,397 @@
+#define _GNU_SOURCE
+
+#include "io_backend.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <time.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/uio.h>
+#include <sys/mman.h>
+
+#define SECTOR_BYTES 512
+#define PAGE_BYTES 4096
+
+// direct backend
+typedef struct {
+    io_backend base;
+    int fd;
+} direct_backend;
+
+static ssize_t direct_pread(io_backend *be, void *buf, size_t len, uint64_t offset) {
+    return pread(((direct_backend *)be)->fd, buf, len, (off_t)offset);
+}
+
+static ssize_t direct_pwrite(io_backend *be, const void *buf, size_t len, uint64_t offset, bool dsync) {
+    int fd = ((direct_backend *)be)->fd;
+    if (dsync) {
+        struct iovec iov = { .iov_base = (void *)buf, .iov_len = len };
+        return pwritev2(fd, &iov, 1, (off_t)offset, RWF_DSYNC);
+    }
+    return pwrite(fd, buf, len, (off_t)offset);
+}
+
+static int direct_flush(io_backend *be) {
+    return fdatasync(((direct_backend *)be)->fd);
+}
+
+static void direct_destroy(io_backend *be) {
+    free(be);
+}
+
+io_backend *io_backend_direct(int fd) {
+    direct_backend *be = calloc(1, sizeof(direct_backend));
+    if (be == NULL) {
+        return NULL;
+    }
+    be->base.name = "direct";
+    be->base.pread = direct_pread;
+    be->base.pwrite = direct_pwrite;
+    be->base.flush = direct_flush;
+    be->base.destroy = direct_destroy;
+    be->fd = fd;
+    return &be->base;
+}
+
+// page cache 적중 측정: target 매핑에 대해 read 직전 mincore
+typedef struct {
+    unsigned char *map;              // PROT_READ 이상으로 매핑된 target 전체
+    uint64_t size;
+    atomic_uint_fast64_t read_pages;
+    atomic_uint_fast64_t cached_pages;
+} cache_probe;
+
+static void cache_probe_read(cache_probe *probe, size_t len, uint64_t offset) {
+    if (probe->map == NULL || len == 0) {
+        return;
+    }
+    uint64_t first = offset / PAGE_BYTES;
+    uint64_t last = (offset + len + PAGE_BYTES - 1) / PAGE_BYTES;
+    uint64_t cached = 0;
+    unsigned char vec[256];
+    for (uint64_t page = first; page < last; page += sizeof(vec)) {
+        uint64_t n = last - page < sizeof(vec) ? last - page : sizeof(vec);
+        if (mincore(probe->map + page * PAGE_BYTES, n * PAGE_BYTES, vec) != 0) {
+            return;
+        }
+        for (uint64_t i = 0; i < n; i++) {
+            cached += vec[i] & 1;
+        }
+    }
+    atomic_fetch_add_explicit(&probe->read_pages, last - first, memory_order_relaxed);
+    atomic_fetch_add_explicit(&probe->cached_pages, cached, memory_order_relaxed);
+}
+
+static bool cache_probe_stats(const cache_probe *probe, io_cache_stats *out) {
+    out->read_pages = atomic_load(&probe->read_pages);
+    out->cached_pages = atomic_load(&probe->cached_pages);
+    return probe->map != NULL;
+}
+
+// buffered backend
+typedef struct {
+    io_backend base;
+    int fd;
+    cache_probe probe;
+} buffered_backend;
+
+static ssize_t buffered_pread(io_backend *be, void *buf, size_t len, uint64_t offset) {
+    buffered_backend *bb = (buffered_backend *)be;
+    cache_probe_read(&bb->probe, len, offset);
+    return pread(bb->fd, buf, len, (off_t)offset);
+}
+
+static ssize_t buffered_pwrite(io_backend *be, const void *buf, size_t len, uint64_t offset, bool dsync) {
+    int fd = ((buffered_backend *)be)->fd;
+    if (dsync) {
+        struct iovec iov = { .iov_base = (void *)buf, .iov_len = len };
+        return pwritev2(fd, &iov, 1, (off_t)offset, RWF_DSYNC);
+    }
+    return pwrite(fd, buf, len, (off_t)offset);
+}
+
+static void buffered_advise(io_backend *be, io_pattern pattern) {
+    int advice = pattern == IO_PATTERN_SEQUENTIAL ? POSIX_FADV_SEQUENTIAL
+               : pattern == IO_PATTERN_RANDOM ? POSIX_FADV_RANDOM : POSIX_FADV_NORMAL;
+    posix_fadvise(((buffered_backend *)be)->fd, 0, 0, advice);
+}
+
+static bool buffered_cache_stats(const io_backend *be, io_cache_stats *out) {
+    return cache_probe_stats(&((const buffered_backend *)be)->probe, out);
+}
+
+static int buffered_flush(io_backend *be) {
+    return fdatasync(((buffered_backend *)be)->fd);
+}
+
+static void buffered_destroy(io_backend *be) {
+    buffered_backend *bb = (buffered_backend *)be;
+    if (bb->probe.map != NULL) {
+        munmap(bb->probe.map, bb->probe.size);
+    }
+    close(bb->fd);
+    free(bb);
+}
+
+io_backend *io_backend_buffered(const char *path, uint64_t size) {
+    buffered_backend *bb = calloc(1, sizeof(buffered_backend));
+    if (bb == NULL) {
+        return NULL;
+    }
+    bb->fd = open(path, O_RDWR);
+    if (bb->fd == -1) {
+        int saved = errno;
+        free(bb);
+        errno = saved;
+        return NULL;
+    }
+    // mincore 전용 매핑 (실패하면 적중률만 보고하지 않음)
+    void *map = mmap(NULL, size, PROT_READ, MAP_SHARED, bb->fd, 0);
+    bb->probe.map = map == MAP_FAILED ? NULL : map;
+    bb->probe.size = size;
+
+    bb->base.name = "buffered";
+    bb->base.pread = buffered_pread;
+    bb->base.pwrite = buffered_pwrite;
+    bb->base.advise = buffered_advise;
+    bb->base.cache_stats = buffered_cache_stats;
+    bb->base.flush = buffered_flush;
+    bb->base.destroy = buffered_destroy;
+    return &bb->base;
+}
+
+// mmap backend
+typedef struct {
+    io_backend base;
+    int fd;
+    cache_probe probe;               // probe.map이 곧 I/O 매핑
+} mmap_backend;
+
+static ssize_t mmap_pread(io_backend *be, void *buf, size_t len, uint64_t offset) {
+    mmap_backend *mb = (mmap_backend *)be;
+    if (offset + len > mb->probe.size) {
+        errno = EINVAL;
+        return -1;
+    }
+    cache_probe_read(&mb->probe, len, offset);
+    memcpy(buf, mb->probe.map + offset, len);
+    return (ssize_t)len;
+}
+
+static ssize_t mmap_pwrite(io_backend *be, const void *buf, size_t len, uint64_t offset, bool dsync) {
+    mmap_backend *mb = (mmap_backend *)be;
+    if (offset + len > mb->probe.size) {
+        errno = EINVAL;
+        return -1;
+    }
+    memcpy(mb->probe.map + offset, buf, len);
+    if (dsync) {
+        // msync는 page 정렬 주소가 필요
+        uint64_t start = offset & ~(uint64_t)(PAGE_BYTES - 1);
+        if (msync(mb->probe.map + start, offset + len - start, MS_SYNC) != 0) {
+            return -1;
+        }
+    }
+    return (ssize_t)len;
+}
+
+static void mmap_advise(io_backend *be, io_pattern pattern) {
+    mmap_backend *mb = (mmap_backend *)be;
+    int advice = pattern == IO_PATTERN_SEQUENTIAL ? MADV_SEQUENTIAL
+               : pattern == IO_PATTERN_RANDOM ? MADV_RANDOM : MADV_NORMAL;
+    madvise(mb->probe.map, mb->probe.size, advice);
+}
+
+static bool mmap_cache_stats(const io_backend *be, io_cache_stats *out) {
+    return cache_probe_stats(&((const mmap_backend *)be)->probe, out);
+}
+
+// 매핑의 dirty page를 파일로 기록 (fd의 fdatasync는 매핑을 거치지 않음)
+static int mmap_flush(io_backend *be) {
+    mmap_backend *mb = (mmap_backend *)be;
+    return msync(mb->probe.map, mb->probe.size, MS_SYNC);
+}
+
+static void mmap_destroy(io_backend *be) {
+    mmap_backend *mb = (mmap_backend *)be;
+    munmap(mb->probe.map, mb->probe.size);
+    close(mb->fd);
+    free(mb);
+}
+
+io_backend *io_backend_mmap(const char *path, uint64_t size) {
+    mmap_backend *mb = calloc(1, sizeof(mmap_backend));
+    if (mb == NULL) {
+        return NULL;
+    }
+    mb->fd = open(path, O_RDWR);
+    if (mb->fd == -1) {
+        int saved = errno;
+        free(mb);
+        errno = saved;
+        return NULL;
+    }
+    void *map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, mb->fd, 0);
+    if (map == MAP_FAILED) {
+        int saved = errno;
+        close(mb->fd);
+        free(mb);
+        errno = saved;
+        return NULL;
+    }
+    mb->probe.map = map;
+    mb->probe.size = size;
+
+    mb->base.name = "mmap";
+    mb->base.pread = mmap_pread;
+    mb->base.pwrite = mmap_pwrite;
+    mb->base.advise = mmap_advise;
+    mb->base.cache_stats = mmap_cache_stats;
+    mb->base.flush = mmap_flush;
+    mb->base.destroy = mmap_destroy;
+    return &mb->base;
+}
+
+io_backend *io_backend_create(const char *engine, int direct_fd, const char *path, uint64_t size) {
+    if (strcmp(engine, "direct") == 0) {
+        return io_backend_direct(direct_fd);
+    } else if (strcmp(engine, "buffered") == 0) {
+        return io_backend_buffered(path, size);
+    } else if (strcmp(engine, "mmap") == 0) {
+        return io_backend_mmap(path, size);
+    }
+    errno = EINVAL;
+    return NULL;
+}
+
+// fault backend
+typedef struct {
+    io_backend base;
+    io_backend *inner;
+    fault_backend_config cfg;
+    atomic_uint_fast64_t eio;
+    atomic_uint_fast64_t short_io;
+    atomic_uint_fast64_t delayed;
+    atomic_uint_fast64_t ops;        // 이 backend가 받은 I/O 순번
+} fault_backend;
+
+// 전역/thread 상태 없이 (seed, I/O 순번, offset, 방향, 판정 종류)에서 [0, 1) 값 유도 (splitmix64)
+// backend마다 독립이고, 같은 seed와 같은 I/O 순서면 같은 fault가 재현됨
+static double fault_random(const fault_backend *fb, uint64_t op, uint64_t offset, bool is_write, uint64_t draw) {
+    uint64_t z = fb->cfg.seed ^ (op * 0x9E3779B97F4A7C15ULL) ^ (offset * 0xD1B54A32D192ED03ULL) ^
+                 ((uint64_t)is_write << 62) ^ (draw << 56);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+    return (double)(z >> 11) * (1.0 / 9007199254740992.0);
+}
+
+typedef enum { FAULT_NONE, FAULT_EIO, FAULT_SHORT } fault_action;
+
+// I/O 하나에 적용할 fault 결정 (latency spike는 다른 fault와 중복 가능)
+static fault_action fault_decide(fault_backend *fb, bool is_write, size_t len, uint64_t offset) {
+    const fault_backend_config *cfg = &fb->cfg;
+    uint64_t first = offset / SECTOR_BYTES;
+    uint64_t last = (offset + len) / SECTOR_BYTES;
+    if ((is_write ? !cfg->writes : !cfg->reads) || last <= cfg->lba_start ||
+        (cfg->lba_end != 0 && first >= cfg->lba_end)) {
+        return FAULT_NONE;
+    }
+
+    uint64_t op = atomic_fetch_add(&fb->ops, 1);
+    if (cfg->delay_prob > 0.0 && fault_random(fb, op, offset, is_write, 0) < cfg->delay_prob) {
+        struct timespec ts = {
+            .tv_sec = (time_t)(cfg->delay_us / 1000000),
+            .tv_nsec = (long)(cfg->delay_us % 1000000) * 1000L
+        };
+        nanosleep(&ts, NULL);
+        atomic_fetch_add(&fb->delayed, 1);
+    }
+    if (cfg->eio_prob > 0.0 && fault_random(fb, op, offset, is_write, 1) < cfg->eio_prob) {
+        atomic_fetch_add(&fb->eio, 1);
+        return FAULT_EIO;
+    }
+    if (len > SECTOR_BYTES && cfg->short_prob > 0.0 && fault_random(fb, op, offset, is_write, 2) < cfg->short_prob) {
+        atomic_fetch_add(&fb->short_io, 1);
+        return FAULT_SHORT;
+    }
+    return FAULT_NONE;
+}
+
+// short transfer 길이: 앞쪽 절반 (sector 정렬)
+static size_t short_length(size_t len) {
+    size_t half = (len / 2) & ~(size_t)(SECTOR_BYTES - 1);
+    return half ? half : SECTOR_BYTES;
+}
+
+static ssize_t fault_pread(io_backend *be, void *buf, size_t len, uint64_t offset) {
+    fault_backend *fb = (fault_backend *)be;
+    switch (fault_decide(fb, false, len, offset)) {
+        case FAULT_EIO:
+            errno = EIO;
+            return -1;
+        case FAULT_SHORT:
+            return fb->inner->pread(fb->inner, buf, short_length(len), offset);
+        default:
+            return fb->inner->pread(fb->inner, buf, len, offset);
+    }
+}
+
+static ssize_t fault_pwrite(io_backend *be, const void *buf, size_t len, uint64_t offset, bool dsync) {
+    fault_backend *fb = (fault_backend *)be;
+    switch (fault_decide(fb, true, len, offset)) {
+        case FAULT_EIO:
+            errno = EIO;
+            return -1;
+        case FAULT_SHORT:
+            return fb->inner->pwrite(fb->inner, buf, short_length(len), offset, dsync);
+        default:
+            return fb->inner->pwrite(fb->inner, buf, len, offset, dsync);
+    }
+}
+
+static void fault_advise(io_backend *be, io_pattern pattern) {
+    io_backend_advise(((fault_backend *)be)->inner, pattern);
+}
+
+static bool fault_cache_stats(const io_backend *be, io_cache_stats *out) {
+    return io_backend_cache_stats(((const fault_backend *)be)->inner, out);
+}
+
+static int fault_flush(io_backend *be) {
+    return io_backend_flush(((fault_backend *)be)->inner);
+}
+
+static void fault_destroy(io_backend *be) {
+    fault_backend *fb = (fault_backend *)be;
+    io_backend_destroy(fb->inner);
+    free(fb);
+}
+
+io_backend *io_backend_fault(io_backend *inner, const fault_backend_config *cfg) {
+    fault_backend *fb = calloc(1, sizeof(fault_backend));
+    if (fb == NULL) {
+        return NULL;
+    }
+    fb->base.name = "fault";
+    fb->base.pread = fault_pread;
+    fb->base.pwrite = fault_pwrite;
+    fb->base.advise = fault_advise;
+    fb->base.cache_stats = fault_cache_stats;
+    fb->base.flush = fault_flush;
+    fb->base.destroy = fault_destroy;
+    fb->inner = inner;
+    fb->cfg = *cfg;
+    return &fb->base;
+}
+
+void io_backend_fault_stats(const io_backend *be, fault_backend_stats *out) {
+    fault_backend *fb = (fault_backend *)be;
+    out->eio = atomic_load(&fb->eio);
+    out->short_io = atomic_load(&fb->short_io);
+    out->delayed = atomic_load(&fb->delayed);
+}
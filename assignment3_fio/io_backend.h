@@ -0,0 +1,93 @@
+#ifndef IO_BACKEND_H
+#define IO_BACKEND_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <sys/types.h>
+
+// worker와 실제 target 사이의 I/O 계층 (실패는 NULL/-1 + errno로 반환, 출력하지 않음)
+// direct:   O_DIRECT device fd에 그대로 pread/pwrite
+// buffered: page cache를 거치는 pread/pwrite (posix_fadvise 힌트)
+// mmap:     target 전체를 MAP_SHARED로 매핑 후 memcpy (madvise 힌트)
+// fault:    다른 backend를 감싸 EIO, short transfer, latency spike를 확률적으로 주입
+
+typedef struct io_backend io_backend;
+
+// 접근 패턴 힌트
+typedef enum {
+    IO_PATTERN_NORMAL = 0,
+    IO_PATTERN_SEQUENTIAL,
+    IO_PATTERN_RANDOM,
+} io_pattern;
+
+// read 시 page cache 적중 (4KB page 단위, mincore로 read 직전에 측정)
+typedef struct {
+    uint64_t read_pages;
+    uint64_t cached_pages;
+} io_cache_stats;
+
+struct io_backend {
+    const char *name;
+    ssize_t (*pread)(io_backend *be, void *buf, size_t len, uint64_t offset);
+    ssize_t (*pwrite)(io_backend *be, const void *buf, size_t len, uint64_t offset, bool dsync);
+    void (*advise)(io_backend *be, io_pattern pattern);                 // NULL 가능
+    bool (*cache_stats)(const io_backend *be, io_cache_stats *out);     // NULL 가능
+    int (*flush)(io_backend *be);                                       // 쓴 데이터를 영구 저장, NULL 가능
+    void (*destroy)(io_backend *be);
+};
+
+io_backend *io_backend_direct(int fd);
+
+// page cache 경로 engine, path를 O_DIRECT 없이 따로 연다
+io_backend *io_backend_buffered(const char *path, uint64_t size);
+io_backend *io_backend_mmap(const char *path, uint64_t size);
+
+// engine 이름으로 생성 ("direct"는 direct_fd 사용), 알 수 없는 이름이면 NULL (EINVAL)
+io_backend *io_backend_create(const char *engine, int direct_fd, const char *path, uint64_t size);
+
+// fault 주입 설정 (확률은 I/O 단위, LBA 범위와 겹치는 I/O에만 적용)
+typedef struct {
+    double eio_prob;
+    double short_prob;
+    double delay_prob;
+    uint64_t delay_us;
+    uint64_t lba_start;        // 512B sector
+    uint64_t lba_end;          // 미포함, 0 = 끝까지
+    bool reads;
+    bool writes;
+    uint64_t seed;
+} fault_backend_config;
+
+typedef struct {
+    uint64_t eio;
+    uint64_t short_io;
+    uint64_t delayed;
+} fault_backend_stats;
+
+// inner는 fault backend가 소유 (destroy 시 함께 해제)
+io_backend *io_backend_fault(io_backend *inner, const fault_backend_config *cfg);
+void io_backend_fault_stats(const io_backend *be, fault_backend_stats *out);
+
+static inline void io_backend_advise(io_backend *be, io_pattern pattern) {
+    if (be->advise != NULL) {
+        be->advise(be, pattern);
+    }
+}
+
+static inline bool io_backend_cache_stats(const io_backend *be, io_cache_stats *out) {
+    return be->cache_stats != NULL && be->cache_stats(be, out);
+}
+
+// flush가 없는 backend는 내구성 경계가 없으므로 성공으로 취급
+static inline int io_backend_flush(io_backend *be) {
+    return be->flush != NULL ? be->flush(be) : 0;
+}
+
+static inline void io_backend_destroy(io_backend *be) {
+    if (be != NULL) {
+        be->destroy(be);
+    }
+}
+
+#endif
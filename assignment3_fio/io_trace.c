@@ -0,0 +1,144 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "io_trace.h"
+#include "tsc.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+
+typedef struct {
+    io_trace_event *ring;
+    uint64_t seq;              // 다음 event 번호
+    uint64_t written_upto;     // 이 번호 미만 event는 이미 파일에 기록됨
+    uint64_t dump_until;       // 이 번호 미만 event는 바로 기록 (outlier 뒤쪽 window)
+    uint64_t outliers;
+} __attribute__((aligned(64))) trace_thread;
+
+static FILE *trace_fp = NULL;
+static pthread_mutex_t trace_lock = PTHREAD_MUTEX_INITIALIZER;
+static trace_thread *threads = NULL;
+static int num_threads = 0;
+static uint64_t ring_mask = 0;
+static uint64_t threshold_ticks = 0;
+static uint32_t trace_window = 0;
+static uint64_t events_written = 0;
+
+bool io_trace_enabled(void) {
+    return trace_fp != NULL;
+}
+
+bool io_trace_open(const char *path, uint64_t threshold_ns, uint32_t window, int max_threads) {
+    trace_fp = fopen(path, "wb");
+    if (trace_fp == NULL) {
+        perror("fopen trace");
+        return false;
+    }
+
+    // ring은 window보다 크게 (2의 거듭제곱)
+    uint64_t ring_size = 16;
+    while (ring_size < (uint64_t)window + 1) {
+        ring_size <<= 1;
+    }
+    ring_mask = ring_size - 1;
+    trace_window = window;
+    threshold_ticks = tsc_from_ns(threshold_ns);
+
+    num_threads = max_threads;
+    threads = calloc((size_t)num_threads, sizeof(trace_thread));
+    if (threads == NULL) {
+        fclose(trace_fp);
+        trace_fp = NULL;
+        return false;
+    }
+    for (int t = 0; t < num_threads; t++) {
+        threads[t].ring = calloc(ring_size, sizeof(io_trace_event));
+        if (threads[t].ring == NULL) {
+            io_trace_close();
+            return false;
+        }
+    }
+
+    struct timespec real;
+    clock_gettime(CLOCK_REALTIME, &real);
+
+    io_trace_file_header header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, IO_TRACE_MAGIC, sizeof(header.magic));
+    header.version = IO_TRACE_VERSION;
+    header.event_size = sizeof(io_trace_event);
+    header.tsc_hz = tsc_hz();
+    header.start_tsc = tsc_now();
+    header.start_realtime_ns = (uint64_t)real.tv_sec * 1000000000ULL + (uint64_t)real.tv_nsec;
+    header.threshold_ns = threshold_ns;
+    header.window = window;
+    header.sector_size = 512;
+    fwrite(&header, sizeof(header), 1, trace_fp);
+    return true;
+}
+
+// [from, to) 범위 event를 파일에 기록
+static void flush_events(trace_thread *st, uint64_t from, uint64_t to) {
+    if (from >= to) {
+        return;
+    }
+    pthread_mutex_lock(&trace_lock);
+    for (uint64_t s = from; s < to; s++) {
+        fwrite(&st->ring[s & ring_mask], sizeof(io_trace_event), 1, trace_fp);
+    }
+    events_written += to - from;
+    pthread_mutex_unlock(&trace_lock);
+    st->written_upto = to;
+}
+
+void io_trace_record(int thread_idx, io_trace_op op, uint64_t lba, uint32_t length,
+                     uint64_t submit_tsc, uint64_t complete_tsc, bool failed) {
+    if (trace_fp == NULL || thread_idx < 0 || thread_idx >= num_threads) {
+        return;
+    }
+    trace_thread *st = &threads[thread_idx];
+
+    bool outlier = complete_tsc - submit_tsc >= threshold_ticks;
+    io_trace_event *ev = &st->ring[st->seq & ring_mask];
+    ev->lba = lba;
+    ev->submit_tsc = submit_tsc;
+    ev->complete_tsc = complete_tsc;
+    ev->length = length;
+    ev->thread = (uint16_t)thread_idx;
+    ev->op = (uint8_t)op;
+    ev->flags = (uint8_t)((outlier ? IO_TRACE_FLAG_OUTLIER : 0) | (failed ? IO_TRACE_FLAG_FAILED : 0));
+    st->seq++;
+
+    if (outlier) {
+        // 앞쪽 window (아직 기록 안 된 것만) + outlier 자신
+        uint64_t from = st->seq > (uint64_t)trace_window + 1 ? st->seq - trace_window - 1 : 0;
+        if (from < st->written_upto) {
+            from = st->written_upto;
+        }
+        flush_events(st, from, st->seq);
+        st->dump_until = st->seq + trace_window;
+        st->outliers++;
+    } else if (st->seq <= st->dump_until) {
+        // outlier 뒤쪽 window
+        flush_events(st, st->seq - 1, st->seq);
+    }
+}
+
+void io_trace_close(void) {
+    if (trace_fp == NULL) {
+        return;
+    }
+    uint64_t outliers = 0;
+    for (int t = 0; t < num_threads; t++) {
+        outliers += threads[t].outliers;
+        free(threads[t].ring);
+    }
+    free(threads);
+    threads = NULL;
+
+    fclose(trace_fp);
+    trace_fp = NULL;
+    printf("I/O Trace: %lu outliers, %lu events recorded\n", outliers, events_written);
+}
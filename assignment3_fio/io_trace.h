@@ -0,0 +1,54 @@
+#ifndef IO_TRACE_H
+#define IO_TRACE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// outlier I/O tracer
+// thread별 ring에 최근 I/O event를 보관하다가 threshold를 넘는 I/O가 나오면
+// 앞쪽 window + outlier + 뒤쪽 window event를 binary trace 파일에 기록한다.
+// trace2json 으로 Chrome/Perfetto JSON 변환
+
+#define IO_TRACE_MAGIC   "FIOTRACE"
+#define IO_TRACE_VERSION 1u
+
+typedef enum {
+    IO_OP_WRITE = 1,
+    IO_OP_READ  = 2,
+} io_trace_op;
+
+#define IO_TRACE_FLAG_OUTLIER 0x1u
+#define IO_TRACE_FLAG_FAILED  0x2u
+
+// 파일 header (little endian, 고정 크기)
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t event_size;
+    uint64_t tsc_hz;           // TSC -> 시간 변환
+    uint64_t start_tsc;        // trace 시작 시점 TSC (timeline 원점)
+    uint64_t start_realtime_ns;
+    uint64_t threshold_ns;
+    uint32_t window;
+    uint32_t sector_size;
+} io_trace_file_header;
+
+typedef struct {
+    uint64_t lba;
+    uint64_t submit_tsc;
+    uint64_t complete_tsc;
+    uint32_t length;           // byte
+    uint16_t thread;
+    uint8_t op;
+    uint8_t flags;
+} io_trace_event;
+
+bool io_trace_open(const char *path, uint64_t threshold_ns, uint32_t window, int max_threads);
+void io_trace_close(void);
+bool io_trace_enabled(void);
+
+// worker thread에서 I/O 완료 시 호출
+void io_trace_record(int thread_idx, io_trace_op op, uint64_t lba, uint32_t length,
+                     uint64_t submit_tsc, uint64_t complete_tsc, bool failed);
+
+#endif
@@ -0,0 +1,186 @@
+#include "jobfile.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+// 앞뒤 공백 제거
+static char *trim(char *str) {
+    while (isspace((unsigned char)*str)) {
+        str++;
+    }
+    char *end = str + strlen(str);
+    while (end > str && isspace((unsigned char)end[-1])) {
+        end--;
+    }
+    *end = '\0';
+    return str;
+}
+
+// "128K", "10G" 등 크기 파싱
+int parse_size(const char *str, uint64_t *out) {
+    char *end = NULL;
+    unsigned long long value = strtoull(str, &end, 0);
+    if (end == str) {
+        return -1;
+    }
+    switch (toupper((unsigned char)*end)) {
+        case 'K': value <<= 10; end++; break;
+        case 'M': value <<= 20; end++; break;
+        case 'G': value <<= 30; end++; break;
+        case 'T': value <<= 40; end++; break;
+        default: break;
+    }
+    if (*end != '\0') {
+        return -1;
+    }
+    *out = (uint64_t)value;
+    return 0;
+}
+
+static int apply_key(job_config *job, const char *key, const char *value) {
+    if (strcmp(key, "rw") == 0) {
+        if (strcmp(value, "write") == 0) {
+            job->is_write = true;
+        } else if (strcmp(value, "read") == 0) {
+            job->is_write = false;
+        } else {
+            return -1;
+        }
+    } else if (strcmp(key, "pattern") == 0) {
+        if (strcmp(value, "seq") == 0) {
+            job->random = false;
+        } else if (strcmp(value, "random") == 0) {
+            job->random = true;
+        } else {
+            return -1;
+        }
+    } else if (strcmp(key, "offset") == 0) {
+        return parse_size(value, &job->offset);
+    } else if (strcmp(key, "size") == 0) {
+        return parse_size(value, &job->size);
+    } else if (strcmp(key, "bs") == 0) {
+        return parse_size(value, &job->block_size);
+    } else if (strcmp(key, "ios") == 0) {
+        return parse_size(value, &job->ios);
+    } else if (strcmp(key, "threads") == 0) {
+        uint64_t threads;
+        if (parse_size(value, &threads) != 0 || threads == 0 || threads > 256) {
+            return -1;
+        }
+        job->threads = (int)threads;
+    } else {
+        return -1;
+    }
+    return 0;
+}
+
+static int validate_job(const job_config *job) {
+    // O_DIRECT 정렬 조건
+    if (job->block_size == 0 || job->block_size % 4096 != 0 || job->block_size > JOB_MAX_BLOCK_SIZE) {
+        printf("Error: Job '%s': bs must be a multiple of 4096 up to %llu\n", job->name, JOB_MAX_BLOCK_SIZE);
+        return -1;
+    }
+    if (job->offset % job->block_size != 0 || job->size % job->block_size != 0) {
+        printf("Error: Job '%s': offset and size must be multiples of bs\n", job->name);
+        return -1;
+    }
+    return 0;
+}
+
+int parse_job_file(const char *filename, job_config *jobs, int max_jobs, uint64_t default_block_size) {
+    FILE *fp = fopen(filename, "r");
+    if (fp == NULL) {
+        perror("Failed to open job file");
+        return -1;
+    }
+
+    job_config defaults = {
+        .name = "global",
+        .is_write = false,
+        .random = false,
+        .offset = 0,
+        .size = 0,
+        .block_size = default_block_size,
+        .ios = 0,
+        .threads = 1,
+    };
+
+    char line[256];
+    int line_no = 0;
+    int count = 0;
+    job_config *current = &defaults;
+
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        line_no++;
+        char *comment = strpbrk(line, "#;");
+        if (comment != NULL) {
+            *comment = '\0';
+        }
+        char *text = trim(line);
+        if (text[0] == '\0') {
+            continue;
+        }
+
+        // [section]
+        if (text[0] == '[') {
+            char *close = strchr(text, ']');
+            if (close == NULL) {
+                printf("Error: %s:%d: Unterminated section\n", filename, line_no);
+                goto fail;
+            }
+            *close = '\0';
+            char *name = trim(text + 1);
+            if (strcmp(name, "global") == 0) {
+                if (count > 0) {
+                    printf("Error: %s:%d: [global] must come before jobs\n", filename, line_no);
+                    goto fail;
+                }
+                current = &defaults;
+                continue;
+            }
+            if (count > 0 && validate_job(&jobs[count - 1]) != 0) {
+                goto fail;
+            }
+            if (count == max_jobs) {
+                printf("Error: %s:%d: Too many jobs (max %d)\n", filename, line_no, max_jobs);
+                goto fail;
+            }
+            jobs[count] = defaults;
+            snprintf(jobs[count].name, sizeof(jobs[count].name), "%s", name);
+            current = &jobs[count];
+            count++;
+            continue;
+        }
+
+        // key=value
+        char *eq = strchr(text, '=');
+        if (eq == NULL) {
+            printf("Error: %s:%d: Expected key=value\n", filename, line_no);
+            goto fail;
+        }
+        *eq = '\0';
+        char *key = trim(text);
+        char *value = trim(eq + 1);
+        if (apply_key(current, key, value) != 0) {
+            printf("Error: %s:%d: Invalid '%s=%s'\n", filename, line_no, key, value);
+            goto fail;
+        }
+    }
+
+    fclose(fp);
+
+    if (count == 0) {
+        printf("Error: %s: No jobs defined\n", filename);
+        return -1;
+    }
+    if (validate_job(&jobs[count - 1]) != 0) {
+        return -1;
+    }
+    return count;
+
+fail:
+    fclose(fp);
+    return -1;
+}
@@ -0,0 +1,42 @@
+#ifndef JOBFILE_H
+#define JOBFILE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// INI 형식 job file
+//
+//   [global]            ; 이후 job들의 기본값
+//   bs=128K
+//
+//   [seq-writer]
+//   rw=write            ; write | read
+//   pattern=seq         ; seq | random
+//   offset=0            ; 범위 시작 (byte, K/M/G/T 접미사)
+//   size=10G            ; 범위 크기 (0 또는 생략 시 디바이스 끝까지)
+//   threads=2
+//   ios=100000          ; random 패턴의 I/O 개수 (기본: 범위 내 블록 수)
+
+#define JOB_MAX 32
+#define JOB_NAME_LEN 64
+#define JOB_MAX_BLOCK_SIZE (8ULL * 1024 * 1024)
+
+typedef struct {
+    char name[JOB_NAME_LEN];
+    bool is_write;
+    bool random;
+    uint64_t offset;       // byte
+    uint64_t size;         // byte, 0 = 디바이스 끝까지
+    uint64_t block_size;   // byte
+    uint64_t ios;          // random 전용, 0 = 범위 내 블록 수
+    int threads;
+} job_config;
+
+// "128K", "10G" 등 크기 파싱 (성공 시 0)
+int parse_size(const char *str, uint64_t *out);
+
+// job file 파싱, 성공 시 job 개수 (실패 시 -1)
+int parse_job_file(const char *filename, job_config *jobs, int max_jobs, uint64_t default_block_size);
+
+#endif
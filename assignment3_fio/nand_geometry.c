@@ -0,0 +1,150 @@
+#include "nand_geometry.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+
+static bool keys_equal(const char *a, const char *b) {
+    while (*a != '\0' && tolower((unsigned char)*a) == tolower((unsigned char)*b)) {
+        a++;
+        b++;
+    }
+    return *a == '\0' && *b == '\0';
+}
+
+// assignment2 parse_meta_line과 같은 규칙: 앞뒤 공백 무시, key 대소문자 무시, 값 뒤에 다른 문자가 있으면 무효
+// 인식한 항목의 bit 반환, 해당 없으면 0, 값이 잘못되면 -1
+static int parse_geometry_line(char *line, nand_geometry *geo) {
+    static const char *KEYS[] = { "bank", "block", "page", "page_size", "PROVISION_RATE" };
+    uint64_t *fields[] = { &geo->bank, &geo->block, &geo->page, &geo->page_size, &geo->provision_rate };
+
+    while (isspace((unsigned char)*line)) {
+        line++;
+    }
+    char *eq = strchr(line, '=');
+    if (line[0] == '#' || line[0] == ';' || eq == NULL) {
+        return 0;
+    }
+    char *key_end = eq;
+    while (key_end > line && isspace((unsigned char)key_end[-1])) {
+        key_end--;
+    }
+    *key_end = '\0';
+
+    for (int k = 0; k < 5; k++) {
+        if (!keys_equal(line, KEYS[k])) {
+            continue;
+        }
+        const char *value = eq + 1;
+        while (isspace((unsigned char)*value)) {
+            value++;
+        }
+        char *end = NULL;
+        errno = 0;
+        unsigned long long parsed = strtoull(value, &end, 10);
+        if (end == value || errno != 0 || value[0] == '-') {
+            return -1;
+        }
+        while (isspace((unsigned char)*end)) {
+            end++;
+        }
+        if (*end != '\0') {
+            return -1;
+        }
+        *fields[k] = parsed;
+        return 1 << k;
+    }
+    return 0;
+}
+
+nand_geometry_status nand_geometry_load(const char *path, nand_geometry *geo) {
+    FILE *fp = fopen(path, "r");
+    if (fp == NULL) {
+        return NAND_GEOMETRY_OPEN;
+    }
+
+    unsigned found = 0;
+    memset(geo, 0, sizeof(*geo));
+
+    char line[256];
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        int field = parse_geometry_line(line, geo);
+        if (field > 0) {
+            found |= (unsigned)field;
+        }
+    }
+    fclose(fp);
+
+    if (found != 0x1F) {
+        return NAND_GEOMETRY_MISSING;
+    }
+    if (geo->bank == 0 || geo->block == 0 || geo->page == 0 || geo->page_size == 0 ||
+        geo->provision_rate == 0 || geo->provision_rate > 100) {
+        return NAND_GEOMETRY_RANGE;
+    }
+    if (nand_geometry_capacity(geo) == 0) {
+        return NAND_GEOMETRY_OVERFLOW;
+    }
+    return NAND_GEOMETRY_OK;
+}
+
+const char *nand_geometry_status_string(nand_geometry_status status) {
+    switch (status) {
+        case NAND_GEOMETRY_OK:
+            return "ok";
+        case NAND_GEOMETRY_OPEN:
+            return "cannot open file";
+        case NAND_GEOMETRY_MISSING:
+            return "needs valid bank, block, page, page_size and PROVISION_RATE";
+        case NAND_GEOMETRY_RANGE:
+            return "has a zero field or PROVISION_RATE outside 1-100";
+        case NAND_GEOMETRY_OVERFLOW:
+            return "overflows 64-bit capacity";
+    }
+    return "unknown error";
+}
+
+uint64_t nand_geometry_pages(const nand_geometry *geo) {
+    uint64_t blocks, pages;
+    if (__builtin_mul_overflow(geo->bank, geo->block, &blocks) ||
+        __builtin_mul_overflow(blocks, geo->page, &pages)) {
+        return 0;
+    }
+    return pages;
+}
+
+uint64_t nand_geometry_capacity(const nand_geometry *geo) {
+    uint64_t bytes;
+    if (__builtin_mul_overflow(nand_geometry_pages(geo), geo->page_size, &bytes)) {
+        return 0;
+    }
+    return bytes;
+}
+
+uint64_t nand_geometry_logical_pages(const nand_geometry *geo) {
+    uint64_t pages = nand_geometry_pages(geo);
+    uint64_t op_rate = geo->provision_rate < 100 ? 100 - geo->provision_rate : 0;
+    // overflow 없도록 나누어 계산
+    uint64_t op = pages / 100 * op_rate + pages % 100 * op_rate / 100;
+    return pages - op;
+}
+
+uint64_t nand_geometry_stripe(const nand_geometry *geo) {
+    uint64_t bytes;
+    if (__builtin_mul_overflow(geo->page_size, geo->bank, &bytes)) {
+        return 0;
+    }
+    return bytes;
+}
+
+uint64_t nand_geometry_default_stripes(const nand_geometry *geo, uint64_t target) {
+    uint64_t stripe = nand_geometry_stripe(geo);
+    if (stripe == 0 || stripe > target) {
+        return 1;
+    }
+    uint64_t stripes = target / stripe;
+    // 나머지가 stripe 절반 이상이면 하나 더
+    return target % stripe >= stripe - stripe / 2 ? stripes + 1 : stripes;
+}
@@ -0,0 +1,53 @@
+#ifndef NAND_GEOMETRY_H
+#define NAND_GEOMETRY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// assignment2 meta_control의 meta.ini 형식 (bank x block x page x page_size, PROVISION_RATE)
+// key는 대소문자 무시, '=' 앞뒤 공백 허용, '#' 또는 ';'로 시작하는 줄은 주석
+//   bank=4
+//   block=1024
+//   page=256
+//   page_size=4096
+//   ; 사용 가능 비율 (%), 나머지는 OP 영역
+//   PROVISION_RATE=93
+
+typedef struct {
+    uint64_t bank;
+    uint64_t block;              // bank당 block 수
+    uint64_t page;               // block당 page 수
+    uint64_t page_size;          // byte
+    uint64_t provision_rate;     // 1-100
+} nand_geometry;
+
+typedef enum {
+    NAND_GEOMETRY_OK = 0,
+    NAND_GEOMETRY_OPEN,          // 파일을 열 수 없음 (errno 유지)
+    NAND_GEOMETRY_MISSING,       // 다섯 항목 중 빠졌거나 값이 잘못된 항목이 있음
+    NAND_GEOMETRY_RANGE,         // 0인 항목 또는 PROVISION_RATE가 1-100 밖
+    NAND_GEOMETRY_OVERFLOW,      // 전체 용량이 64bit를 넘음
+} nand_geometry_status;
+
+// 다섯 항목이 모두 있어야 NAND_GEOMETRY_OK, 출력은 호출자가 담당
+nand_geometry_status nand_geometry_load(const char *path, nand_geometry *geo);
+const char *nand_geometry_status_string(nand_geometry_status status);
+
+// 전체 page 수 / byte 수, 곱셈 overflow 시 0
+uint64_t nand_geometry_pages(const nand_geometry *geo);
+uint64_t nand_geometry_capacity(const nand_geometry *geo);
+
+// 노출되는 logical page 수: 전체 - floor(OP 비율 x 전체)
+// assignment2의 calc_practical_usage_sector / l2p_logical_pages와 같은 반올림 규칙
+uint64_t nand_geometry_logical_pages(const nand_geometry *geo);
+
+// stripe = 모든 bank의 page 하나씩 (page_size x bank), overflow 시 0
+uint64_t nand_geometry_stripe(const nand_geometry *geo);
+// target byte에 가장 가까운 stripe 수 (최소 1)
+uint64_t nand_geometry_default_stripes(const nand_geometry *geo, uint64_t target);
+// logical page가 고정되는 bank (연속 page가 모든 bank에 striping)
+static inline uint64_t nand_geometry_bank_of(const nand_geometry *geo, uint64_t lpn) {
+    return lpn % geo->bank;
+}
+
+#endif
@@ -0,0 +1,252 @@
+#include "payload.h"
+
+#include <string.h>
+#include <immintrin.h>
+
+// 32bit word 단위 counter 기반 PRNG
+// word[j] = mix32(j * GOLDEN + key_lo) ^ key_hi
+// 각 word가 독립적으로 계산되므로 lane 단위로 그대로 vector화 된다.
+#define PAYLOAD_GOLDEN 0x9E3779B9u
+#define PAYLOAD_MUL1   0x7FEB352Du
+#define PAYLOAD_MUL2   0x846CA68Bu
+#define PAYLOAD_DEDUPE_SALT 0xD1B54A32D192ED03ULL
+
+static inline uint64_t splitmix64(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+static inline uint32_t mix32(uint32_t x) {
+    x ^= x >> 16;
+    x *= PAYLOAD_MUL1;
+    x ^= x >> 15;
+    x *= PAYLOAD_MUL2;
+    x ^= x >> 16;
+    return x;
+}
+
+static inline uint32_t payload_word(uint64_t key, uint32_t j) {
+    return mix32(j * PAYLOAD_GOLDEN + (uint32_t)key) ^ (uint32_t)(key >> 32);
+}
+
+uint64_t payload_key(uint64_t seed, uint64_t lba, uint64_t generation) {
+    uint64_t k = splitmix64(seed);
+    k = splitmix64(k ^ lba);
+    return splitmix64(k ^ generation);
+}
+
+uint32_t payload_key_tag(uint64_t key) {
+    return (uint32_t)(key ^ (key >> 32));
+}
+
+uint64_t payload_dedupe_key(uint64_t seed, int slot, uint64_t sector_in_unit, uint64_t generation) {
+    uint64_t k = splitmix64(seed ^ PAYLOAD_DEDUPE_SALT);
+    k = splitmix64(k ^ (uint64_t)slot);
+    k = splitmix64(k ^ sector_in_unit);
+    return splitmix64(k ^ generation);
+}
+
+int payload_dedupe_slot(uint64_t seed, uint64_t unit_lba, double dedupe_ratio) {
+    if (dedupe_ratio <= 0.0) {
+        return -1;
+    }
+    uint64_t h = splitmix64(splitmix64(seed ^ PAYLOAD_DEDUPE_SALT) ^ unit_lba);
+    // 상위 53bit -> [0, 1) 균등 분포
+    double u = (double)(h >> 11) * (1.0 / 9007199254740992.0);
+    if (u >= dedupe_ratio) {
+        return -1;
+    }
+    return (int)(h % PAYLOAD_DEDUPE_POOL);
+}
+
+size_t payload_random_len(size_t sector_size, size_t header_size, double compress_ratio) {
+    size_t payload_size = sector_size - header_size;
+    if (compress_ratio <= 1.0) {
+        return payload_size;
+    }
+    double target = (double)sector_size / compress_ratio - (double)header_size;
+    if (target <= 0.0) {
+        return 0;
+    }
+    size_t random_len = (size_t)(target + 0.5);
+    return random_len > payload_size ? payload_size : random_len;
+}
+
+unsigned char payload_expected_byte(uint64_t key, size_t offset, size_t random_len) {
+    if (offset >= random_len) {
+        return 0;
+    }
+    uint32_t w = payload_word(key, (uint32_t)(offset / 4));
+    return (unsigned char)(w >> (8 * (offset % 4)));
+}
+
+#if defined(__AVX512F__)
+
+static inline __m512i mix32_x16(__m512i x) {
+    x = _mm512_xor_si512(x, _mm512_srli_epi32(x, 16));
+    x = _mm512_mullo_epi32(x, _mm512_set1_epi32((int)PAYLOAD_MUL1));
+    x = _mm512_xor_si512(x, _mm512_srli_epi32(x, 15));
+    x = _mm512_mullo_epi32(x, _mm512_set1_epi32((int)PAYLOAD_MUL2));
+    return _mm512_xor_si512(x, _mm512_srli_epi32(x, 16));
+}
+
+// word j..j+15 생성
+static inline __m512i payload_x16(__m512i idx, __m512i klo, __m512i khi) {
+    __m512i x = _mm512_add_epi32(_mm512_mullo_epi32(idx, _mm512_set1_epi32((int)PAYLOAD_GOLDEN)), klo);
+    return _mm512_xor_si512(mix32_x16(x), khi);
+}
+
+#elif defined(__AVX2__)
+
+static inline __m256i mix32_x8(__m256i x) {
+    x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 16));
+    x = _mm256_mullo_epi32(x, _mm256_set1_epi32((int)PAYLOAD_MUL1));
+    x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 15));
+    x = _mm256_mullo_epi32(x, _mm256_set1_epi32((int)PAYLOAD_MUL2));
+    return _mm256_xor_si256(x, _mm256_srli_epi32(x, 16));
+}
+
+// word j..j+7 생성
+static inline __m256i payload_x8(__m256i idx, __m256i klo, __m256i khi) {
+    __m256i x = _mm256_add_epi32(_mm256_mullo_epi32(idx, _mm256_set1_epi32((int)PAYLOAD_GOLDEN)), klo);
+    return _mm256_xor_si256(mix32_x8(x), khi);
+}
+
+#endif
+
+void payload_fill(uint64_t key, unsigned char *buf, size_t length, size_t random_len) {
+    if (random_len > length) {
+        random_len = length;
+    }
+    size_t words = random_len / 4;
+    size_t j = 0;
+
+#if defined(__AVX512F__)
+    __m512i klo = _mm512_set1_epi32((int)(uint32_t)key);
+    __m512i khi = _mm512_set1_epi32((int)(uint32_t)(key >> 32));
+    __m512i idx = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    __m512i step = _mm512_set1_epi32(16);
+    for (; j + 16 <= words; j += 16) {
+        _mm512_storeu_si512((void *)(buf + j * 4), payload_x16(idx, klo, khi));
+        idx = _mm512_add_epi32(idx, step);
+    }
+    if (j < words) {
+        __mmask16 m = (__mmask16)((1u << (words - j)) - 1);
+        _mm512_mask_storeu_epi32(buf + j * 4, m, payload_x16(idx, klo, khi));
+        j = words;
+    }
+#elif defined(__AVX2__)
+    __m256i klo = _mm256_set1_epi32((int)(uint32_t)key);
+    __m256i khi = _mm256_set1_epi32((int)(uint32_t)(key >> 32));
+    __m256i idx = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    __m256i step = _mm256_set1_epi32(8);
+    for (; j + 8 <= words; j += 8) {
+        _mm256_storeu_si256((__m256i *)(buf + j * 4), payload_x8(idx, klo, khi));
+        idx = _mm256_add_epi32(idx, step);
+    }
+#endif
+
+    for (; j < words; j++) {
+        uint32_t w = payload_word(key, (uint32_t)j);
+        memcpy(buf + j * 4, &w, 4);
+    }
+
+    // 4byte로 나누어 떨어지지 않는 꼬리
+    for (size_t i = words * 4; i < random_len; i++) {
+        buf[i] = payload_expected_byte(key, i, random_len);
+    }
+
+    // 압축 가능 영역
+    memset(buf + random_len, 0, length - random_len);
+}
+
+// word 단위로 불일치가 발견된 경우 첫 번째 다른 byte 위치 계산
+static size_t first_diff_in_word(uint64_t key, const unsigned char *buf, size_t word) {
+    for (size_t i = word * 4; i < word * 4 + 4; i++) {
+        if (buf[i] != payload_expected_byte(key, i, (size_t)-1)) {
+            return i;
+        }
+    }
+    return word * 4;
+}
+
+size_t payload_verify(uint64_t key, const unsigned char *buf, size_t length, size_t random_len) {
+    if (random_len > length) {
+        random_len = length;
+    }
+    size_t words = random_len / 4;
+    size_t j = 0;
+
+#if defined(__AVX512F__)
+    __m512i klo = _mm512_set1_epi32((int)(uint32_t)key);
+    __m512i khi = _mm512_set1_epi32((int)(uint32_t)(key >> 32));
+    __m512i idx = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    __m512i step = _mm512_set1_epi32(16);
+    for (; j + 16 <= words; j += 16) {
+        __m512i got = _mm512_loadu_si512((const void *)(buf + j * 4));
+        __mmask16 ne = _mm512_cmpneq_epi32_mask(got, payload_x16(idx, klo, khi));
+        if (ne) {
+            return first_diff_in_word(key, buf, j + (size_t)__builtin_ctz(ne));
+        }
+        idx = _mm512_add_epi32(idx, step);
+    }
+    if (j < words) {
+        __mmask16 m = (__mmask16)((1u << (words - j)) - 1);
+        __m512i got = _mm512_maskz_loadu_epi32(m, buf + j * 4);
+        __mmask16 ne = _mm512_mask_cmpneq_epi32_mask(m, got, payload_x16(idx, klo, khi));
+        if (ne) {
+            return first_diff_in_word(key, buf, j + (size_t)__builtin_ctz(ne));
+        }
+        j = words;
+    }
+#elif defined(__AVX2__)
+    __m256i klo = _mm256_set1_epi32((int)(uint32_t)key);
+    __m256i khi = _mm256_set1_epi32((int)(uint32_t)(key >> 32));
+    __m256i idx = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    __m256i step = _mm256_set1_epi32(8);
+    for (; j + 8 <= words; j += 8) {
+        __m256i got = _mm256_loadu_si256((const __m256i *)(buf + j * 4));
+        __m256i eq = _mm256_cmpeq_epi32(got, payload_x8(idx, klo, khi));
+        unsigned ne = ~(unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(eq)) & 0xFFu;
+        if (ne) {
+            return first_diff_in_word(key, buf, j + (size_t)__builtin_ctz(ne));
+        }
+        idx = _mm256_add_epi32(idx, step);
+    }
+#endif
+
+    for (; j < words; j++) {
+        uint32_t w;
+        memcpy(&w, buf + j * 4, 4);
+        if (w != payload_word(key, (uint32_t)j)) {
+            return first_diff_in_word(key, buf, j);
+        }
+    }
+
+    for (size_t i = words * 4; i < random_len; i++) {
+        if (buf[i] != payload_expected_byte(key, i, random_len)) {
+            return i;
+        }
+    }
+
+    // 압축 가능 영역은 0이어야 함
+    for (size_t i = random_len; i < length; i++) {
+        if (buf[i] != 0) {
+            return i;
+        }
+    }
+
+    return PAYLOAD_MATCH;
+}
+
+const char *payload_simd_name(void) {
+#if defined(__AVX512F__)
+    return "avx512";
+#elif defined(__AVX2__)
+    return "avx2";
+#else
+    return "scalar";
+#endif
+}
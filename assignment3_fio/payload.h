@@ -0,0 +1,46 @@
+#ifndef PAYLOAD_H
+#define PAYLOAD_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// payload 검증 방식
+typedef enum {
+    PAYLOAD_CRC = 0,   // payload + CRC32 저장, read 시 CRC 재계산
+    PAYLOAD_SEED,      // payload = f(seed, LBA, generation), read 시 재생성 후 비교
+} payload_mode;
+
+#define PAYLOAD_MATCH ((size_t)-1)
+
+// dedupe 블록이 공유하는 canonical 패턴 개수
+#define PAYLOAD_DEDUPE_POOL 16
+
+// (seed, LBA, generation) 으로부터 섹터별 PRNG key 생성
+uint64_t payload_key(uint64_t seed, uint64_t lba, uint64_t generation);
+
+// header에 기록하는 key 요약값 (seed/generation 불일치 진단용)
+uint32_t payload_key_tag(uint64_t key);
+
+// dedupe unit의 섹터별 key: LBA 대신 (slot, unit 내 섹터 위치)로 결정
+uint64_t payload_dedupe_key(uint64_t seed, int slot, uint64_t sector_in_unit, uint64_t generation);
+
+// unit이 dedupe 대상이면 canonical slot 번호, 아니면 -1 (seed, unit 시작 LBA로 결정)
+int payload_dedupe_slot(uint64_t seed, uint64_t unit_lba, double dedupe_ratio);
+
+// 목표 압축률을 맞추기 위한 섹터당 random byte 수
+// 섹터 = header(압축 불가) + random + zero, 압축률 ~= sector_size / (header + random)
+size_t payload_random_len(size_t sector_size, size_t header_size, double compress_ratio);
+
+// key로부터 결정적인 payload 생성: 앞 random_len byte는 PRNG, 나머지는 0
+void payload_fill(uint64_t key, unsigned char *buf, size_t length, size_t random_len);
+
+// payload를 재생성하면서 비교, 일치하면 PAYLOAD_MATCH, 아니면 첫 번째 불일치 byte offset
+size_t payload_verify(uint64_t key, const unsigned char *buf, size_t length, size_t random_len);
+
+// 불일치 보고용: offset 위치의 기대값
+unsigned char payload_expected_byte(uint64_t key, size_t offset, size_t random_len);
+
+// 빌드된 SIMD 경로 이름 ("avx512", "avx2", "scalar")
+const char *payload_simd_name(void);
+
+#endif
@@ -0,0 +1,249 @@
+#define _GNU_SOURCE
+
+#include "perf_counters.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+#define PERF_EVENTS 4
+
+typedef enum {
+    PERF_MODE_NONE = 0,   // 아직 open 안 함
+    PERF_MODE_HW,
+    PERF_MODE_SW,
+    PERF_MODE_FAILED,
+} perf_mode;
+
+typedef struct {
+    int mode;
+    int fds[PERF_EVENTS];
+    uint64_t ids[PERF_EVENTS];
+    uint64_t start[PERF_EVENTS];
+    uint64_t sums[PERF_SCOPE_COUNT][PERF_EVENTS];
+    uint64_t bytes[PERF_SCOPE_COUNT];
+} __attribute__((aligned(64))) perf_slot;
+
+typedef struct {
+    uint32_t type;
+    uint64_t config;
+    const char *name;
+} perf_event_desc;
+
+static const perf_event_desc hw_events[PERF_EVENTS] = {
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES,       "cycles" },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS,     "instructions" },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES,     "cache-misses" },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES,    "branch-misses" },
+};
+
+static const perf_event_desc sw_events[PERF_EVENTS] = {
+    { PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK,       "task-clock-ns" },
+    { PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS,      "page-faults" },
+    { PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES, "context-switches" },
+    { PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CPU_MIGRATIONS,   "cpu-migrations" },
+};
+
+static const char *scope_names[PERF_SCOPE_COUNT] = { "generate", "verify" };
+
+static perf_slot *slots = NULL;
+static int num_slots = 0;
+
+static int perf_open(uint32_t type, uint64_t config, int group_fd) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = group_fd == -1;   // leader만 disabled로 시작
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_ID;
+    // pid=0, cpu=-1: 호출한 thread를 모든 CPU에서 측정
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0);
+}
+
+// leader가 열리면 나머지는 실패해도 계속 (fd = -1)
+static bool open_group(perf_slot *slot, const perf_event_desc *events) {
+    for (int e = 0; e < PERF_EVENTS; e++) {
+        slot->fds[e] = -1;
+    }
+    slot->fds[0] = perf_open(events[0].type, events[0].config, -1);
+    if (slot->fds[0] == -1) {
+        return false;
+    }
+    for (int e = 1; e < PERF_EVENTS; e++) {
+        slot->fds[e] = perf_open(events[e].type, events[e].config, slot->fds[0]);
+    }
+    for (int e = 0; e < PERF_EVENTS; e++) {
+        if (slot->fds[e] != -1) {
+            ioctl(slot->fds[e], PERF_EVENT_IOC_ID, &slot->ids[e]);
+        }
+    }
+    ioctl(slot->fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(slot->fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    return true;
+}
+
+static void open_slot(perf_slot *slot) {
+    if (open_group(slot, hw_events)) {
+        slot->mode = PERF_MODE_HW;
+    } else if (open_group(slot, sw_events)) {
+        slot->mode = PERF_MODE_SW;
+    } else {
+        slot->mode = PERF_MODE_FAILED;
+    }
+}
+
+// group 전체를 read() 한 번으로 읽음
+static bool read_group(perf_slot *slot, uint64_t values[PERF_EVENTS]) {
+    uint64_t buf[1 + 2 * PERF_EVENTS];
+    if (read(slot->fds[0], buf, sizeof(buf)) <= 0) {
+        return false;
+    }
+    memset(values, 0, sizeof(uint64_t) * PERF_EVENTS);
+    uint64_t nr = buf[0] < PERF_EVENTS ? buf[0] : PERF_EVENTS;
+    for (uint64_t i = 0; i < nr; i++) {
+        uint64_t value = buf[1 + 2 * i];
+        uint64_t id = buf[2 + 2 * i];
+        for (int e = 0; e < PERF_EVENTS; e++) {
+            if (slot->fds[e] != -1 && slot->ids[e] == id) {
+                values[e] = value;
+            }
+        }
+    }
+    return true;
+}
+
+bool perf_counters_init(int max_workers) {
+    slots = calloc((size_t)max_workers, sizeof(perf_slot));
+    if (slots == NULL) {
+        return false;
+    }
+    num_slots = max_workers;
+    return true;
+}
+
+void perf_counters_free(void) {
+    for (int w = 0; w < num_slots; w++) {
+        for (int e = 0; e < PERF_EVENTS; e++) {
+            if ((slots[w].mode == PERF_MODE_HW || slots[w].mode == PERF_MODE_SW) && slots[w].fds[e] != -1) {
+                close(slots[w].fds[e]);
+            }
+        }
+    }
+    free(slots);
+    slots = NULL;
+    num_slots = 0;
+}
+
+void perf_scope_begin(int worker) {
+    if (worker < 0 || worker >= num_slots) {
+        return;
+    }
+    perf_slot *slot = &slots[worker];
+    if (slot->mode == PERF_MODE_NONE) {
+        open_slot(slot);
+    }
+    if (slot->mode == PERF_MODE_HW || slot->mode == PERF_MODE_SW) {
+        read_group(slot, slot->start);
+    }
+}
+
+void perf_scope_end(int worker, perf_scope scope, size_t bytes) {
+    if (worker < 0 || worker >= num_slots) {
+        return;
+    }
+    perf_slot *slot = &slots[worker];
+    if (slot->mode != PERF_MODE_HW && slot->mode != PERF_MODE_SW) {
+        return;
+    }
+    uint64_t now[PERF_EVENTS];
+    if (!read_group(slot, now)) {
+        return;
+    }
+    for (int e = 0; e < PERF_EVENTS; e++) {
+        slot->sums[scope][e] += now[e] - slot->start[e];
+    }
+    slot->bytes[scope] += bytes;
+}
+
+void perf_counters_report(void) {
+    uint64_t sums[PERF_SCOPE_COUNT][PERF_EVENTS] = {{0}};
+    uint64_t bytes[PERF_SCOPE_COUNT] = {0};
+    int hw_threads = 0, sw_threads = 0;
+    bool have_event[PERF_EVENTS] = {false};
+
+    for (int w = 0; w < num_slots; w++) {
+        perf_slot *slot = &slots[w];
+        if (slot->mode == PERF_MODE_HW) {
+            hw_threads++;
+        } else if (slot->mode == PERF_MODE_SW) {
+            sw_threads++;
+        } else {
+            continue;
+        }
+        for (int e = 0; e < PERF_EVENTS; e++) {
+            if (slot->fds[e] != -1) {
+                have_event[e] = true;
+            }
+        }
+        for (int s = 0; s < PERF_SCOPE_COUNT; s++) {
+            bytes[s] += slot->bytes[s];
+            for (int e = 0; e < PERF_EVENTS; e++) {
+                sums[s][e] += slot->sums[s][e];
+            }
+        }
+    }
+
+    printf("\n=== Perf Counters ===\n");
+    if (hw_threads == 0 && sw_threads == 0) {
+        printf("perf_event_open unavailable (check /proc/sys/kernel/perf_event_paranoid)\n");
+        return;
+    }
+    // 한 실행 안에서 hw/sw가 섞이면 합계가 의미 없으므로 다수 쪽만 보고
+    bool hw = hw_threads >= sw_threads;
+    const perf_event_desc *events = hw ? hw_events : sw_events;
+    printf("Events: %s (%d threads):", hw ? "hardware" : "software fallback", hw ? hw_threads : sw_threads);
+    for (int e = 0; e < PERF_EVENTS; e++) {
+        printf(" %s%s", events[e].name, have_event[e] ? "" : "(unavailable)");
+    }
+    printf("\n");
+    if (hw_threads && sw_threads) {
+        printf("Warning: %d threads used %s events and are mixed into the totals\n",
+               hw ? sw_threads : hw_threads, hw ? "software" : "hardware");
+    }
+
+    for (int s = 0; s < PERF_SCOPE_COUNT; s++) {
+        if (bytes[s] == 0) {
+            continue;
+        }
+        double kb = bytes[s] / 1024.0;
+        printf("[PERF %s] %.2f MB |", scope_names[s], bytes[s] / (1024.0 * 1024.0));
+        if (hw) {
+            if (have_event[0] && have_event[1] && sums[s][0]) {
+                printf(" IPC %.2f |", (double)sums[s][1] / sums[s][0]);
+            }
+            if (have_event[0]) {
+                printf(" cycles/KB %.0f |", sums[s][0] / kb);
+            }
+            if (have_event[2]) {
+                printf(" cache-misses/KB %.3f |", sums[s][2] / kb);
+            }
+            if (have_event[3]) {
+                printf(" branch-misses/KB %.3f", sums[s][3] / kb);
+            }
+        } else {
+            for (int e = 0; e < PERF_EVENTS; e++) {
+                if (have_event[e]) {
+                    printf(" %s/KB %.3f%s", sw_events[e].name, sums[s][e] / kb, e + 1 < PERF_EVENTS ? " |" : "");
+                }
+            }
+        }
+        printf("\n");
+    }
+}
@@ -0,0 +1,28 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// generate/verify 구간을 감싸는 thread별 perf_event_open 카운터 (--perf-counters)
+// hardware 이벤트(cycles, instructions, cache-misses, branch-misses)를 우선 사용하고
+// 사용할 수 없으면 software 이벤트(task-clock, page-faults, context-switches, cpu-migrations)로 대체
+
+typedef enum {
+    PERF_SCOPE_GENERATE = 0,
+    PERF_SCOPE_VERIFY,
+    PERF_SCOPE_COUNT
+} perf_scope;
+
+bool perf_counters_init(int max_workers);
+void perf_counters_free(void);
+
+// 호출한 thread에서 구간 시작/종료 (worker slot의 카운터는 해당 thread에서 처음 호출 시 open)
+void perf_scope_begin(int worker);
+void perf_scope_end(int worker, perf_scope scope, size_t bytes);
+
+// IPC, KB당 miss 등 최종 요약 출력
+void perf_counters_report(void);
+
+#endif
@@ -0,0 +1,71 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "phase_stats.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+
+typedef struct {
+    _Atomic uint64_t ns[PHASE_COUNT];
+} __attribute__((aligned(64))) phase_slot;
+
+static phase_slot *slots = NULL;
+static int num_slots = 0;
+
+static const char *phase_names[PHASE_COUNT] = { "gen", "submit", "wait", "verify" };
+
+bool phase_stats_init(int max_workers) {
+    slots = aligned_alloc(64, sizeof(phase_slot) * (size_t)max_workers);
+    if (slots == NULL) {
+        return false;
+    }
+    for (int w = 0; w < max_workers; w++) {
+        for (int p = 0; p < PHASE_COUNT; p++) {
+            atomic_init(&slots[w].ns[p], 0);
+        }
+    }
+    num_slots = max_workers;
+    return true;
+}
+
+void phase_stats_free(void) {
+    free(slots);
+    slots = NULL;
+    num_slots = 0;
+}
+
+void phase_stats_add(int worker, io_phase phase, uint64_t ns) {
+    if (worker < 0 || worker >= num_slots) {
+        return;
+    }
+    _Atomic uint64_t *v = &slots[worker].ns[phase];
+    atomic_store_explicit(v, atomic_load_explicit(v, memory_order_relaxed) + ns, memory_order_relaxed);
+}
+
+void phase_stats_totals(uint64_t out[PHASE_COUNT]) {
+    for (int p = 0; p < PHASE_COUNT; p++) {
+        out[p] = 0;
+    }
+    for (int w = 0; w < num_slots; w++) {
+        for (int p = 0; p < PHASE_COUNT; p++) {
+            out[p] += atomic_load_explicit(&slots[w].ns[p], memory_order_relaxed);
+        }
+    }
+}
+
+void phase_stats_print(const char *label, const uint64_t delta[PHASE_COUNT], uint64_t bytes) {
+    uint64_t total = 0;
+    for (int p = 0; p < PHASE_COUNT; p++) {
+        total += delta[p];
+    }
+    // device 대기를 제외한 CPU 시간
+    double cpu_seconds = (delta[PHASE_GENERATE] + delta[PHASE_SUBMIT] + delta[PHASE_VERIFY]) / 1e9;
+    double gb = bytes / (1024.0 * 1024.0 * 1024.0);
+
+    printf("[%s CPU] %.3f CPU-s/GB |", label, gb > 0 ? cpu_seconds / gb : 0.0);
+    for (int p = 0; p < PHASE_COUNT; p++) {
+        printf(" %s %.1f%%", phase_names[p], total ? 100.0 * delta[p] / total : 0.0);
+    }
+    printf("\n");
+}
@@ -0,0 +1,38 @@
+#ifndef PHASE_STATS_H
+#define PHASE_STATS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+
+// worker thread별 phase 시간 집계 (--cpu-stats)
+// generate/verify 는 TSC 구간 시간, submit은 syscall 안에서 소비한 thread CPU 시간,
+// wait은 syscall wall 시간 - submit (device 대기)
+
+typedef enum {
+    PHASE_GENERATE = 0,   // header + payload 생성
+    PHASE_SUBMIT,         // pread/pwrite 내부 CPU 시간 (kernel 경로, copy)
+    PHASE_WAIT,           // pread/pwrite 중 device 대기
+    PHASE_VERIFY,         // 섹터 검증
+    PHASE_COUNT
+} io_phase;
+
+bool phase_stats_init(int max_workers);
+void phase_stats_free(void);
+
+// 자기 worker slot에만 기록 (single writer, RMW 없음)
+void phase_stats_add(int worker, io_phase phase, uint64_t ns);
+
+// 모든 worker 합계
+void phase_stats_totals(uint64_t out[PHASE_COUNT]);
+
+// CPU-s/GB 와 phase별 비율 출력 (delta = 구간 phase 시간, bytes = 구간 처리량)
+void phase_stats_print(const char *label, const uint64_t delta[PHASE_COUNT], uint64_t bytes);
+
+static inline uint64_t thread_cpu_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+#endif
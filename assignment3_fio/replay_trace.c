@@ -0,0 +1,135 @@
+#include "replay_trace.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct replay_reader {
+    FILE *fp;
+    bool binary;
+    uint64_t position;
+};
+
+replay_reader *replay_open(const char *path) {
+    FILE *fp = fopen(path, "rb");
+    if (fp == NULL) {
+        perror("Failed to open replay trace");
+        return NULL;
+    }
+
+    replay_reader *reader = calloc(1, sizeof(replay_reader));
+    if (reader == NULL) {
+        fclose(fp);
+        return NULL;
+    }
+    reader->fp = fp;
+
+    char magic[8];
+    if (fread(magic, 1, sizeof(magic), fp) == sizeof(magic) && memcmp(magic, REPLAY_MAGIC, sizeof(magic)) == 0) {
+        reader->binary = true;
+    } else {
+        rewind(fp);
+    }
+    return reader;
+}
+
+void replay_close(replay_reader *reader) {
+    if (reader == NULL) {
+        return;
+    }
+    fclose(reader->fp);
+    free(reader);
+}
+
+uint64_t replay_position(const replay_reader *reader) {
+    return reader->position;
+}
+
+bool replay_is_binary(const replay_reader *reader) {
+    return reader->binary;
+}
+
+// 초 단위 timestamp -> ns
+static uint64_t seconds_to_ns(double seconds) {
+    return seconds <= 0.0 ? 0 : (uint64_t)(seconds * 1e9 + 0.5);
+}
+
+// text 한 줄 파싱: 1 = entry, 0 = 건너뛸 줄, -1 = 오류
+static int parse_line(const char *line, replay_entry *out) {
+    double seconds;
+    char op[16];
+    unsigned long long lba, sectors;
+
+    // blkparse 기본 출력: dev cpu seq time pid action rwbs sector + n
+    char dev[32], action[8], rwbs[16];
+    unsigned cpu, pid;
+    unsigned long long seq;
+    if (sscanf(line, "%31s %u %llu %lf %u %7s %15s %llu + %llu",
+               dev, &cpu, &seq, &seconds, &pid, action, rwbs, &lba, &sectors) == 9) {
+        // queue 이벤트의 read/write만 사용 (discard, flush 등 제외)
+        if (strcmp(action, "Q") != 0 || strchr(rwbs, 'D') != NULL) {
+            return 0;
+        }
+        if (strchr(rwbs, 'W') != NULL) {
+            out->is_write = true;
+        } else if (strchr(rwbs, 'R') != NULL) {
+            out->is_write = false;
+        } else {
+            return 0;
+        }
+        out->time_ns = seconds_to_ns(seconds);
+        out->lba = lba;
+        out->sectors = (uint32_t)sectors;
+        return sectors > 0 ? 1 : 0;
+    }
+
+    // 단순 형식
+    if (sscanf(line, "%lf %15s %llu %llu", &seconds, op, &lba, &sectors) == 4) {
+        if (op[0] != 'R' && op[0] != 'r' && op[0] != 'W' && op[0] != 'w') {
+            return -1;
+        }
+        out->is_write = op[0] == 'W' || op[0] == 'w';
+        out->time_ns = seconds_to_ns(seconds);
+        out->lba = lba;
+        out->sectors = (uint32_t)sectors;
+        return sectors > 0 ? 1 : 0;
+    }
+
+    return 0;
+}
+
+int replay_next(replay_reader *reader, replay_entry *out) {
+    if (reader->binary) {
+        replay_record rec;
+        if (fread(&rec, sizeof(rec), 1, reader->fp) != 1) {
+            return 0;
+        }
+        reader->position++;
+        if (rec.op > 1 || rec.sectors == 0) {
+            return -1;
+        }
+        out->time_ns = rec.time_ns;
+        out->lba = rec.lba;
+        out->sectors = rec.sectors;
+        out->is_write = rec.op == 1;
+        return 1;
+    }
+
+    char line[512];
+    while (fgets(line, sizeof(line), reader->fp) != NULL) {
+        reader->position++;
+        const char *p = line;
+        while (*p == ' ' || *p == '\t') {
+            p++;
+        }
+        if (*p == '#' || *p == '\n' || *p == '\0') {
+            continue;
+        }
+        int ret = parse_line(p, out);
+        if (ret != 0) {
+            return ret;
+        }
+        // blkparse 요약 줄 등은 건너뜀
+    }
+    return 0;
+}
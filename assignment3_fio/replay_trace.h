@@ -0,0 +1,44 @@
+#ifndef REPLAY_TRACE_H
+#define REPLAY_TRACE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// replay용 block trace reader (한 줄/레코드씩 streaming, 파일 전체를 메모리에 올리지 않음)
+//
+// text 형식 (한 줄에 하나, '#' 주석):
+//   <timestamp_sec> <R|W> <lba> <sectors>          예) 0.000123 W 2048 256
+// blkparse 기본 출력의 queue(Q) 이벤트도 그대로 읽음:
+//   8,0  3  1  0.000000000  697  Q  W 223490 + 8 [kjournald]
+// binary 형식: "FIOREPL1" magic + replay_record 배열 (little endian)
+
+#define REPLAY_MAGIC "FIOREPL1"
+
+typedef struct {
+    uint64_t time_ns;
+    uint64_t lba;        // 512B sector 단위
+    uint32_t sectors;
+    uint32_t op;         // 0 = read, 1 = write
+} replay_record;
+
+typedef struct {
+    uint64_t time_ns;
+    uint64_t lba;
+    uint32_t sectors;
+    bool is_write;
+} replay_entry;
+
+typedef struct replay_reader replay_reader;
+
+// 형식 자동 감지
+replay_reader *replay_open(const char *path);
+void replay_close(replay_reader *reader);
+
+// 1: entry 반환, 0: EOF, -1: 형식 오류
+int replay_next(replay_reader *reader, replay_entry *out);
+
+// 오류 메시지용 현재 줄/레코드 번호
+uint64_t replay_position(const replay_reader *reader);
+bool replay_is_binary(const replay_reader *reader);
+
+#endif
@@ -0,0 +1,217 @@
+#define _GNU_SOURCE
+
+#include "shm_stats.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#define RELAXED memory_order_relaxed
+
+static void shm_object_name(const char *name, char *out, size_t size) {
+    snprintf(out, size, "/%s%s", SHM_STATS_PREFIX, name);
+}
+
+shm_stats_segment *shm_stats_create(const char *name) {
+    char path[256];
+    shm_object_name(name, path, sizeof(path));
+
+    int fd = shm_open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd == -1) {
+        perror("shm_open");
+        return NULL;
+    }
+    if (ftruncate(fd, sizeof(shm_stats_segment)) == -1) {
+        perror("ftruncate");
+        close(fd);
+        shm_unlink(path);
+        return NULL;
+    }
+
+    shm_stats_segment *seg = mmap(NULL, sizeof(shm_stats_segment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (seg == MAP_FAILED) {
+        perror("mmap");
+        shm_unlink(path);
+        return NULL;
+    }
+
+    // ftruncate로 0 초기화된 상태, magic은 마지막에 기록
+    seg->version = SHM_STATS_VERSION;
+    seg->header_size = (uint32_t)offsetof(shm_stats_segment, threads);
+    seg->slot_size = (uint32_t)sizeof(shm_thread_stats);
+    seg->max_threads = SHM_STATS_MAX_THREADS;
+    seg->pid = (int32_t)getpid();
+    atomic_thread_fence(memory_order_release);
+    seg->magic = SHM_STATS_MAGIC;
+    return seg;
+}
+
+void shm_stats_destroy(shm_stats_segment *seg, const char *name) {
+    char path[256];
+    shm_object_name(name, path, sizeof(path));
+    munmap(seg, sizeof(shm_stats_segment));
+    shm_unlink(path);
+}
+
+void shm_stats_begin(shm_stats_segment *seg, const char *operation, uint64_t total_size) {
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+
+    uint64_t seq = atomic_load_explicit(&seg->seq, RELAXED);
+    atomic_store_explicit(&seg->seq, seq + 1, RELAXED);
+    atomic_thread_fence(memory_order_release);
+
+    memset(seg->operation, 0, sizeof(seg->operation));
+    strncpy(seg->operation, operation, sizeof(seg->operation) - 1);
+    atomic_store_explicit(&seg->total_size, total_size, RELAXED);
+    atomic_store_explicit(&seg->start_ns, (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec, RELAXED);
+    atomic_store_explicit(&seg->finished, 0, RELAXED);
+    atomic_store_explicit(&seg->nthreads, 0, RELAXED);
+
+    // 이전 작업의 slot 통계 초기화 (worker 시작 전이므로 writer 경합 없음)
+    for (int t = 0; t < SHM_STATS_MAX_THREADS; t++) {
+        shm_thread_stats *slot = &seg->threads[t];
+        uint64_t s = atomic_load_explicit(&slot->seq, RELAXED);
+        atomic_store_explicit(&slot->seq, s + 1, RELAXED);
+        atomic_thread_fence(memory_order_release);
+        atomic_store_explicit(&slot->bytes, 0, RELAXED);
+        atomic_store_explicit(&slot->ios, 0, RELAXED);
+        atomic_store_explicit(&slot->errors, 0, RELAXED);
+        atomic_store_explicit(&slot->failures, 0, RELAXED);
+        atomic_store_explicit(&slot->state, SHM_THREAD_IDLE, RELAXED);
+        for (int b = 0; b < SHM_STATS_LAT_BUCKETS; b++) {
+            atomic_store_explicit(&slot->lat_buckets[b], 0, RELAXED);
+        }
+        atomic_store_explicit(&slot->seq, s + 2, memory_order_release);
+    }
+
+    atomic_store_explicit(&seg->seq, seq + 2, memory_order_release);
+}
+
+void shm_stats_finish(shm_stats_segment *seg) {
+    uint64_t n = atomic_load_explicit(&seg->nthreads, RELAXED);
+    for (uint64_t t = 0; t < n; t++) {
+        shm_thread_stats *slot = &seg->threads[t];
+        uint64_t s = atomic_load_explicit(&slot->seq, RELAXED);
+        atomic_store_explicit(&slot->seq, s + 1, RELAXED);
+        atomic_thread_fence(memory_order_release);
+        atomic_store_explicit(&slot->state, SHM_THREAD_DONE, RELAXED);
+        atomic_store_explicit(&slot->seq, s + 2, memory_order_release);
+    }
+    atomic_store_explicit(&seg->finished, 1, memory_order_release);
+}
+
+int shm_stats_latency_bucket(uint64_t latency_ns) {
+    uint64_t us = latency_ns / 1000;
+    if (us == 0) {
+        return 0;
+    }
+    int b = 64 - __builtin_clzll(us);
+    return b < SHM_STATS_LAT_BUCKETS ? b : SHM_STATS_LAT_BUCKETS - 1;
+}
+
+void shm_stats_record(shm_stats_segment *seg, int thread_idx, uint64_t bytes,
+                      uint64_t latency_ns, uint64_t errors, bool failed) {
+    if (thread_idx < 0 || thread_idx >= SHM_STATS_MAX_THREADS) {
+        return;
+    }
+    shm_thread_stats *slot = &seg->threads[thread_idx];
+
+    // slot 최초 사용 시 nthreads 확장 (thread당 한 번)
+    if (atomic_load_explicit(&slot->state, RELAXED) != SHM_THREAD_RUNNING) {
+        uint64_t n = atomic_load_explicit(&seg->nthreads, RELAXED);
+        while (n < (uint64_t)thread_idx + 1 &&
+               !atomic_compare_exchange_weak(&seg->nthreads, &n, (uint64_t)thread_idx + 1)) {
+        }
+    }
+
+    // 자기 slot만 쓰므로 RMW 없이 load + store
+    uint64_t s = atomic_load_explicit(&slot->seq, RELAXED);
+    atomic_store_explicit(&slot->seq, s + 1, RELAXED);
+    atomic_thread_fence(memory_order_release);
+
+    atomic_store_explicit(&slot->bytes, atomic_load_explicit(&slot->bytes, RELAXED) + bytes, RELAXED);
+    atomic_store_explicit(&slot->ios, atomic_load_explicit(&slot->ios, RELAXED) + 1, RELAXED);
+    if (errors) {
+        atomic_store_explicit(&slot->errors, atomic_load_explicit(&slot->errors, RELAXED) + errors, RELAXED);
+    }
+    if (failed) {
+        atomic_store_explicit(&slot->failures, atomic_load_explicit(&slot->failures, RELAXED) + 1, RELAXED);
+    }
+    int b = shm_stats_latency_bucket(latency_ns);
+    atomic_store_explicit(&slot->lat_buckets[b], atomic_load_explicit(&slot->lat_buckets[b], RELAXED) + 1, RELAXED);
+    atomic_store_explicit(&slot->state, SHM_THREAD_RUNNING, RELAXED);
+
+    atomic_store_explicit(&slot->seq, s + 2, memory_order_release);
+}
+
+shm_stats_segment *shm_stats_attach(const char *name) {
+    char path[256];
+    shm_object_name(name, path, sizeof(path));
+
+    int fd = shm_open(path, O_RDONLY, 0);
+    if (fd == -1) {
+        return NULL;
+    }
+    shm_stats_segment *seg = mmap(NULL, sizeof(shm_stats_segment), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (seg == MAP_FAILED) {
+        return NULL;
+    }
+
+    // 다른 버전/layout의 segment는 거부
+    if (seg->magic != SHM_STATS_MAGIC || seg->version != SHM_STATS_VERSION ||
+        seg->slot_size != sizeof(shm_thread_stats) ||
+        seg->header_size != offsetof(shm_stats_segment, threads)) {
+        munmap(seg, sizeof(shm_stats_segment));
+        return NULL;
+    }
+    return seg;
+}
+
+void shm_stats_snapshot_thread(const shm_stats_segment *seg, int thread_idx, shm_thread_snapshot *out) {
+    const shm_thread_stats *slot = &seg->threads[thread_idx];
+    shm_thread_stats *s = (shm_thread_stats *)slot;
+    uint64_t before, after;
+
+    do {
+        before = atomic_load_explicit(&s->seq, memory_order_acquire);
+        if (before & 1) {
+            continue;
+        }
+        out->bytes = atomic_load_explicit(&s->bytes, RELAXED);
+        out->ios = atomic_load_explicit(&s->ios, RELAXED);
+        out->errors = atomic_load_explicit(&s->errors, RELAXED);
+        out->failures = atomic_load_explicit(&s->failures, RELAXED);
+        out->state = atomic_load_explicit(&s->state, RELAXED);
+        for (int b = 0; b < SHM_STATS_LAT_BUCKETS; b++) {
+            out->lat_buckets[b] = atomic_load_explicit(&s->lat_buckets[b], RELAXED);
+        }
+        atomic_thread_fence(memory_order_acquire);
+        after = atomic_load_explicit(&s->seq, RELAXED);
+    } while ((before & 1) || before != after);
+}
+
+void shm_stats_snapshot_run(const shm_stats_segment *seg, char operation[16],
+                            uint64_t *total_size, uint64_t *start_ns, uint64_t *finished) {
+    shm_stats_segment *s = (shm_stats_segment *)seg;
+    uint64_t before, after;
+
+    do {
+        before = atomic_load_explicit(&s->seq, memory_order_acquire);
+        if (before & 1) {
+            continue;
+        }
+        memcpy(operation, (const char *)s->operation, 16);
+        *total_size = atomic_load_explicit(&s->total_size, RELAXED);
+        *start_ns = atomic_load_explicit(&s->start_ns, RELAXED);
+        *finished = atomic_load_explicit(&s->finished, memory_order_acquire);
+        atomic_thread_fence(memory_order_acquire);
+        after = atomic_load_explicit(&s->seq, RELAXED);
+    } while ((before & 1) || before != after);
+    operation[15] = '\0';
+}
@@ -0,0 +1,83 @@
+#ifndef SHM_STATS_H
+#define SHM_STATS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <sys/types.h>
+
+// /dev/shm 에 공개하는 실시간 통계 segment
+// 각 worker thread는 자기 slot만 갱신 (single writer seqlock) -> I/O loop에 lock/RMW 없음
+// reader는 seq가 짝수이고 읽기 전후 값이 같을 때만 snapshot을 채택한다.
+
+#define SHM_STATS_MAGIC       0x534F4946u  // "FIOS"
+#define SHM_STATS_VERSION     1u
+#define SHM_STATS_MAX_THREADS 256
+#define SHM_STATS_LAT_BUCKETS 32          // bucket b: [2^(b-1), 2^b) us, bucket 0: < 1us
+#define SHM_STATS_PREFIX      "fio_simulator."
+
+typedef enum {
+    SHM_THREAD_IDLE = 0,
+    SHM_THREAD_RUNNING,
+    SHM_THREAD_DONE,
+} shm_thread_state;
+
+// thread별 slot (cache line 단위로 분리)
+typedef struct {
+    _Atomic uint64_t seq;
+    _Atomic uint64_t bytes;
+    _Atomic uint64_t ios;
+    _Atomic uint64_t errors;      // 검증 실패 섹터 수
+    _Atomic uint64_t failures;    // I/O 실패 블록 수
+    _Atomic uint64_t state;
+    _Atomic uint64_t lat_buckets[SHM_STATS_LAT_BUCKETS];
+} __attribute__((aligned(64))) shm_thread_stats;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t header_size;
+    uint32_t slot_size;
+    uint32_t max_threads;
+    int32_t pid;
+    _Atomic uint64_t seq;          // 아래 run 정보용 seqlock
+    _Atomic uint64_t nthreads;     // 사용된 slot 수 (최대 index + 1)
+    _Atomic uint64_t total_size;   // 이번 작업의 목표 byte 수
+    _Atomic uint64_t start_ns;     // CLOCK_REALTIME 기준 작업 시작 시각
+    _Atomic uint64_t finished;
+    char operation[16];
+    shm_thread_stats threads[SHM_STATS_MAX_THREADS];
+} __attribute__((aligned(64))) shm_stats_segment;
+
+// reader가 사용하는 일관된 snapshot
+typedef struct {
+    uint64_t bytes;
+    uint64_t ios;
+    uint64_t errors;
+    uint64_t failures;
+    uint64_t state;
+    uint64_t lat_buckets[SHM_STATS_LAT_BUCKETS];
+} shm_thread_snapshot;
+
+// writer 측: segment 생성/삭제
+shm_stats_segment *shm_stats_create(const char *name);
+void shm_stats_destroy(shm_stats_segment *seg, const char *name);
+
+// 새 작업 시작 (operation 이름, 목표 byte 수), slot 통계는 초기화
+void shm_stats_begin(shm_stats_segment *seg, const char *operation, uint64_t total_size);
+void shm_stats_finish(shm_stats_segment *seg);
+
+// 호출한 worker thread의 slot에 블록 하나의 결과를 반영
+void shm_stats_record(shm_stats_segment *seg, int thread_idx, uint64_t bytes,
+                      uint64_t latency_ns, uint64_t errors, bool failed);
+
+// reader 측
+shm_stats_segment *shm_stats_attach(const char *name);
+void shm_stats_snapshot_thread(const shm_stats_segment *seg, int thread_idx, shm_thread_snapshot *out);
+void shm_stats_snapshot_run(const shm_stats_segment *seg, char operation[16],
+                            uint64_t *total_size, uint64_t *start_ns, uint64_t *finished);
+
+int shm_stats_latency_bucket(uint64_t latency_ns);
+
+#endif
@@ -0,0 +1,594 @@
+#define _GNU_SOURCE
+
+#include "ssd_backend.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#define SSD_SECTOR 512
+#define SSD_ALIGN  4096
+#define SSD_INVALID UINT32_MAX
+#define SSD_STATE_MAGIC "FIOSSD01"
+#define SSD_LPN_LOCKS 256         // host의 부분 page 연산을 lpn별로 직렬화하는 lock stripe
+
+typedef enum {
+    BLOCK_FREE = 0,
+    BLOCK_ACTIVE,
+    BLOCK_FULL,
+} block_state;
+
+// bank 하나의 상태, 아래 필드와 이 bank에 속한 page의 p2l/valid는 lock으로 보호
+typedef struct {
+    pthread_mutex_t lock;
+    uint32_t *free_blocks;        // free block stack (전역 block 번호)
+    uint64_t free_count;
+    uint32_t active;              // 현재 program 중인 block, 없으면 SSD_INVALID
+    uint32_t next_page;
+    uint64_t busy_until;          // 가상 timeline (CLOCK_MONOTONIC ns)
+    uint64_t gc_until;            // GC가 점유한 마지막 시각
+    uint64_t host_reads;
+    uint64_t host_programs;
+    uint64_t gc_copies;
+    uint64_t erases;
+    uint64_t gc_runs;
+    uint64_t stalled_ops;
+    uint64_t stall_ns;
+    unsigned char *gc_buf;        // GC 복사 전용 page buffer (host bounce buffer와 분리)
+} __attribute__((aligned(64))) ssd_bank;
+
+typedef struct {
+    io_backend base;
+    io_backend *inner;
+    nand_geometry geo;
+    uint64_t read_ns;
+    uint64_t program_ns;
+    uint64_t erase_ns;
+    bool timed;
+
+    uint64_t page_size;
+    uint64_t pages_per_block;
+    uint64_t blocks_per_bank;
+    uint64_t total_blocks;
+    uint64_t total_pages;
+    uint64_t logical_pages;
+
+    _Atomic uint32_t *l2p;        // logical page -> physical page
+    uint32_t *p2l;                // physical page -> logical page (GC 용)
+    uint32_t *valid;              // block별 valid page 수
+    uint32_t *erase_count;
+    uint8_t *state;
+    ssd_bank *banks;
+    pthread_mutex_t lpn_locks[SSD_LPN_LOCKS];
+    unsigned char *bounce[SSD_LPN_LOCKS];   // 부분 page 병합용 buffer, 같은 index의 lpn lock으로 보호
+} ssd_backend;
+
+typedef struct {
+    char magic[8];
+    uint64_t bank;
+    uint64_t block;
+    uint64_t page;
+    uint64_t page_size;
+    uint64_t logical_pages;
+} ssd_state_header;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// lpn lock stripe의 page 크기 bounce buffer, 처음 쓸 때 할당 (lpn lock 보유 상태)
+static unsigned char *bounce_buffer(ssd_backend *s, uint64_t lpn) {
+    unsigned char **buf = &s->bounce[lpn % SSD_LPN_LOCKS];
+    if (*buf == NULL && posix_memalign((void **)buf, SSD_ALIGN, s->page_size) != 0) {
+        *buf = NULL;
+    }
+    return *buf;
+}
+
+static inline uint64_t block_of(const ssd_backend *s, uint64_t ppn) {
+    return ppn / s->pages_per_block;
+}
+
+static inline ssd_bank *bank_of(ssd_backend *s, uint64_t ppn) {
+    return &s->banks[ppn / (s->pages_per_block * s->blocks_per_bank)];
+}
+
+// bank timeline에 연산 하나를 배치하고 완료 시각 반환 (lock 보유 상태)
+static uint64_t bank_schedule(ssd_backend *s, ssd_bank *bank, uint64_t duration, bool host) {
+    if (!s->timed) {
+        return 0;
+    }
+    uint64_t now = now_ns();
+    if (host && bank->gc_until > now) {
+        bank->stalled_ops++;
+        bank->stall_ns += bank->gc_until - now;
+    }
+    uint64_t start = bank->busy_until > now ? bank->busy_until : now;
+    bank->busy_until = start + duration;
+    return bank->busy_until;
+}
+
+// dsync는 host write의 program에만 전달 (FTL mapping 자체는 --ssd-state 저장 시 기록)
+static bool page_io(ssd_backend *s, bool is_write, void *buf, uint64_t ppn, bool dsync) {
+    uint64_t offset = ppn * s->page_size;
+    ssize_t ret = is_write ? s->inner->pwrite(s->inner, buf, s->page_size, offset, dsync)
+                           : s->inner->pread(s->inner, buf, s->page_size, offset);
+    return ret == (ssize_t)s->page_size;
+}
+
+// 이전 위치 무효화 (ppn이 속한 bank lock 보유 상태)
+// 같은 page가 그 사이 GC로 옮겨졌거나 다시 할당되었으면 아무것도 하지 않음
+static void invalidate_locked(ssd_backend *s, uint64_t ppn, uint32_t lpn) {
+    if (s->p2l[ppn] == lpn && atomic_load(&s->l2p[lpn]) != ppn) {
+        s->p2l[ppn] = SSD_INVALID;
+        s->valid[block_of(s, ppn)]--;
+    }
+}
+
+// active block에서 page 하나 할당, for_gc면 GC 예비 block까지 사용 (lock 보유 상태)
+static uint64_t alloc_page(ssd_backend *s, ssd_bank *bank, bool for_gc) {
+    if (bank->active == SSD_INVALID || bank->next_page == s->pages_per_block) {
+        if (bank->active != SSD_INVALID) {
+            s->state[bank->active] = BLOCK_FULL;
+            bank->active = SSD_INVALID;
+        }
+        if (bank->free_count == 0 || (!for_gc && bank->free_count <= SSD_GC_RESERVE)) {
+            return UINT64_MAX;
+        }
+        bank->active = bank->free_blocks[--bank->free_count];
+        bank->next_page = 0;
+        s->state[bank->active] = BLOCK_ACTIVE;
+    }
+    return (uint64_t)bank->active * s->pages_per_block + bank->next_page++;
+}
+
+// greedy GC 한 번: valid page가 가장 적은 full block을 비움 (lock 보유 상태)
+static bool gc_once(ssd_backend *s, ssd_bank *bank, uint64_t bank_idx) {
+    uint64_t first = bank_idx * s->blocks_per_bank;
+    uint64_t victim = UINT64_MAX;
+    uint32_t best = UINT32_MAX;
+    for (uint64_t b = first; b < first + s->blocks_per_bank; b++) {
+        if (s->state[b] == BLOCK_FULL && s->valid[b] < best) {
+            best = s->valid[b];
+            victim = b;
+        }
+    }
+    if (victim == UINT64_MAX || best == s->pages_per_block) {
+        return false;
+    }
+
+    // host write가 병합 중인 bounce buffer를 덮어쓰지 않도록 bank의 buffer 사용
+    unsigned char *buf = bank->gc_buf;
+    for (uint64_t p = 0; p < s->pages_per_block; p++) {
+        uint64_t ppn = victim * s->pages_per_block + p;
+        uint32_t lpn = s->p2l[ppn];
+        if (lpn == SSD_INVALID) {
+            continue;
+        }
+        uint64_t dest = alloc_page(s, bank, true);
+        if (dest == UINT64_MAX || !page_io(s, false, buf, ppn, false) || !page_io(s, true, buf, dest, false)) {
+            return false;
+        }
+        s->p2l[dest] = lpn;
+        s->valid[block_of(s, dest)]++;
+        // host가 그 사이 덮어썼으면 복사본은 바로 무효
+        uint32_t expected = (uint32_t)ppn;
+        if (!atomic_compare_exchange_strong(&s->l2p[lpn], &expected, (uint32_t)dest)) {
+            s->p2l[dest] = SSD_INVALID;
+            s->valid[block_of(s, dest)]--;
+        }
+        s->p2l[ppn] = SSD_INVALID;
+        s->valid[victim]--;
+        bank->gc_copies++;
+        bank->gc_until = bank_schedule(s, bank, s->read_ns + s->program_ns, false);
+    }
+
+    s->state[victim] = BLOCK_FREE;
+    s->erase_count[victim]++;
+    bank->free_blocks[bank->free_count++] = (uint32_t)victim;
+    bank->erases++;
+    bank->gc_runs++;
+    bank->gc_until = bank_schedule(s, bank, s->erase_ns, false);
+    return true;
+}
+
+// logical page 하나를 자기 bank (lpn % bank)에 program, 완료 시각을 *done에 반영
+static bool program_page(ssd_backend *s, uint32_t lpn, void *data, bool dsync, uint64_t *done) {
+    uint64_t bank_idx = nand_geometry_bank_of(&s->geo, lpn);
+    ssd_bank *bank = &s->banks[bank_idx];
+
+    pthread_mutex_lock(&bank->lock);
+    uint64_t ppn = alloc_page(s, bank, false);
+    // free block이 예비분만 남으면 foreground GC
+    while (ppn == UINT64_MAX) {
+        if (!gc_once(s, bank, bank_idx)) {
+            pthread_mutex_unlock(&bank->lock);
+            errno = ENOSPC;
+            return false;
+        }
+        ppn = alloc_page(s, bank, false);
+    }
+    if (!page_io(s, true, data, ppn, dsync)) {
+        pthread_mutex_unlock(&bank->lock);
+        return false;
+    }
+    s->p2l[ppn] = lpn;
+    s->valid[block_of(s, ppn)]++;
+    // GC가 반쯤 기록된 mapping을 보지 않도록 lock 안에서 교체
+    uint32_t old = atomic_exchange(&s->l2p[lpn], (uint32_t)ppn);
+    bank->host_programs++;
+    uint64_t end = bank_schedule(s, bank, s->program_ns, true);
+    if (end > *done) {
+        *done = end;
+    }
+
+    ssd_bank *old_bank = old != SSD_INVALID ? bank_of(s, old) : NULL;
+    if (old_bank == bank) {
+        invalidate_locked(s, old, lpn);
+    }
+    pthread_mutex_unlock(&bank->lock);
+
+    if (old_bank != NULL && old_bank != bank) {
+        pthread_mutex_lock(&old_bank->lock);
+        invalidate_locked(s, old, lpn);
+        pthread_mutex_unlock(&old_bank->lock);
+    }
+    return true;
+}
+
+// logical page 하나를 읽음, 한 번도 쓰이지 않은 page는 0
+static bool read_page(ssd_backend *s, uint32_t lpn, unsigned char *dest, uint64_t *done) {
+    for (;;) {
+        uint32_t ppn = atomic_load(&s->l2p[lpn]);
+        if (ppn == SSD_INVALID) {
+            memset(dest, 0, s->page_size);
+            return true;
+        }
+        ssd_bank *bank = bank_of(s, ppn);
+        pthread_mutex_lock(&bank->lock);
+        // lock을 잡는 사이 GC로 옮겨졌으면 다시 조회
+        if (atomic_load(&s->l2p[lpn]) != ppn) {
+            pthread_mutex_unlock(&bank->lock);
+            continue;
+        }
+        bool ok = page_io(s, false, dest, ppn, false);
+        bank->host_reads++;
+        uint64_t end = bank_schedule(s, bank, s->read_ns, true);
+        if (end > *done) {
+            *done = end;
+        }
+        pthread_mutex_unlock(&bank->lock);
+        return ok;
+    }
+}
+
+// 모든 page 연산이 bank timeline에서 끝날 때까지 대기
+static void wait_until(uint64_t done) {
+    if (done == 0) {
+        return;
+    }
+    struct timespec ts = {
+        .tv_sec = (time_t)(done / 1000000000ULL),
+        .tv_nsec = (long)(done % 1000000000ULL)
+    };
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) {
+    }
+}
+
+static bool range_ok(const ssd_backend *s, size_t len, uint64_t offset) {
+    if (offset % SSD_SECTOR != 0 || len % SSD_SECTOR != 0 || offset + len > s->logical_pages * s->page_size) {
+        errno = EINVAL;
+        return false;
+    }
+    return true;
+}
+
+static ssize_t ssd_pread(io_backend *be, void *buf, size_t len, uint64_t offset) {
+    ssd_backend *s = (ssd_backend *)be;
+    if (!range_ok(s, len, offset)) {
+        return -1;
+    }
+    uint64_t done = 0;
+    size_t pos = 0;
+    while (pos < len) {
+        uint64_t lpn = (offset + pos) / s->page_size;
+        size_t in_page = (offset + pos) % s->page_size;
+        size_t chunk = s->page_size - in_page < len - pos ? s->page_size - in_page : len - pos;
+        unsigned char *dest = (unsigned char *)buf + pos;
+
+        // page 전체이고 정렬되어 있으면 사용자 buffer로 바로 읽음
+        bool direct = in_page == 0 && chunk == s->page_size && (uintptr_t)dest % SSD_ALIGN == 0;
+        bool ok;
+        if (direct) {
+            ok = read_page(s, (uint32_t)lpn, dest, &done);
+        } else {
+            // 부분 page: lpn lock stripe의 bounce buffer로 읽어 복사
+            pthread_mutex_t *lpn_lock = &s->lpn_locks[lpn % SSD_LPN_LOCKS];
+            pthread_mutex_lock(lpn_lock);
+            unsigned char *page = bounce_buffer(s, lpn);
+            ok = page != NULL && read_page(s, (uint32_t)lpn, page, &done);
+            if (ok) {
+                memcpy(dest, page + in_page, chunk);
+            }
+            pthread_mutex_unlock(lpn_lock);
+        }
+        if (!ok) {
+            wait_until(done);
+            return pos > 0 ? (ssize_t)pos : -1;
+        }
+        pos += chunk;
+    }
+    wait_until(done);
+    return (ssize_t)len;
+}
+
+static ssize_t ssd_pwrite(io_backend *be, const void *buf, size_t len, uint64_t offset, bool dsync) {
+    ssd_backend *s = (ssd_backend *)be;
+    if (!range_ok(s, len, offset)) {
+        return -1;
+    }
+    uint64_t done = 0;
+    size_t pos = 0;
+    while (pos < len) {
+        uint64_t lpn = (offset + pos) / s->page_size;
+        size_t in_page = (offset + pos) % s->page_size;
+        size_t chunk = s->page_size - in_page < len - pos ? s->page_size - in_page : len - pos;
+        const unsigned char *src = (const unsigned char *)buf + pos;
+
+        // 같은 page의 다른 부분을 쓰는 thread가 병합 결과를 덮어쓰지 않도록 program까지 lock 유지
+        pthread_mutex_t *lpn_lock = &s->lpn_locks[lpn % SSD_LPN_LOCKS];
+        pthread_mutex_lock(lpn_lock);
+        unsigned char *page = (unsigned char *)src;
+        if (in_page != 0 || chunk != s->page_size || (uintptr_t)src % SSD_ALIGN != 0) {
+            // 부분 page: 기존 page를 읽어 병합 (read-modify-write)
+            page = bounce_buffer(s, lpn);
+            if (page == NULL ||
+                (chunk != s->page_size && !read_page(s, (uint32_t)lpn, page, &done))) {
+                pthread_mutex_unlock(lpn_lock);
+                wait_until(done);
+                return pos > 0 ? (ssize_t)pos : -1;
+            }
+            memcpy(page + in_page, src, chunk);
+        }
+        bool ok = program_page(s, (uint32_t)lpn, page, dsync, &done);
+        pthread_mutex_unlock(lpn_lock);
+        if (!ok) {
+            int saved = errno;
+            wait_until(done);
+            errno = saved;
+            return pos > 0 ? (ssize_t)pos : -1;
+        }
+        pos += chunk;
+    }
+    wait_until(done);
+    return (ssize_t)len;
+}
+
+static void ssd_advise(io_backend *be, io_pattern pattern) {
+    io_backend_advise(((ssd_backend *)be)->inner, pattern);
+}
+
+// 가상 NAND의 내용은 inner에 바로 기록되므로 inner만 flush
+static int ssd_flush(io_backend *be) {
+    return io_backend_flush(((ssd_backend *)be)->inner);
+}
+
+static void ssd_destroy(io_backend *be) {
+    ssd_backend *s = (ssd_backend *)be;
+    for (uint64_t b = 0; b < s->geo.bank && s->banks != NULL; b++) {
+        pthread_mutex_destroy(&s->banks[b].lock);
+        free(s->banks[b].free_blocks);
+        free(s->banks[b].gc_buf);
+    }
+    for (int i = 0; i < SSD_LPN_LOCKS; i++) {
+        pthread_mutex_destroy(&s->lpn_locks[i]);
+        free(s->bounce[i]);
+    }
+    free(s->banks);
+    free((void *)s->l2p);
+    free(s->p2l);
+    free(s->valid);
+    free(s->erase_count);
+    free(s->state);
+    io_backend_destroy(s->inner);
+    free(s);
+}
+
+// 저장된 mapping으로부터 p2l, valid 수, block 상태 복원
+static bool load_state(ssd_backend *s, const char *path) {
+    FILE *fp = fopen(path, "rb");
+    if (fp == NULL) {
+        return errno == ENOENT;
+    }
+    ssd_state_header header;
+    bool ok = fread(&header, sizeof(header), 1, fp) == 1 &&
+              memcmp(header.magic, SSD_STATE_MAGIC, sizeof(header.magic)) == 0 &&
+              header.bank == s->geo.bank && header.block == s->geo.block &&
+              header.page == s->geo.page && header.page_size == s->geo.page_size &&
+              header.logical_pages == s->logical_pages &&
+              fread((uint32_t *)s->l2p, sizeof(uint32_t), s->logical_pages, fp) == s->logical_pages &&
+              fread(s->erase_count, sizeof(uint32_t), s->total_blocks, fp) == s->total_blocks;
+    fclose(fp);
+    if (!ok) {
+        errno = EBADMSG;
+        return false;
+    }
+
+    for (uint64_t lpn = 0; lpn < s->logical_pages; lpn++) {
+        uint32_t ppn = atomic_load_explicit(&s->l2p[lpn], memory_order_relaxed);
+        if (ppn == SSD_INVALID) {
+            continue;
+        }
+        if (ppn >= s->total_pages || s->p2l[ppn] != SSD_INVALID) {
+            errno = EBADMSG;
+            return false;
+        }
+        s->p2l[ppn] = (uint32_t)lpn;
+        s->valid[block_of(s, ppn)]++;
+    }
+    // valid page가 있는 block은 닫힌 block, 빈 block만 free
+    for (uint64_t b = 0; b < s->geo.bank; b++) {
+        s->banks[b].free_count = 0;
+    }
+    for (uint64_t blk = s->total_blocks; blk-- > 0;) {
+        ssd_bank *bank = &s->banks[blk / s->blocks_per_bank];
+        if (s->valid[blk] > 0) {
+            s->state[blk] = BLOCK_FULL;
+        } else {
+            s->state[blk] = BLOCK_FREE;
+            bank->free_blocks[bank->free_count++] = (uint32_t)blk;
+        }
+    }
+    return true;
+}
+
+io_backend *io_backend_ssd(io_backend *inner, uint64_t inner_size, const nand_geometry *geo,
+                           const ssd_latency *latency, const char *state_path) {
+    uint64_t total_pages = nand_geometry_pages(geo);
+    uint64_t capacity = nand_geometry_capacity(geo);
+    if (capacity == 0 || capacity > inner_size || geo->page_size % SSD_ALIGN != 0 ||
+        total_pages >= SSD_INVALID || geo->block <= SSD_GC_RESERVE + 1) {
+        errno = EINVAL;
+        return NULL;
+    }
+
+    ssd_backend *s = calloc(1, sizeof(ssd_backend));
+    if (s == NULL) {
+        return NULL;
+    }
+    for (int i = 0; i < SSD_LPN_LOCKS; i++) {
+        pthread_mutex_init(&s->lpn_locks[i], NULL);
+    }
+    s->inner = inner;
+    s->geo = *geo;
+    s->read_ns = latency->read_us * 1000;
+    s->program_ns = latency->program_us * 1000;
+    s->erase_ns = latency->erase_us * 1000;
+    s->timed = s->read_ns || s->program_ns || s->erase_ns;
+    s->page_size = geo->page_size;
+    s->pages_per_block = geo->page;
+    s->blocks_per_bank = geo->block;
+    s->total_blocks = geo->bank * geo->block;
+    s->total_pages = total_pages;
+
+    // PROVISION_RATE 만큼 노출, bank마다 GC 예비 + active block은 항상 비워둠
+    uint64_t logical = nand_geometry_logical_pages(geo);
+    uint64_t slack = geo->bank * (SSD_GC_RESERVE + 1) * geo->page;
+    s->logical_pages = logical + slack > total_pages ? total_pages - slack : logical;
+
+    s->l2p = malloc(s->logical_pages * sizeof(uint32_t));
+    s->p2l = malloc(total_pages * sizeof(uint32_t));
+    s->valid = calloc(s->total_blocks, sizeof(uint32_t));
+    s->erase_count = calloc(s->total_blocks, sizeof(uint32_t));
+    s->state = calloc(s->total_blocks, sizeof(uint8_t));
+    s->banks = calloc(geo->bank, sizeof(ssd_bank));
+    if (s->l2p == NULL || s->p2l == NULL || s->valid == NULL || s->erase_count == NULL ||
+        s->state == NULL || s->banks == NULL) {
+        s->inner = NULL;
+        ssd_destroy(&s->base);
+        errno = ENOMEM;
+        return NULL;
+    }
+    memset((void *)s->l2p, 0xFF, s->logical_pages * sizeof(uint32_t));
+    memset(s->p2l, 0xFF, total_pages * sizeof(uint32_t));
+
+    for (uint64_t b = 0; b < geo->bank; b++) {
+        ssd_bank *bank = &s->banks[b];
+        pthread_mutex_init(&bank->lock, NULL);
+        bank->active = SSD_INVALID;
+        bank->free_blocks = malloc(geo->block * sizeof(uint32_t));
+        if (posix_memalign((void **)&bank->gc_buf, SSD_ALIGN, geo->page_size) != 0) {
+            bank->gc_buf = NULL;
+        }
+        if (bank->free_blocks == NULL || bank->gc_buf == NULL) {
+            s->inner = NULL;
+            ssd_destroy(&s->base);
+            errno = ENOMEM;
+            return NULL;
+        }
+        // 낮은 번호 block부터 사용
+        for (uint64_t i = 0; i < geo->block; i++) {
+            bank->free_blocks[bank->free_count++] = (uint32_t)((b + 1) * geo->block - 1 - i);
+        }
+    }
+
+    if (state_path != NULL && !load_state(s, state_path)) {
+        int saved = errno;
+        s->inner = NULL;
+        ssd_destroy(&s->base);
+        errno = saved;
+        return NULL;
+    }
+
+    s->base.name = "ssd";
+    s->base.pread = ssd_pread;
+    s->base.pwrite = ssd_pwrite;
+    s->base.advise = ssd_advise;
+    s->base.flush = ssd_flush;
+    s->base.destroy = ssd_destroy;
+    return &s->base;
+}
+
+uint64_t io_backend_ssd_logical_size(const io_backend *be) {
+    const ssd_backend *s = (const ssd_backend *)be;
+    return s->logical_pages * s->page_size;
+}
+
+void io_backend_ssd_stats(const io_backend *be, ssd_stats *out) {
+    ssd_backend *s = (ssd_backend *)be;
+    memset(out, 0, sizeof(*out));
+    out->min_erase = UINT64_MAX;
+    for (uint64_t b = 0; b < s->geo.bank; b++) {
+        ssd_bank *bank = &s->banks[b];
+        pthread_mutex_lock(&bank->lock);
+        out->host_reads += bank->host_reads;
+        out->host_programs += bank->host_programs;
+        out->gc_copies += bank->gc_copies;
+        out->erases += bank->erases;
+        out->gc_runs += bank->gc_runs;
+        out->stalled_ops += bank->stalled_ops;
+        out->stall_ns += bank->stall_ns;
+        out->free_blocks += bank->free_count;
+        for (uint64_t blk = b * s->blocks_per_bank; blk < (b + 1) * s->blocks_per_bank; blk++) {
+            if (s->erase_count[blk] < out->min_erase) {
+                out->min_erase = s->erase_count[blk];
+            }
+            if (s->erase_count[blk] > out->max_erase) {
+                out->max_erase = s->erase_count[blk];
+            }
+        }
+        pthread_mutex_unlock(&bank->lock);
+    }
+}
+
+bool io_backend_ssd_save(const io_backend *be, const char *path) {
+    const ssd_backend *s = (const ssd_backend *)be;
+    FILE *fp = fopen(path, "wb");
+    if (fp == NULL) {
+        return false;
+    }
+    ssd_state_header header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SSD_STATE_MAGIC, sizeof(header.magic));
+    header.bank = s->geo.bank;
+    header.block = s->geo.block;
+    header.page = s->geo.page;
+    header.page_size = s->geo.page_size;
+    header.logical_pages = s->logical_pages;
+
+    bool ok = fwrite(&header, sizeof(header), 1, fp) == 1 &&
+              fwrite((const uint32_t *)s->l2p, sizeof(uint32_t), s->logical_pages, fp) == s->logical_pages &&
+              fwrite(s->erase_count, sizeof(uint32_t), s->total_blocks, fp) == s->total_blocks;
+    int saved = ok ? 0 : (errno ? errno : EIO);
+    if (fclose(fp) != 0) {
+        return false;
+    }
+    errno = saved;
+    return ok;
+}
@@ -0,0 +1,53 @@
+#ifndef SSD_BACKEND_H
+#define SSD_BACKEND_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "io_backend.h"
+#include "nand_geometry.h"
+
+// NAND SSD emulator backend (--ssd META.INI)
+// inner backend(target 파일)를 raw NAND page 배열로 사용하고 그 위에 page-mapped FTL을 둔다.
+// - logical page는 lpn % bank 번째 bank에 고정 (연속 page가 모든 bank에 striping)
+// - bank마다 lock 하나: bank 안의 program/read/erase는 직렬, bank 사이는 병렬
+// - latency는 bank별 가상 timeline으로 계산하고 I/O 완료 시각까지 sleep
+// - bank의 free block이 SSD_GC_RESERVE 이하가 되면 valid page가 가장 적은 block을 GC (greedy)
+// 노출되는 LBA 공간은 PROVISION_RATE 만큼, 나머지 page는 OP 영역
+
+#define SSD_GC_RESERVE 2          // bank당 GC용으로 남겨두는 free block 수
+
+typedef struct {
+    uint64_t read_us;
+    uint64_t program_us;
+    uint64_t erase_us;
+} ssd_latency;
+
+typedef struct {
+    uint64_t host_reads;          // page 단위
+    uint64_t host_programs;
+    uint64_t gc_copies;           // GC가 옮긴 valid page
+    uint64_t erases;
+    uint64_t gc_runs;
+    uint64_t stalled_ops;         // GC가 점유한 bank에서 기다린 host page 연산
+    uint64_t stall_ns;
+    uint64_t free_blocks;
+    uint64_t min_erase;
+    uint64_t max_erase;
+} ssd_stats;
+
+// inner는 ssd backend가 소유, state_path가 있고 파일이 있으면 mapping 복원
+// 실패 시 NULL + errno (출력하지 않음)
+//   EINVAL: inner_size가 geometry 전체 용량보다 작거나 page_size가 4096 배수가 아님 등
+//   EBADMSG: state 파일이 손상되었거나 다른 geometry로 저장됨
+io_backend *io_backend_ssd(io_backend *inner, uint64_t inner_size, const nand_geometry *geo,
+                           const ssd_latency *latency, const char *state_path);
+
+// host에 노출되는 byte 수 (PROVISION_RATE 적용)
+uint64_t io_backend_ssd_logical_size(const io_backend *be);
+void io_backend_ssd_stats(const io_backend *be, ssd_stats *out);
+
+// mapping 저장 (worker 종료 후 호출), 실패 시 false + errno
+bool io_backend_ssd_save(const io_backend *be, const char *path);
+
+#endif
@@ -0,0 +1,215 @@
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+#include "fioverify.h"
+
+// libfioverify 검증 확인 (make test)
+
+#define DEVICE_BYTES (4 * 1024 * 1024)
+
+static int failures = 0;
+
+static void check(bool cond, const char *what) {
+    printf("  %-52s %s\n", what, cond ? "ok" : "FAILED");
+    if (!cond) {
+        failures++;
+    }
+}
+
+static fv_target *open_target(const char *path, uint32_t block_size, double dedupe_ratio) {
+    fv_config cfg = {
+        .path = path,
+        .mode = PAYLOAD_SEED,
+        .seed = 0x5EED,
+        .generation = 1,
+        .dedupe_ratio = dedupe_ratio,
+        .block_size = block_size,
+    };
+    return fv_open(&cfg);
+}
+
+// block_size로 전체를 쓴 target을 다른 block_size로 읽어 검증
+static int64_t write_then_read(const char *path, uint32_t write_bs, uint32_t read_bs, double dedupe_ratio) {
+    fv_target *t = open_target(path, write_bs, dedupe_ratio);
+    if (t == NULL) {
+        return -1;
+    }
+    uint64_t sectors = fv_size(t) / FV_SECTOR_SIZE;
+    int64_t errors = fv_scan(t, true, 0, sectors, 1, NULL);
+    fv_close(t);
+    if (errors != 0) {
+        return -1;
+    }
+    t = open_target(path, read_bs, dedupe_ratio);
+    if (t == NULL) {
+        return -1;
+    }
+    errors = fv_scan(t, false, 0, sectors, 1, NULL);
+    fv_close(t);
+    return errors;
+}
+
+// 한 프로세스에서 동시에 연 두 target: seed/generation과 error callback이 서로 섞이지 않아야 함
+typedef struct {
+    fv_target *target;
+    bool write;
+    uint64_t generation;
+    int64_t errors;
+    atomic_uint_fast64_t reported;
+} scan_job;
+
+static void count_error(const fv_error *err, void *user) {
+    (void)err;
+    atomic_fetch_add(&((scan_job *)user)->reported, 1);
+}
+
+static void *scan_thread(void *arg) {
+    scan_job *job = arg;
+    job->errors = fv_scan(job->target, job->write, 0, fv_size(job->target) / FV_SECTOR_SIZE, job->generation, NULL);
+    return NULL;
+}
+
+static bool scan_both(scan_job *a, scan_job *b, bool write) {
+    pthread_t ta, tb;
+    a->write = b->write = write;
+    if (pthread_create(&ta, NULL, scan_thread, a) != 0) {
+        return false;
+    }
+    if (pthread_create(&tb, NULL, scan_thread, b) != 0) {
+        pthread_join(ta, NULL);
+        return false;
+    }
+    pthread_join(ta, NULL);
+    pthread_join(tb, NULL);
+    return true;
+}
+
+static fv_target *open_generation_target(const char *path, uint64_t seed, uint64_t generation, scan_job *job) {
+    fv_config cfg = {
+        .path = path,
+        .mode = PAYLOAD_SEED,
+        .seed = seed,
+        .generation = generation,
+        .block_size = 64 * 1024,
+        .on_error = count_error,
+        .check_generation = true,
+        .user = job,
+    };
+    return fv_open(&cfg);
+}
+
+// target에서 섹터 하나를 읽어 다른 target 기준으로 검사
+static bool inspect_with(fv_target *from, fv_target *as, uint64_t lba, fv_sector_info *info) {
+    unsigned char *sector = NULL;
+    if (posix_memalign((void **)&sector, FV_ALIGNMENT, FV_ALIGNMENT) != 0) {
+        return false;
+    }
+    io_backend *backend = fv_backend(from);
+    bool ok = backend->pread(backend, sector, FV_ALIGNMENT, (off_t)(lba * FV_SECTOR_SIZE)) == FV_ALIGNMENT;
+    if (ok) {
+        fv_inspect_sector(as, sector, info);
+    }
+    free(sector);
+    return ok;
+}
+
+static void two_targets(const char *path_a, const char *path_b) {
+    scan_job a = { .generation = 1 }, b = { .generation = 7 };
+    a.target = open_generation_target(path_a, 0x5EED, a.generation, &a);
+    b.target = open_generation_target(path_b, 0xB0B, b.generation, &b);
+    check(a.target != NULL && b.target != NULL, "two targets open at once");
+    if (a.target == NULL || b.target == NULL) {
+        fv_close(a.target);
+        fv_close(b.target);
+        return;
+    }
+
+    check(scan_both(&a, &b, true) && a.errors == 0 && b.errors == 0, "concurrent fv_scan writes both targets");
+    check(scan_both(&a, &b, false) && a.errors == 0 && b.errors == 0, "concurrent fv_scan verifies both targets");
+
+    fv_sector_info info;
+    check(inspect_with(a.target, a.target, 8, &info) && info.intact && info.generation_known &&
+          info.generation == 1 && info.header_lba == 8, "inspect: A sector is generation 1 under A");
+    check(inspect_with(b.target, b.target, 8, &info) && info.intact && info.generation == 7,
+          "inspect: B sector is generation 7 under B");
+    check(inspect_with(a.target, b.target, 8, &info) && info.has_header && !info.intact,
+          "inspect: A sector is not intact under B's seed");
+
+    // B에만 손상을 주면 B의 callback만 호출
+    unsigned char *sector = NULL;
+    bool corrupted = posix_memalign((void **)&sector, FV_ALIGNMENT, FV_ALIGNMENT) == 0;
+    if (corrupted) {
+        io_backend *backend = fv_backend(b.target);
+        corrupted = backend->pread(backend, sector, FV_ALIGNMENT, 0) == FV_ALIGNMENT;
+        sector[FV_SECTOR_SIZE - 1] ^= 0xFF;
+        corrupted = corrupted && backend->pwrite(backend, sector, FV_ALIGNMENT, 0, false) == FV_ALIGNMENT;
+    }
+    free(sector);
+    atomic_store(&a.reported, 0);
+    atomic_store(&b.reported, 0);
+    check(corrupted && scan_both(&a, &b, false) && a.errors == 0 && b.errors == 1 &&
+          atomic_load(&a.reported) == 0 && atomic_load(&b.reported) == 1,
+          "corruption in B is reported only through B");
+
+    fv_close(a.target);
+    fv_close(b.target);
+}
+
+static bool make_device(char *path) {
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        return false;
+    }
+    bool ok = ftruncate(fd, DEVICE_BYTES) == 0;
+    close(fd);
+    return ok;
+}
+
+int main(void) {
+    char path[] = "/tmp/test_fioverify_XXXXXX";
+    char other[] = "/tmp/test_fioverify_XXXXXX";
+    if (!make_device(path) || !make_device(other)) {
+        perror("mkstemp");
+        return 1;
+    }
+
+    printf("=== fioverify Test ===\n");
+    fv_target *t = open_target(path, 0, 0.5);
+    check(t != NULL, "target opens");
+    if (t == NULL) {
+        unlink(path);
+        unlink(other);
+        return 1;
+    }
+    // dedupe는 4K unit 단위: unit 안의 섹터는 같은 slot, unit 일부가 dedupe 대상
+    uint64_t units = 0, deduped = 0;
+    bool unit_consistent = true;
+    for (uint64_t lba = 0; lba < DEVICE_BYTES / FV_SECTOR_SIZE; lba += FV_DEDUPE_UNIT_SECTORS) {
+        int slot = fv_dedupe_slot(t, lba);
+        for (uint64_t i = 1; i < FV_DEDUPE_UNIT_SECTORS; i++) {
+            unit_consistent = unit_consistent && fv_dedupe_slot(t, lba + i) == slot;
+        }
+        units++;
+        deduped += slot >= 0;
+    }
+    fv_close(t);
+    check(unit_consistent, "sectors of a 4K unit share one dedupe slot");
+    check(deduped > units / 4 && deduped < units * 3 / 4, "about half of the 4K units are deduped");
+
+    check(write_then_read(path, 4096, 128 * 1024, 0.5) == 0, "dedupe: 4K writes verify with 128K reads");
+    check(write_then_read(path, 128 * 1024, 12288, 0.5) == 0, "dedupe: 128K writes verify with 12K reads");
+    check(write_then_read(path, 12288, 4096, 0.0) == 0, "no dedupe: 12K writes verify with 4K reads");
+
+    two_targets(path, other);
+
+    unlink(path);
+    unlink(other);
+    printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures != 0;
+}
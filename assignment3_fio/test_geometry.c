@@ -0,0 +1,178 @@
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "nand_geometry.h"
+#include "ssd_backend.h"
+
+// --geometry block 크기 계산과 SSD emulator의 bank 고정 배치 확인 (make test)
+
+static int failures = 0;
+
+static void check(bool cond, const char *what) {
+    printf("  %-52s %s\n", what, cond ? "ok" : "FAILED");
+    if (!cond) {
+        failures++;
+    }
+}
+
+static bool write_meta(const char *path, const char *text) {
+    FILE *fp = fopen(path, "w");
+    if (fp == NULL) {
+        return false;
+    }
+    fputs(text, fp);
+    return fclose(fp) == 0;
+}
+
+// bank 4 x block 8 x page 4 x 4KB, 75% 노출: bank당 32 page, logical page 96개
+static const nand_geometry SMALL = { 4, 8, 4, 4096, 75 };
+
+static io_backend *open_ssd(const char *path) {
+    uint64_t size = nand_geometry_capacity(&SMALL);
+    io_backend *inner = io_backend_buffered(path, size);
+    if (inner == NULL) {
+        return NULL;
+    }
+    ssd_latency latency = { 0, 0, 0 };
+    io_backend *ssd = io_backend_ssd(inner, size, &SMALL, &latency, NULL);
+    if (ssd == NULL) {
+        io_backend_destroy(inner);
+    }
+    return ssd;
+}
+
+// lpn_stride 간격으로 count개 page를 rounds번 덮어쓰고 GC 횟수 반환, 실패 시 UINT64_MAX
+static uint64_t overwrite_gc_runs(const char *path, uint64_t lpn_stride, uint64_t count, int rounds) {
+    io_backend *ssd = open_ssd(path);
+    if (ssd == NULL) {
+        return UINT64_MAX;
+    }
+    unsigned char *page = NULL;
+    if (posix_memalign((void **)&page, 4096, SMALL.page_size) != 0) {
+        io_backend_destroy(ssd);
+        return UINT64_MAX;
+    }
+    memset(page, 0xA5, SMALL.page_size);
+    uint64_t result = 0;
+    for (int r = 0; r < rounds && result != UINT64_MAX; r++) {
+        for (uint64_t i = 0; i < count; i++) {
+            off_t offset = (off_t)(i * lpn_stride * SMALL.page_size);
+            if (ssd->pwrite(ssd, page, SMALL.page_size, offset, false) != (ssize_t)SMALL.page_size) {
+                result = UINT64_MAX;
+                break;
+            }
+        }
+    }
+    if (result == 0) {
+        ssd_stats stats;
+        io_backend_ssd_stats(ssd, &stats);
+        result = stats.gc_runs;
+    }
+    free(page);
+    io_backend_destroy(ssd);
+    return result;
+}
+
+static bool stripe_round_trip(const char *path, uint64_t stripes) {
+    io_backend *ssd = open_ssd(path);
+    if (ssd == NULL) {
+        return false;
+    }
+    size_t length = nand_geometry_stripe(&SMALL) * stripes;
+    unsigned char *out = NULL, *in = NULL;
+    bool ok = posix_memalign((void **)&out, 4096, length) == 0 && posix_memalign((void **)&in, 4096, length) == 0;
+    if (ok) {
+        for (size_t i = 0; i < length; i++) {
+            out[i] = (unsigned char)(i * 31 + 7);
+        }
+        // page 경계가 아닌 offset: 양 끝 page는 read-modify-write
+        off_t offset = (off_t)(SMALL.page_size + 512);
+        ok = ssd->pwrite(ssd, out, length, offset, false) == (ssize_t)length &&
+             ssd->pread(ssd, in, length, offset) == (ssize_t)length && memcmp(out, in, length) == 0;
+    }
+    free(out);
+    free(in);
+    io_backend_destroy(ssd);
+    return ok;
+}
+
+int main(void) {
+    char meta[] = "/tmp/test_geometry_XXXXXX";
+    int fd = mkstemp(meta);
+    if (fd < 0) {
+        perror("mkstemp");
+        return 1;
+    }
+    close(fd);
+    char image[] = "/tmp/test_geometry_img_XXXXXX";
+    fd = mkstemp(image);
+    if (fd < 0 || ftruncate(fd, (off_t)nand_geometry_capacity(&SMALL)) != 0) {
+        perror("mkstemp");
+        unlink(meta);
+        return 1;
+    }
+    close(fd);
+
+    printf("=== NAND Geometry Test ===\n");
+    nand_geometry geo;
+    check(write_meta(meta, "# comment\nbank=4\nblock=1024\npage=256\npage_size=16384\nPROVISION_RATE=93\n") &&
+          nand_geometry_load(meta, &geo) == NAND_GEOMETRY_OK && geo.bank == 4 && geo.page_size == 16384 &&
+          geo.provision_rate == 93,
+          "meta.ini loads");
+    check(nand_geometry_pages(&geo) == 4ULL * 1024 * 256 && nand_geometry_capacity(&geo) == 16ULL << 30,
+          "pages and capacity");
+    check(write_meta(meta, "  BANK = 4\nBlock=1024\npage =256\nPage_Size= 4096 \nprovision_rate=80\n") &&
+          nand_geometry_load(meta, &geo) == NAND_GEOMETRY_OK && geo.bank == 4 && geo.page_size == 4096 &&
+          geo.provision_rate == 80,
+          "keys match meta_control: spaces and case ignored");
+    check(write_meta(meta, "bank=4\nblock=1024\npage=256x\npage_size=4096\nPROVISION_RATE=80\n") &&
+          nand_geometry_load(meta, &geo) == NAND_GEOMETRY_MISSING, "trailing junk after a value is rejected");
+    check(write_meta(meta, "bank=4\nblock=1024\npage=256\npage_size=4096\n") &&
+          nand_geometry_load(meta, &geo) == NAND_GEOMETRY_MISSING,
+          "missing PROVISION_RATE is rejected");
+    check(write_meta(meta, "bank=4\nblock=1024\npage=256\npage_size=4096\nPROVISION_RATE=0\n") &&
+          nand_geometry_load(meta, &geo) == NAND_GEOMETRY_RANGE, "PROVISION_RATE=0 is rejected");
+    check(write_meta(meta, "bank=4294967296\nblock=4294967296\npage=2\npage_size=4096\nPROVISION_RATE=90\n") &&
+          nand_geometry_load(meta, &geo) == NAND_GEOMETRY_OVERFLOW, "overflowing capacity is rejected");
+
+    // OP를 내림하는 assignment2 규칙: 96 page x 7% OP = 6.72 -> OP 6, 노출 90 (노출을 내림하면 89)
+    nand_geometry op = { 4, 8, 3, 4096, 93 };
+    check(nand_geometry_logical_pages(&op) == 90 && nand_geometry_logical_pages(&SMALL) == 96,
+          "logical pages round like l2p_logical_pages");
+
+    // 기본 block 크기(128K)에 가장 가까운 stripe 배수
+    nand_geometry g = SMALL;
+    check(nand_geometry_stripe(&g) == 16384 && nand_geometry_default_stripes(&g, 131072) == 8,
+          "4 x 4K stripe -> 8 stripes per 128K block");
+    g.bank = 3;
+    g.page_size = 16384;
+    check(nand_geometry_default_stripes(&g, 131072) == 3, "3 x 16K stripe rounds 128K to 3 stripes");
+    g.bank = 16;
+    check(nand_geometry_default_stripes(&g, 131072) == 1, "stripe above 128K still gives 1 stripe");
+    g.bank = UINT64_MAX;
+    check(nand_geometry_stripe(&g) == 0, "overflowing stripe is 0");
+
+    // bank-test의 "bank N" 순서 (stride bank, offset N)는 전부 bank N에 배치
+    bool same_bank = true;
+    for (uint64_t k = 0; k < 64; k++) {
+        same_bank = same_bank && nand_geometry_bank_of(&SMALL, 2 + k * SMALL.bank) == 2 &&
+                    nand_geometry_bank_of(&SMALL, k) == k % SMALL.bank;
+    }
+    check(same_bank, "bank-test page orders map to the intended bank");
+
+    // bank 0 page 20개 x 2회는 bank 0 (32 page, 예비 2 block)만 GC, 연속 page 20개는 4 bank에 나뉘어 GC 없음
+    uint64_t gc_runs = overwrite_gc_runs(image, SMALL.bank, 20, 2);
+    check(gc_runs > 0 && gc_runs != UINT64_MAX, "single-bank overwrite fills that bank and runs GC");
+    check(overwrite_gc_runs(image, 1, 20, 2) == 0, "consecutive overwrite spreads over banks without GC");
+
+    check(stripe_round_trip(image, 2), "unaligned 2-stripe block round-trips through --ssd");
+
+    unlink(meta);
+    unlink(image);
+    printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures != 0;
+}
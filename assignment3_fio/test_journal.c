@@ -0,0 +1,116 @@
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "write_journal.h"
+
+// journal 끝의 잘린 record를 정리한 뒤 이어쓰는지, close 전에도 기록이 파일에 남는지 확인 (make test)
+
+#define DEVICE_SECTORS (1 << 20)
+
+static int failures = 0;
+
+static void check(bool cond, const char *what) {
+    printf("  %-52s %s\n", what, cond ? "ok" : "FAILED");
+    if (!cond) {
+        failures++;
+    }
+}
+
+static bool write_session(const char *path, uint64_t first_lba, int count, uint64_t *generation) {
+    write_journal *journal = write_journal_open(path, DEVICE_SECTORS);
+    if (journal == NULL) {
+        return false;
+    }
+    *generation = journal->generation;
+    // 떨어진 extent라 record 하나씩 기록됨
+    for (int i = 0; i < count; i++) {
+        write_journal_append(journal, 0, first_lba + (uint64_t)i * 16, 8);
+    }
+    return write_journal_close(journal, NULL, NULL);
+}
+
+// close 하지 않은 journal을 읽었을 때 (crash 직후) 보이는 record 수, 실패 시 UINT64_MAX
+static uint64_t records_on_disk(const char *path) {
+    journal_dirty dirty;
+    if (!write_journal_load_dirty(path, DEVICE_SECTORS, 0, 1, &dirty)) {
+        return UINT64_MAX;
+    }
+    write_journal_free_dirty(&dirty);
+    return dirty.total_records;
+}
+
+static void unclosed_session(const char *path) {
+    unlink(path);
+    write_journal *journal = write_journal_open(path, DEVICE_SECTORS);
+    check(journal != NULL, "journal opens");
+    if (journal == NULL) {
+        return;
+    }
+
+    // 떨어진 write SYNC_RECORDS + 1개: 마지막 하나만 pending, 나머지는 fsync 됨
+    for (uint64_t i = 0; i <= WRITE_JOURNAL_SYNC_RECORDS; i++) {
+        write_journal_append(journal, 0, i * 16, 8);
+    }
+    check(records_on_disk(path) == WRITE_JOURNAL_SYNC_RECORDS, "record count bound syncs without close");
+
+    // 이어지는 write는 EXTENT_MAX마다 record가 되고, SYNC_MS가 지난 뒤의 record에서 fsync
+    uint64_t base = 32768;
+    for (uint64_t lba = 0; lba < 2 * WRITE_JOURNAL_EXTENT_MAX; lba += 8) {
+        write_journal_append(journal, 1, base + lba, 8);
+    }
+    usleep((WRITE_JOURNAL_SYNC_MS + 100) * 1000);
+    write_journal_append(journal, 1, base + 2 * WRITE_JOURNAL_EXTENT_MAX, 8);
+    check(records_on_disk(path) == WRITE_JOURNAL_SYNC_RECORDS + 2, "sequential extents sync after the interval");
+
+    uint64_t records = 0;
+    check(write_journal_close(journal, &records, NULL) && records == WRITE_JOURNAL_SYNC_RECORDS + 4 &&
+          records_on_disk(path) == records, "close writes the pending extents");
+}
+
+int main(void) {
+    char path[] = "/tmp/test_journal_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        perror("mkstemp");
+        return 1;
+    }
+    close(fd);
+    unlink(path);
+
+    printf("=== Write Journal Test ===\n");
+    uint64_t generation = 0;
+    check(write_session(path, 0, 4, &generation) && generation == 1, "first session writes 4 records (generation 1)");
+
+    // 마지막 record 중간에서 자름 (기록 도중 crash)
+    off_t torn = (off_t)(sizeof(write_journal_header) + 3 * sizeof(journal_record) + sizeof(journal_record) / 2);
+    check(truncate(path, torn) == 0, "truncate inside the 4th record");
+
+    check(write_session(path, 1024, 2, &generation) && generation == 2, "second session appends 2 records (generation 2)");
+
+    journal_dirty dirty;
+    bool loaded = write_journal_load_dirty(path, DEVICE_SECTORS, 0, 1, &dirty);
+    check(loaded, "journal loads");
+    check(loaded && dirty.total_records == 5, "3 surviving + 2 appended records");
+    check(loaded && dirty.max_generation == 2, "max generation is 2");
+    check(loaded && dirty.count == 5 && dirty.extents[3].start_lba == 1024 && dirty.extents[4].start_lba == 1040,
+          "appended records start at a record boundary");
+    if (loaded) {
+        write_journal_free_dirty(&dirty);
+    }
+
+    loaded = write_journal_load_dirty(path, DEVICE_SECTORS, 2, 1, &dirty);
+    check(loaded && dirty.records == 2 && dirty.extents[0].sectors == 8, "--verify-since 2 sees only the new records");
+    if (loaded) {
+        write_journal_free_dirty(&dirty);
+    }
+
+    unclosed_session(path);
+
+    unlink(path);
+    printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures != 0;
+}
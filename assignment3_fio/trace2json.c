@@ -0,0 +1,112 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "io_trace.h"
+
+// fio_simulator --trace 로 기록한 binary trace를 Chrome/Perfetto JSON으로 변환
+// pid 1: thread별 timeline, pid 2: LBA 영역별 timeline (영역 간 stall 정렬 확인용)
+
+#define DEFAULT_REGION_SECTORS (1024ULL * 1024 * 1024 / 512)  // 1GB
+
+static const char *op_name(uint8_t op) {
+    switch (op) {
+        case IO_OP_WRITE: return "WRITE";
+        case IO_OP_READ:  return "READ";
+        default:          return "IO";
+    }
+}
+
+static void print_usage(const char *prog_name) {
+    printf("Usage:\n");
+    printf("  %s TRACE_FILE OUTPUT_JSON [--region-sectors N]\n", prog_name);
+    printf("\nOptions:\n");
+    printf("  --region-sectors N            : LBA region size for the region timeline (default %llu)\n",
+           DEFAULT_REGION_SECTORS);
+}
+
+static void write_event(FILE *out, bool *first, const io_trace_event *ev, const io_trace_file_header *hdr,
+                        int pid, uint64_t tid) {
+    double ticks_per_us = (double)hdr->tsc_hz / 1e6;
+    double ts = ((double)ev->submit_tsc - (double)hdr->start_tsc) / ticks_per_us;
+    double dur = (double)(ev->complete_tsc - ev->submit_tsc) / ticks_per_us;
+
+    fprintf(out, "%s\n{\"name\":\"%s%s\",\"cat\":\"io\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,"
+                 "\"pid\":%d,\"tid\":%lu,\"args\":{\"lba\":%lu,\"bytes\":%u,\"thread\":%u,"
+                 "\"latency_us\":%.3f,\"outlier\":%s,\"failed\":%s}}",
+            *first ? "" : ",", op_name(ev->op), (ev->flags & IO_TRACE_FLAG_OUTLIER) ? " (outlier)" : "",
+            ts, dur, pid, tid, ev->lba, ev->length, ev->thread, dur,
+            (ev->flags & IO_TRACE_FLAG_OUTLIER) ? "true" : "false",
+            (ev->flags & IO_TRACE_FLAG_FAILED) ? "true" : "false");
+    *first = false;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc != 3 && argc != 5) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    uint64_t region_sectors = DEFAULT_REGION_SECTORS;
+    if (argc == 5) {
+        if (strcmp(argv[3], "--region-sectors") != 0 || (region_sectors = strtoull(argv[4], NULL, 0)) == 0) {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    FILE *in = fopen(argv[1], "rb");
+    if (in == NULL) {
+        perror("fopen input");
+        return 1;
+    }
+
+    io_trace_file_header hdr;
+    if (fread(&hdr, sizeof(hdr), 1, in) != 1 || memcmp(hdr.magic, IO_TRACE_MAGIC, sizeof(hdr.magic)) != 0 ||
+        hdr.version != IO_TRACE_VERSION || hdr.event_size != sizeof(io_trace_event) || hdr.tsc_hz == 0) {
+        printf("Error: '%s' is not a compatible trace file\n", argv[1]);
+        fclose(in);
+        return 1;
+    }
+
+    FILE *out = fopen(argv[2], "w");
+    if (out == NULL) {
+        perror("fopen output");
+        fclose(in);
+        return 1;
+    }
+
+    fprintf(out, "{\"displayTimeUnit\":\"ms\",\"otherData\":{\"threshold_ns\":%lu,\"window\":%u,"
+                 "\"start_realtime_ns\":%lu},\"traceEvents\":[",
+            hdr.threshold_ns, hdr.window, hdr.start_realtime_ns);
+
+    // timeline 이름
+    bool first = true;
+    fprintf(out, "\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"Threads\"}},");
+    fprintf(out, "\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":2,\"args\":{\"name\":\"LBA regions (%lu sectors)\"}}",
+            region_sectors);
+    first = false;
+
+    io_trace_event ev;
+    uint64_t count = 0;
+    uint64_t outliers = 0;
+    while (fread(&ev, sizeof(ev), 1, in) == 1) {
+        write_event(out, &first, &ev, &hdr, 1, ev.thread);
+        write_event(out, &first, &ev, &hdr, 2, ev.lba / region_sectors);
+        count++;
+        if (ev.flags & IO_TRACE_FLAG_OUTLIER) {
+            outliers++;
+        }
+    }
+
+    fprintf(out, "\n]}\n");
+    fclose(out);
+    fclose(in);
+
+    printf("Converted %lu events (%lu outliers) to %s\n", count, outliers, argv[2]);
+    return 0;
+}
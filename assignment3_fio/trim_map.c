@@ -0,0 +1,131 @@
+#include "trim_map.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+typedef struct {
+    char magic[8];
+    uint64_t total_sectors;
+    uint64_t unit_sectors;
+    uint64_t units;
+} trim_map_file_header;
+
+bool trim_map_init(trim_map *map, uint64_t total_sectors) {
+    map->total_sectors = total_sectors;
+    map->units = total_sectors / TRIM_MAP_UNIT_SECTORS;
+    map->bits = calloc((map->units + 63) / 64 + 1, sizeof(uint64_t));
+    return map->bits != NULL;
+}
+
+void trim_map_free(trim_map *map) {
+    free(map->bits);
+    map->bits = NULL;
+}
+
+// unit 범위 [first, last)의 bit를 word 단위로 설정/해제
+static void update_units(trim_map *map, uint64_t first, uint64_t last, bool set) {
+    if (last > map->units) {
+        last = map->units;
+    }
+    while (first < last) {
+        uint64_t w = first / 64;
+        uint64_t end = (w + 1) * 64 < last ? (w + 1) * 64 : last;
+        uint64_t width = end - first;
+        uint64_t mask = (width == 64 ? ~0ULL : ((1ULL << width) - 1)) << (first % 64);
+        uint64_t cur = atomic_load_explicit(&map->bits[w], memory_order_relaxed);
+        // write 경로에서 호출되므로 변경이 없으면 RMW 생략
+        if (set && (cur & mask) != mask) {
+            atomic_fetch_or_explicit(&map->bits[w], mask, memory_order_relaxed);
+        } else if (!set && (cur & mask) != 0) {
+            atomic_fetch_and_explicit(&map->bits[w], ~mask, memory_order_relaxed);
+        }
+        first = end;
+    }
+}
+
+void trim_map_mark(trim_map *map, uint64_t start_lba, uint64_t sectors) {
+    uint64_t first = (start_lba + TRIM_MAP_UNIT_SECTORS - 1) / TRIM_MAP_UNIT_SECTORS;
+    uint64_t last = (start_lba + sectors) / TRIM_MAP_UNIT_SECTORS;
+    update_units(map, first, last, true);
+}
+
+void trim_map_unmark(trim_map *map, uint64_t start_lba, uint64_t sectors) {
+    uint64_t first = start_lba / TRIM_MAP_UNIT_SECTORS;
+    uint64_t last = (start_lba + sectors + TRIM_MAP_UNIT_SECTORS - 1) / TRIM_MAP_UNIT_SECTORS;
+    update_units(map, first, last, false);
+}
+
+void trim_map_clear(trim_map *map) {
+    for (uint64_t w = 0; w < (map->units + 63) / 64; w++) {
+        atomic_store_explicit(&map->bits[w], 0, memory_order_relaxed);
+    }
+}
+
+bool trim_map_test(const trim_map *map, uint64_t lba) {
+    uint64_t u = lba / TRIM_MAP_UNIT_SECTORS;
+    if (map->bits == NULL || u >= map->units) {
+        return false;
+    }
+    uint64_t word = atomic_load_explicit((_Atomic uint64_t *)&map->bits[u / 64], memory_order_relaxed);
+    return (word >> (u % 64)) & 1;
+}
+
+uint64_t trim_map_count(const trim_map *map) {
+    uint64_t count = 0;
+    for (uint64_t w = 0; w < (map->units + 63) / 64; w++) {
+        count += (uint64_t)__builtin_popcountll(atomic_load_explicit((_Atomic uint64_t *)&map->bits[w], memory_order_relaxed));
+    }
+    return count;
+}
+
+bool trim_map_load(trim_map *map, const char *path, uint64_t total_sectors) {
+    if (!trim_map_init(map, total_sectors)) {
+        return false;
+    }
+    FILE *fp = fopen(path, "rb");
+    if (fp == NULL) {
+        // 아직 discard 기록이 없음
+        return errno == ENOENT;
+    }
+
+    trim_map_file_header header;
+    size_t words = (map->units + 63) / 64;
+    bool ok = fread(&header, sizeof(header), 1, fp) == 1 &&
+              memcmp(header.magic, TRIM_MAP_MAGIC, sizeof(header.magic)) == 0 &&
+              header.total_sectors == total_sectors &&
+              header.unit_sectors == TRIM_MAP_UNIT_SECTORS &&
+              header.units == map->units &&
+              fread((uint64_t *)map->bits, sizeof(uint64_t), words, fp) == words;
+    fclose(fp);
+    if (!ok) {
+        printf("Error: Trim map '%s' is invalid or was recorded for a different device size\n", path);
+        trim_map_free(map);
+    }
+    return ok;
+}
+
+bool trim_map_save(const trim_map *map, const char *path) {
+    FILE *fp = fopen(path, "wb");
+    if (fp == NULL) {
+        perror("Failed to open trim map");
+        return false;
+    }
+    trim_map_file_header header;
+    memcpy(header.magic, TRIM_MAP_MAGIC, sizeof(header.magic));
+    header.total_sectors = map->total_sectors;
+    header.unit_sectors = TRIM_MAP_UNIT_SECTORS;
+    header.units = map->units;
+
+    size_t words = (map->units + 63) / 64;
+    bool ok = fwrite(&header, sizeof(header), 1, fp) == 1 &&
+              fwrite((const uint64_t *)map->bits, sizeof(uint64_t), words, fp) == words;
+    if (fclose(fp) != 0) {
+        ok = false;
+    }
+    if (!ok) {
+        perror("Failed to write trim map");
+    }
+    return ok;
+}
@@ -0,0 +1,36 @@
+#ifndef TRIM_MAP_H
+#define TRIM_MAP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+// discard된 영역 기록 (--trim-map FILE)
+// 4KB 단위 bitmap, read 검증 시 magic 없는 섹터가 "trim됨"인지 "write된 적 없음"인지 구분
+// 파일 형식: "FIOTRIM1" magic + header + bitmap (다음 --write 전까지 유효)
+
+#define TRIM_MAP_MAGIC "FIOTRIM1"
+#define TRIM_MAP_UNIT_SECTORS 8
+
+typedef struct {
+    uint64_t total_sectors;
+    uint64_t units;
+    _Atomic uint64_t *bits;
+} trim_map;
+
+bool trim_map_init(trim_map *map, uint64_t total_sectors);
+void trim_map_free(trim_map *map);
+
+// 완전히 덮인 unit만 표시 (여러 thread에서 동시 호출 가능)
+void trim_map_mark(trim_map *map, uint64_t start_lba, uint64_t sectors);
+// 걸치는 unit 모두 해제 (다시 write된 영역)
+void trim_map_unmark(trim_map *map, uint64_t start_lba, uint64_t sectors);
+void trim_map_clear(trim_map *map);
+bool trim_map_test(const trim_map *map, uint64_t lba);
+uint64_t trim_map_count(const trim_map *map);
+
+// 파일이 없으면 빈 map으로 초기화, device 크기가 다르면 실패
+bool trim_map_load(trim_map *map, const char *path, uint64_t total_sectors);
+bool trim_map_save(const trim_map *map, const char *path);
+
+#endif
@@ -0,0 +1,36 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "tsc.h"
+
+#include <time.h>
+#include <stdatomic.h>
+
+static _Atomic uint64_t cached_hz = 0;
+
+static uint64_t monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+uint64_t tsc_hz(void) {
+    uint64_t hz = atomic_load_explicit(&cached_hz, memory_order_relaxed);
+    if (hz != 0) {
+        return hz;
+    }
+
+    // 20ms 동안의 TSC 증가량으로 주파수 계산
+    struct timespec sleep_time = { .tv_sec = 0, .tv_nsec = 20000000L };
+    uint64_t ns0 = monotonic_ns();
+    uint64_t t0 = tsc_now();
+    nanosleep(&sleep_time, NULL);
+    uint64_t ns1 = monotonic_ns();
+    uint64_t t1 = tsc_now();
+
+    hz = (uint64_t)((double)(t1 - t0) * 1e9 / (double)(ns1 - ns0));
+    if (hz == 0) {
+        hz = 1;
+    }
+    atomic_store_explicit(&cached_hz, hz, memory_order_relaxed);
+    return hz;
+}
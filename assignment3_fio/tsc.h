@@ -0,0 +1,24 @@
+#ifndef TSC_H
+#define TSC_H
+
+#include <stdint.h>
+#include <x86intrin.h>
+
+// invariant TSC 기반 저비용 timestamp (I/O latency, trace, phase timer 용)
+
+static inline uint64_t tsc_now(void) {
+    return __rdtsc();
+}
+
+// CLOCK_MONOTONIC 대비 TSC 주파수 측정 (ticks/sec), 최초 1회만 측정
+uint64_t tsc_hz(void);
+
+static inline uint64_t tsc_to_ns(uint64_t ticks) {
+    return (uint64_t)((double)ticks * 1e9 / (double)tsc_hz());
+}
+
+static inline uint64_t tsc_from_ns(uint64_t ns) {
+    return (uint64_t)((double)ns * (double)tsc_hz() / 1e9);
+}
+
+#endif
@@ -0,0 +1,265 @@
+#define _GNU_SOURCE
+
+#include "write_journal.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+
+#define JOURNAL_READ_CHUNK 4096
+
+static uint64_t monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// header 확인, 실패 시 메시지 출력
+static bool read_header(FILE *fp, const char *path, uint64_t device_sectors) {
+    write_journal_header header;
+    if (fread(&header, sizeof(header), 1, fp) != 1 ||
+        memcmp(header.magic, WRITE_JOURNAL_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != WRITE_JOURNAL_VERSION || header.sector_size != 512) {
+        printf("Error: Journal '%s' is invalid\n", path);
+        return false;
+    }
+    if (header.device_sectors != device_sectors) {
+        printf("Error: Journal '%s' was recorded for a different device size (%lu sectors)\n",
+               path, header.device_sectors);
+        return false;
+    }
+    return true;
+}
+
+write_journal *write_journal_open(const char *path, uint64_t device_sectors) {
+    uint64_t max_generation = 0;
+    uint64_t whole_records = 0;
+
+    FILE *fp = fopen(path, "r+b");
+    bool exists = fp != NULL;
+    if (exists) {
+        // 기존 journal의 최대 generation과 온전한 record 수 (끝이 잘린 record는 무시)
+        bool ok = read_header(fp, path, device_sectors);
+        journal_record chunk[JOURNAL_READ_CHUNK];
+        size_t n;
+        while (ok && (n = fread(chunk, sizeof(journal_record), JOURNAL_READ_CHUNK, fp)) > 0) {
+            whole_records += n;
+            for (size_t i = 0; i < n; i++) {
+                if (chunk[i].generation > max_generation) {
+                    max_generation = chunk[i].generation;
+                }
+            }
+        }
+        // 잘린 record를 잘라내고 마지막 온전한 record 뒤부터 이어씀 (record 경계 유지)
+        off_t end = (off_t)(sizeof(write_journal_header) + whole_records * sizeof(journal_record));
+        if (ok && (fflush(fp) != 0 || ftruncate(fileno(fp), end) != 0 || fseeko(fp, end, SEEK_SET) != 0)) {
+            perror("Failed to repair journal");
+            ok = false;
+        }
+        if (!ok) {
+            fclose(fp);
+            return NULL;
+        }
+    } else if (errno != ENOENT) {
+        perror("Failed to open journal");
+        return NULL;
+    } else {
+        fp = fopen(path, "wb");
+        if (fp == NULL) {
+            perror("Failed to open journal");
+            return NULL;
+        }
+    }
+
+    write_journal *journal = calloc(1, sizeof(write_journal));
+    if (journal == NULL) {
+        fclose(fp);
+        return NULL;
+    }
+    journal->fp = fp;
+    if (!exists) {
+        write_journal_header header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, WRITE_JOURNAL_MAGIC, sizeof(header.magic));
+        header.version = WRITE_JOURNAL_VERSION;
+        header.sector_size = 512;
+        header.device_sectors = device_sectors;
+        if (fwrite(&header, sizeof(header), 1, journal->fp) != 1) {
+            perror("Failed to write journal");
+            fclose(journal->fp);
+            free(journal);
+            return NULL;
+        }
+    }
+
+    journal->generation = max_generation + 1;
+    journal->last_sync_ns = monotonic_ns();
+    pthread_mutex_init(&journal->lock, NULL);
+    return journal;
+}
+
+// lock을 잡은 상태에서 buffer를 파일로 내보내고 fsync
+static void sync_buffer(write_journal *journal) {
+    if (journal->buffered > 0 &&
+        fwrite(journal->buffer, sizeof(journal_record), journal->buffered, journal->fp) != journal->buffered) {
+        journal->failed = true;
+    }
+    if (fflush(journal->fp) != 0 || fsync(fileno(journal->fp)) != 0) {
+        journal->failed = true;
+    }
+    journal->buffered = 0;
+    journal->last_sync_ns = monotonic_ns();
+}
+
+static void push_record(write_journal *journal, uint64_t start_lba, uint64_t sectors) {
+    pthread_mutex_lock(&journal->lock);
+    journal_record *rec = &journal->buffer[journal->buffered++];
+    rec->start_lba = start_lba;
+    rec->sectors = (uint32_t)sectors;
+    rec->reserved = 0;
+    rec->generation = journal->generation;
+    journal->records++;
+    journal->sectors += sectors;
+    if (journal->buffered == WRITE_JOURNAL_SYNC_RECORDS ||
+        monotonic_ns() - journal->last_sync_ns >= WRITE_JOURNAL_SYNC_MS * 1000000ULL) {
+        sync_buffer(journal);
+    }
+    pthread_mutex_unlock(&journal->lock);
+}
+
+void write_journal_append(write_journal *journal, int worker, uint64_t start_lba, uint64_t sectors) {
+    if (worker < 0 || worker >= WRITE_JOURNAL_MAX_WORKERS) {
+        push_record(journal, start_lba, sectors);
+        return;
+    }
+
+    // 자기 slot만 쓰므로 lock 없이 이어지는 write는 extent를 늘리기만 함 (EXTENT_MAX까지)
+    journal_pending *p = &journal->pending[worker];
+    if (p->sectors > 0 && start_lba == p->start_lba + p->sectors && p->sectors + sectors <= WRITE_JOURNAL_EXTENT_MAX) {
+        p->sectors += sectors;
+        return;
+    }
+    if (p->sectors > 0) {
+        push_record(journal, p->start_lba, p->sectors);
+    }
+    p->start_lba = start_lba;
+    p->sectors = sectors;
+}
+
+bool write_journal_close(write_journal *journal, uint64_t *records, uint64_t *sectors) {
+    // worker가 모두 끝난 뒤 호출되므로 pending slot 접근에 경합 없음
+    for (int w = 0; w < WRITE_JOURNAL_MAX_WORKERS; w++) {
+        if (journal->pending[w].sectors > 0) {
+            push_record(journal, journal->pending[w].start_lba, journal->pending[w].sectors);
+        }
+    }
+    sync_buffer(journal);
+
+    bool ok = !journal->failed;
+    if (fclose(journal->fp) != 0) {
+        ok = false;
+    }
+    if (!ok) {
+        perror("Failed to write journal");
+    }
+    if (records != NULL) {
+        *records = journal->records;
+    }
+    if (sectors != NULL) {
+        *sectors = journal->sectors;
+    }
+    pthread_mutex_destroy(&journal->lock);
+    free(journal);
+    return ok;
+}
+
+static int compare_extents(const void *a, const void *b) {
+    const journal_extent *ea = a, *eb = b;
+    return (ea->start_lba > eb->start_lba) - (ea->start_lba < eb->start_lba);
+}
+
+bool write_journal_load_dirty(const char *path, uint64_t device_sectors, uint64_t since,
+                              uint64_t granularity, journal_dirty *out) {
+    memset(out, 0, sizeof(*out));
+    FILE *fp = fopen(path, "rb");
+    if (fp == NULL) {
+        perror("Failed to open journal");
+        return false;
+    }
+    if (!read_header(fp, path, device_sectors)) {
+        fclose(fp);
+        return false;
+    }
+
+    uint64_t capacity = 0;
+    journal_record chunk[JOURNAL_READ_CHUNK];
+    size_t n;
+    bool ok = true;
+    while (ok && (n = fread(chunk, sizeof(journal_record), JOURNAL_READ_CHUNK, fp)) > 0) {
+        for (size_t i = 0; i < n; i++) {
+            const journal_record *rec = &chunk[i];
+            out->total_records++;
+            if (rec->generation > out->max_generation) {
+                out->max_generation = rec->generation;
+            }
+            if (rec->generation < since || rec->sectors == 0 || rec->start_lba >= device_sectors) {
+                continue;
+            }
+
+            // 읽기 단위 경계로 확장
+            uint64_t start = rec->start_lba / granularity * granularity;
+            uint64_t end = (rec->start_lba + rec->sectors + granularity - 1) / granularity * granularity;
+            if (end > device_sectors) {
+                end = device_sectors;
+            }
+            if (out->count == capacity) {
+                capacity = capacity ? capacity * 2 : 1024;
+                journal_extent *grown = realloc(out->extents, capacity * sizeof(journal_extent));
+                if (grown == NULL) {
+                    ok = false;
+                    break;
+                }
+                out->extents = grown;
+            }
+            out->extents[out->count].start_lba = start;
+            out->extents[out->count].sectors = end - start;
+            out->count++;
+            out->records++;
+        }
+    }
+    fclose(fp);
+    if (!ok) {
+        printf("Error: Out of memory while loading journal '%s'\n", path);
+        write_journal_free_dirty(out);
+        return false;
+    }
+
+    // 정렬 후 겹치거나 맞닿은 extent 병합
+    qsort(out->extents, out->count, sizeof(journal_extent), compare_extents);
+    uint64_t merged = 0;
+    for (uint64_t i = 0; i < out->count; i++) {
+        journal_extent *cur = &out->extents[i];
+        if (merged > 0) {
+            journal_extent *last = &out->extents[merged - 1];
+            uint64_t last_end = last->start_lba + last->sectors;
+            if (cur->start_lba <= last_end) {
+                uint64_t cur_end = cur->start_lba + cur->sectors;
+                if (cur_end > last_end) {
+                    last->sectors = cur_end - last->start_lba;
+                }
+                continue;
+            }
+        }
+        out->extents[merged++] = *cur;
+    }
+    out->count = merged;
+    return true;
+}
+
+void write_journal_free_dirty(journal_dirty *dirty) {
+    free(dirty->extents);
+    dirty->extents = NULL;
+    dirty->count = 0;
+}
@@ -0,0 +1,87 @@
+#ifndef WRITE_JOURNAL_H
+#define WRITE_JOURNAL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <pthread.h>
+
+// write 경로가 남기는 extent 기록 (--journal FILE)
+// 실행(session)마다 generation이 1씩 증가하고, --verify-since GEN은
+// generation >= GEN 인 extent만 병합해서 다시 읽는다.
+// 파일 형식: write_journal_header + journal_record 배열 (append only)
+// record는 data write가 끝난 뒤 남기므로 crash 시 잃을 수 있는 기록은
+// worker별 pending extent (EXTENT_MAX 이하)와 마지막 fsync 이후의 record (SYNC_RECORDS개 또는 SYNC_MS 이내) 뿐
+
+#define WRITE_JOURNAL_MAGIC        "FIOJRNL1"
+#define WRITE_JOURNAL_VERSION      1
+#define WRITE_JOURNAL_MAX_WORKERS  256
+#define WRITE_JOURNAL_SYNC_RECORDS 1024    // 이만큼 모이면 파일에 쓰고 fsync
+#define WRITE_JOURNAL_SYNC_MS      1000    // 마지막 fsync 후 이 시간이 지난 뒤 record가 오면 fsync
+#define WRITE_JOURNAL_EXTENT_MAX   2048    // pending extent 최대 섹터 수 (1MB)
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t sector_size;
+    uint64_t device_sectors;
+} write_journal_header;
+
+typedef struct {
+    uint64_t start_lba;
+    uint32_t sectors;
+    uint32_t reserved;
+    uint64_t generation;
+} journal_record;
+
+// worker별로 이어지는 write를 한 extent로 모음 (cache line 단위로 분리)
+typedef struct {
+    uint64_t start_lba;
+    uint64_t sectors;
+} __attribute__((aligned(64))) journal_pending;
+
+typedef struct {
+    FILE *fp;
+    uint64_t generation;           // 이번 실행의 generation
+    uint64_t records;              // 이번 실행에서 기록한 record 수
+    uint64_t sectors;              // 이번 실행에서 기록한 섹터 수 (중복 포함)
+    bool failed;
+    pthread_mutex_t lock;
+    journal_record buffer[WRITE_JOURNAL_SYNC_RECORDS];
+    uint32_t buffered;
+    uint64_t last_sync_ns;         // 마지막 fsync 시각 (CLOCK_MONOTONIC)
+    journal_pending pending[WRITE_JOURNAL_MAX_WORKERS];
+} write_journal;
+
+// 병합된 dirty 영역
+typedef struct {
+    uint64_t start_lba;
+    uint64_t sectors;
+} journal_extent;
+
+typedef struct {
+    journal_extent *extents;       // start_lba 순, 겹치거나 맞닿은 extent는 병합됨
+    uint64_t count;
+    uint64_t records;              // 조건에 맞는 record 수
+    uint64_t total_records;
+    uint64_t max_generation;       // 0 = record 없음
+} journal_dirty;
+
+// 없으면 생성, 있으면 header 확인 후 이어쓰기 (generation = 기존 최대 + 1)
+// 성공 시 heap에 할당된 journal, 실패 시 NULL
+write_journal *write_journal_open(const char *path, uint64_t device_sectors);
+
+// 여러 thread에서 동시 호출 가능, worker는 [0, WRITE_JOURNAL_MAX_WORKERS)
+// 범위 밖 worker의 write는 이어붙이지 않고 바로 record로 남김
+void write_journal_append(write_journal *journal, int worker, uint64_t start_lba, uint64_t sectors);
+
+// 남은 extent를 기록하고 fsync 후 해제, 실패가 있었으면 false
+// records/sectors (NULL 가능)에 이번 실행의 기록 수와 섹터 수를 돌려줌
+bool write_journal_close(write_journal *journal, uint64_t *records, uint64_t *sectors);
+
+// generation >= since 인 record를 모아 병합, 각 extent는 granularity 섹터 경계로 확장
+bool write_journal_load_dirty(const char *path, uint64_t device_sectors, uint64_t since,
+                              uint64_t granularity, journal_dirty *out);
+void write_journal_free_dirty(journal_dirty *dirty);
+
+#endif